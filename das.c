@@ -10,6 +10,8 @@
 #include <errno.h>
 #include <string.h>
 #include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
 #elif _WIN32
 #include <Dbghelp.h>
 #endif
@@ -58,6 +60,170 @@ void* das_ptr_round_down_align(void* ptr, uintptr_t align) {
 	return (void*)((uintptr_t)ptr & ~(align - 1));
 }
 
+// ======================================================================
+//
+//
+// Atomics & Threading Utilities
+//
+//
+// ======================================================================
+
+static uintptr_t _das_threads_count;
+// stores the thread index + 1 so 0 means it has not been assigned yet.
+static das_thread_local uint32_t _das_thread_idx_plus_one;
+
+uint32_t das_thread_idx(void) {
+	if (!_das_thread_idx_plus_one) {
+		_das_thread_idx_plus_one = das_atomic_fetch_add_u(&_das_threads_count, 1) + 1;
+	}
+	return _das_thread_idx_plus_one - 1;
+}
+
+//
+// a single background worker thread that runs jobs for the allocators, so the slow work does not
+// happen on the allocating thread. the thread is started the first time a job is posted and then
+// waits for jobs until the process exits.
+//
+
+typedef void (*_DasWorkerJobFn)(void* data, uintptr_t arg);
+
+typedef struct {
+	_DasWorkerJobFn fn;
+	void* data;
+	uintptr_t arg;
+} _DasWorkerJob;
+
+static _DasWorkerJob _das_worker_jobs[das_worker_jobs_cap];
+static uint32_t _das_worker_jobs_head_idx;
+static uint32_t _das_worker_jobs_count;
+static DasBool _das_worker_is_running;
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+static pthread_mutex_t _das_worker_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _das_worker_cond = PTHREAD_COND_INITIALIZER;
+#elif _WIN32
+static SRWLOCK _das_worker_mutex = SRWLOCK_INIT;
+static CONDITION_VARIABLE _das_worker_cond = CONDITION_VARIABLE_INIT;
+#endif
+
+static void _das_worker_run(void) {
+	while (1) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+		pthread_mutex_lock(&_das_worker_mutex);
+		while (_das_worker_jobs_count == 0) {
+			pthread_cond_wait(&_das_worker_cond, &_das_worker_mutex);
+		}
+#elif _WIN32
+		AcquireSRWLockExclusive(&_das_worker_mutex);
+		while (_das_worker_jobs_count == 0) {
+			SleepConditionVariableSRW(&_das_worker_cond, &_das_worker_mutex, INFINITE, 0);
+		}
+#endif
+
+		_DasWorkerJob job = _das_worker_jobs[_das_worker_jobs_head_idx];
+		_das_worker_jobs_head_idx = (_das_worker_jobs_head_idx + 1) % das_worker_jobs_cap;
+		_das_worker_jobs_count -= 1;
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+		pthread_mutex_unlock(&_das_worker_mutex);
+#elif _WIN32
+		ReleaseSRWLockExclusive(&_das_worker_mutex);
+#endif
+
+		job.fn(job.data, job.arg);
+	}
+}
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+static void* _das_worker_thread_main(void* arg) {
+	_das_worker_run();
+	return NULL;
+}
+#elif _WIN32
+static DWORD WINAPI _das_worker_thread_main(LPVOID arg) {
+	_das_worker_run();
+	return 0;
+}
+#endif
+
+//
+// queues up a job for the background worker thread, and starts the thread if it is not running yet.
+// returns das_false if the job queue is full or the thread could not be started,
+// then the caller should do the work itself.
+static DasBool _das_worker_post(_DasWorkerJobFn fn, void* data, uintptr_t arg) {
+	DasBool success = das_false;
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	pthread_mutex_lock(&_das_worker_mutex);
+	if (!_das_worker_is_running) {
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, _das_worker_thread_main, NULL) == 0) {
+			pthread_detach(thread);
+			_das_worker_is_running = das_true;
+		}
+	}
+#elif _WIN32
+	AcquireSRWLockExclusive(&_das_worker_mutex);
+	if (!_das_worker_is_running) {
+		HANDLE thread = CreateThread(NULL, 0, _das_worker_thread_main, NULL, 0, NULL);
+		if (thread) {
+			CloseHandle(thread);
+			_das_worker_is_running = das_true;
+		}
+	}
+#endif
+
+	if (_das_worker_is_running && _das_worker_jobs_count < das_worker_jobs_cap) {
+		uint32_t idx = (_das_worker_jobs_head_idx + _das_worker_jobs_count) % das_worker_jobs_cap;
+		_das_worker_jobs[idx] = (_DasWorkerJob){ .fn = fn, .data = data, .arg = arg };
+		_das_worker_jobs_count += 1;
+		success = das_true;
+	}
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	pthread_mutex_unlock(&_das_worker_mutex);
+	if (success) pthread_cond_signal(&_das_worker_cond);
+#elif _WIN32
+	ReleaseSRWLockExclusive(&_das_worker_mutex);
+	if (success) WakeConditionVariable(&_das_worker_cond);
+#endif
+	return success;
+}
+
+//
+// removes the job that has @param(fn) and @param(data) from the queue, if the background worker thread has not started it yet.
+// returns das_true if the job was removed, then it will never run.
+// this lets a thread that needs the result now do the work itself, instead of waiting behind the other jobs in the queue.
+static DasBool _das_worker_cancel(_DasWorkerJobFn fn, void* data) {
+	DasBool is_removed = das_false;
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	pthread_mutex_lock(&_das_worker_mutex);
+#elif _WIN32
+	AcquireSRWLockExclusive(&_das_worker_mutex);
+#endif
+
+	for (uint32_t i = 0; i < _das_worker_jobs_count; i += 1) {
+		_DasWorkerJob* job = &_das_worker_jobs[(_das_worker_jobs_head_idx + i) % das_worker_jobs_cap];
+		if (job->fn != fn || job->data != data)
+			continue;
+
+		//
+		// move the jobs after it down by one, so they stay in order.
+		for (uint32_t j = i; j + 1 < _das_worker_jobs_count; j += 1) {
+			_das_worker_jobs[(_das_worker_jobs_head_idx + j) % das_worker_jobs_cap] =
+				_das_worker_jobs[(_das_worker_jobs_head_idx + j + 1) % das_worker_jobs_cap];
+		}
+		_das_worker_jobs_count -= 1;
+		is_removed = das_true;
+		break;
+	}
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	pthread_mutex_unlock(&_das_worker_mutex);
+#elif _WIN32
+	ReleaseSRWLockExclusive(&_das_worker_mutex);
+#endif
+	return is_removed;
+}
+
 // ======================================================================
 //
 //
@@ -98,7 +264,111 @@ void* das_system_alloc_fn(void* alloc_data, void* ptr, uintptr_t old_size, uintp
 //
 // but there are alignments that are larger (for example is intel AVX256 primitives).
 // these require calls aligned_alloc.
+//
+// on Linux, large allocations get their own mapping so they can grow with mremap.
+// this moves the pages to a new address instead of copying every byte,
+// and works for any alignment by moving the pages into an aligned reservation.
+
+#ifdef __linux__
+#include <sys/syscall.h>
+
+// these are not defined when compiling without _GNU_SOURCE.
+#ifndef MREMAP_MAYMOVE
+#define MREMAP_MAYMOVE 1
+#endif
+#ifndef MREMAP_FIXED
+#define MREMAP_FIXED 2
+#endif
+
+static inline void* _das_system_mremap(void* ptr, uintptr_t old_size, uintptr_t size, int flags, void* new_addr) {
+	return (void*)syscall(SYS_mremap, ptr, old_size, size, flags, new_addr);
+}
+
+//
+// maps new pages that are aligned to @param(align).
+// to align to more than a page, we map an extra @param(align) and then give back the unaligned start and the left over end.
+static void* _das_system_mmap(uintptr_t size, uintptr_t align, int prot) {
+	uintptr_t page_size = sysconf(_SC_PAGESIZE);
+	size = das_round_up_nearest_multiple_u(size, page_size);
+	uintptr_t align_pad = align > page_size ? align : 0;
+
+	void* addr = mmap(NULL, size + align_pad, prot, MAP_ANON | MAP_PRIVATE, -1, 0);
+	if (addr == MAP_FAILED)
+		return NULL;
+
+	if (align_pad) {
+		void* aligned_addr = das_ptr_round_up_align(addr, align);
+		uintptr_t head_size = das_ptr_diff(aligned_addr, addr);
+		uintptr_t tail_size = align_pad - head_size;
+		if (head_size) munmap(addr, head_size);
+		if (tail_size) munmap(das_ptr_add(aligned_addr, size), tail_size);
+		addr = aligned_addr;
+	}
+
+	return addr;
+}
+
+//
+// handles the allocations where either the old size or the new size is over das_system_mmap_threshold.
+static void* _das_system_mmap_alloc_fn(void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasBool is_mapped = old_size > das_system_mmap_threshold;
+	DasBool needs_mapping = size > das_system_mmap_threshold;
+	if (!ptr) {
+		// allocate
+		return _das_system_mmap(size, align, PROT_READ | PROT_WRITE);
+	} else if (size > 0) {
+		// reallocate
+		if (is_mapped && needs_mapping) {
+			//
+			// the kernel will give us a page aligned address when it moves the pages.
+			if (align <= (uintptr_t)sysconf(_SC_PAGESIZE)) {
+				void* new_ptr = _das_system_mremap(ptr, old_size, size, MREMAP_MAYMOVE, NULL);
+				return new_ptr == MAP_FAILED ? NULL : new_ptr;
+			}
+
+			//
+			// for larger alignments, try to resize in place.
+			// if not, reserve an aligned address and move the pages there.
+			void* new_ptr = _das_system_mremap(ptr, old_size, size, 0, NULL);
+			if (new_ptr != MAP_FAILED)
+				return new_ptr;
+
+			void* dst = _das_system_mmap(size, align, PROT_NONE);
+			if (dst == NULL)
+				return NULL;
+
+			new_ptr = _das_system_mremap(ptr, old_size, size, MREMAP_MAYMOVE | MREMAP_FIXED, dst);
+			if (new_ptr == MAP_FAILED) {
+				munmap(dst, size);
+				return NULL;
+			}
+			return new_ptr;
+		}
+
+		//
+		// moving between a mapping and the C standard library allocator, so we have to copy.
+		void* new_ptr = das_system_alloc_fn(NULL, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		das_system_alloc_fn(NULL, ptr, old_size, 0, align);
+		return new_ptr;
+	} else {
+		// deallocate
+		das_debug_assert(is_mapped, "unreachable");
+		munmap(ptr, old_size);
+		return NULL;
+	}
+}
+#endif // __linux__
+
 void* das_system_alloc_fn(void* alloc_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+#ifdef __linux__
+	if (old_size > das_system_mmap_threshold || size > das_system_mmap_threshold) {
+		return _das_system_mmap_alloc_fn(ptr, old_size, size, align);
+	}
+#endif
+
 	if (!ptr && size == 0) {
 		// reset not supported so do nothing
 		return NULL;
@@ -134,1205 +404,5217 @@ void* das_system_alloc_fn(void* alloc_data, void* ptr, uintptr_t old_size, uintp
 
 #endif // _WIN32
 
-// ======================================================================
-//
-//
-// DasStk - linear stack of elements (LIFO)
-//
-//
-// ======================================================================
+DasBool das_system_alloc_ext_fn(void* alloc_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+#ifdef __linux__
+			if (args->old_size > das_system_mmap_threshold || args->size > das_system_mmap_threshold) {
+				//
+				// only resize mappings, the allocation cannot move between a mapping and the C standard library allocator.
+				if (args->old_size <= das_system_mmap_threshold || args->size <= das_system_mmap_threshold)
+					return das_false;
+				return _das_system_mremap(args->ptr, args->old_size, args->size, 0, NULL) != MAP_FAILED;
+			}
+#endif
 
-DasBool _DasStk_init_with_alctor(_DasStkHeader** header_out, uintptr_t header_size, uintptr_t init_cap, DasAlctor alctor, uintptr_t elmt_size) {
-	init_cap = das_max_u(DasStk_min_cap, init_cap);
-	uintptr_t new_size = header_size + init_cap * elmt_size;
-	_DasStkHeader* new_header = das_alloc(alctor, new_size, alignof(das_max_align_t));
-	if (!new_header) return das_false;
+#ifdef __GLIBC__
+			//
+			// malloc rounds allocations up to its size classes, so there may already be enough room.
+			return malloc_usable_size(args->ptr) >= args->size;
+#else
+			return das_false;
+#endif
 
-	//
-	// initialize the header and pass out the new header pointer
-	new_header->count = 0;
-	new_header->cap = init_cap;
-	new_header->alctor = alctor;
-	*header_out = new_header;
-	return das_true;
-}
+		case DasAllocExtOp_usable_size:
+#ifdef __linux__
+			if (args->old_size > das_system_mmap_threshold) {
+				args->size = das_round_up_nearest_multiple_u(args->old_size, sysconf(_SC_PAGESIZE));
+				return das_true;
+			}
+#endif
 
-DasBool _DasStk_init_clone_with_alctor(_DasStkHeader** dst_header_in_out, uintptr_t header_size, _DasStkHeader* src_header, DasAlctor alctor, uintptr_t elmt_size) {
-	uintptr_t src_count = DasStk_count(&src_header);
-	if (!_DasStk_init_with_alctor(dst_header_in_out, header_size, src_count, alctor, elmt_size))
-		return das_false;
+#ifdef __GLIBC__
+			args->size = malloc_usable_size(args->ptr);
+#ifdef __linux__
+			// stay under the threshold, so the allocation is not mistaken for a mapping.
+			args->size = das_min_u(args->size, das_system_mmap_threshold);
+#endif
+			return das_true;
+#else
+			return das_false;
+#endif
 
-	_DasStkHeader* dst_header = *dst_header_in_out;
+		case DasAllocExtOp_alloc_zeroed:
+#ifdef __linux__
+			if (args->size > das_system_mmap_threshold) {
+				// new mappings are zeroed by the OS.
+				args->ptr = das_system_alloc_fn(NULL, NULL, 0, args->size, args->align);
+				return das_true;
+			}
+#endif
 
-	void* dst = das_ptr_add(dst_header, header_size);
-	void* src = das_ptr_add(src_header, header_size);
-	memcpy(dst, src, src_count * elmt_size);
-	dst_header->count = src_count;
-	return das_true;
-}
+#ifdef _WIN32
+			args->ptr = _aligned_recalloc(NULL, 1, args->size, args->align);
+			return das_true;
+#else
+			//
+			// calloc knows when its memory has come straight from the OS and skips zeroing it.
+			if (args->align > alignof(das_max_align_t))
+				return das_false;
+			args->ptr = calloc(1, args->size);
+			return das_true;
+#endif
 
-void _DasStk_deinit(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t elmt_size) {
-	_DasStkHeader* header = *header_in_out;
-	uintptr_t size = header_size + header->cap * elmt_size;
-	das_dealloc(header->alctor, header, size, alignof(das_max_align_t));
-	*header_in_out = NULL;
-}
+		case DasAllocExtOp_realloc_zeroed:
+#ifdef __linux__
+			if (args->size > das_system_mmap_threshold && args->size > args->old_size) {
+				void* ptr = _das_system_mmap_alloc_fn(args->ptr, args->old_size, args->size, args->align);
+				if (ptr && args->old_size > das_system_mmap_threshold) {
+					//
+					// the pages added by mremap are zeroed by the OS, but the end of the last page
+					// may have been used before the allocation was shrunk.
+					uintptr_t page_end = das_round_up_nearest_multiple_u(args->old_size, sysconf(_SC_PAGESIZE));
+					memset(das_ptr_add(ptr, args->old_size), 0, das_min_u(page_end, args->size) - args->old_size);
+				}
+				args->ptr = ptr;
+				return das_true;
+			}
+#endif
+			return das_false;
 
-uintptr_t _DasStk_assert_idx(_DasStkHeader* header, uintptr_t idx, uintptr_t elmt_size) {
-	das_assert(header != NULL && idx < header->count, "idx '%zu' is out of bounds for a stack of count '%zu'", idx, header ? header->count : 0);
-	return idx;
-}
+		case DasAllocExtOp_alloc_batch:
+			for (uintptr_t i = 0; i < args->count; i += 1) {
+				void* ptr = das_system_alloc_fn(NULL, NULL, 0, args->size, args->align);
+				if (!ptr) {
+					for (uintptr_t j = 0; j < i; j += 1) {
+						das_system_alloc_fn(NULL, args->ptrs[j], args->size, 0, args->align);
+					}
+					args->count = 0;
+					break;
+				}
+				args->ptrs[i] = ptr;
+			}
+			return das_true;
 
-DasBool _DasStk_resize(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t new_count, DasBool zero, uintptr_t elmt_size) {
-	_DasStkHeader* header = *header_in_out;
-	if (new_count == 0) {
-		if (header) {
-			_DasStk_deinit(header_in_out, header_size, elmt_size);
-		}
-		return das_true;
+		case DasAllocExtOp_dealloc_batch:
+			for (uintptr_t i = 0; i < args->count; i += 1) {
+				das_system_alloc_fn(NULL, args->ptrs[i], args->old_size, 0, args->align);
+			}
+			return das_true;
 	}
 
-	//
-	// extend the capacity of the stack if the new count extends past the capacity.
-	uintptr_t old_cap = DasStk_cap(header_in_out);
-	if (old_cap < new_count) {
-		DasBool res = _DasStk_resize_cap(header_in_out, header_size, das_max_u(new_count, old_cap * 2), elmt_size);
-		if (!res) return das_false;
-		header = *header_in_out;
+	return das_false;
+}
+
+DasBool das_alloc_batch(DasAlctor alctor, uintptr_t size, uintptr_t align, void** ptrs_out, uintptr_t count) {
+	if (alctor.ext_fn) {
+		DasAllocExtArgs args = { .size = size, .align = align, .ptrs = ptrs_out, .count = count };
+		if (alctor.ext_fn(alctor.data, DasAllocExtOp_alloc_batch, &args))
+			return args.count == count;
 	}
 
 	//
-	// zero the new memory if requested
-	uintptr_t count = header->count;
-	if (zero && new_count > count) {
-		void* data = das_ptr_add(header, header_size);
-		memset(das_ptr_add(data, count * elmt_size), 0, (new_count - count) * elmt_size);
-	}
+	// the allocator does not support batches, so allocate one at a time.
 
-	header->count = new_count;
+	for (uintptr_t i = 0; i < count; i += 1) {
+		void* ptr = alctor.fn(alctor.data, NULL, 0, size, align);
+		if (!ptr) {
+			das_dealloc_batch(alctor, ptrs_out, size, align, i);
+			return das_false;
+		}
+		ptrs_out[i] = ptr;
+	}
 	return das_true;
 }
 
-DasBool _DasStk_resize_cap(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t new_cap, uintptr_t elmt_size) {
-	_DasStkHeader* header = *header_in_out;
-	uintptr_t cap = header ? header->cap : 0;
-	uintptr_t count = header ? header->count : 0;
-	DasAlctor alctor = header && header->alctor.fn != NULL ? header->alctor : DasAlctor_default;
+void das_dealloc_batch(DasAlctor alctor, void** ptrs, uintptr_t old_size, uintptr_t align, uintptr_t count) {
+	if (alctor.ext_fn) {
+		DasAllocExtArgs args = { .old_size = old_size, .align = align, .ptrs = ptrs, .count = count };
+		if (alctor.ext_fn(alctor.data, DasAllocExtOp_dealloc_batch, &args))
+			return;
+	}
 
-	//
-	// return if the capacity has not changed
-	new_cap = das_max_u(das_max_u(DasStk_min_cap, new_cap), count);
-	if (cap == new_cap) return das_true;
+	for (uintptr_t i = 0; i < count; i += 1) {
+		alctor.fn(alctor.data, ptrs[i], old_size, 0, align);
+	}
+}
 
-	//
-	// reallocate the stack while taking into account of size of the header.
-	// the block of memory is aligned to alignof(das_max_align_t).
-	uintptr_t size = header ? header_size + cap * elmt_size : 0;
-	uintptr_t new_size = header_size + new_cap * elmt_size;
-	_DasStkHeader* new_header = das_realloc(alctor, header, size, new_size, alignof(das_max_align_t));
-	if (!new_header) return das_false;
-	if (!header) {
-		new_header->alctor = alctor;
-		new_header->count = 0;
+void* das_alloc_zeroed(DasAlctor alctor, uintptr_t size, uintptr_t align) {
+	if (alctor.ext_fn) {
+		DasAllocExtArgs args = { .size = size, .align = align };
+		if (alctor.ext_fn(alctor.data, DasAllocExtOp_alloc_zeroed, &args))
+			return args.ptr;
 	}
 
-	//
-	// update the capacity in the header and pass out the new header pointer
-	new_header->cap = new_cap;
-	*header_in_out = new_header;
-	return das_true;
+	void* ptr = alctor.fn(alctor.data, NULL, 0, size, align);
+	if (ptr) memset(ptr, 0, size);
+	return ptr;
 }
 
-void* _DasStk_insert_many(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t idx, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
-	_DasStkHeader* header = *header_in_out;
-	das_assert(idx <= header->count, "insert idx '%zu' must be less than or equal to count of '%zu'", idx, header->count);
-	uintptr_t count = header ? header->count : 0;
-	uintptr_t cap = header ? header->cap : 0;
+void* das_realloc_zeroed(DasAlctor alctor, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	if (!ptr) return das_alloc_zeroed(alctor, size, align);
 
-	//
-	// increase the capacity if the number of elements
-	// inserted makes the stack exceed it's capacity.
-    uintptr_t new_count = count + elmts_count;
-    if (cap < new_count) {
-		DasBool res = _DasStk_resize_cap(header_in_out, header_size, das_max_u(new_count, cap * 2), elmt_size);
-		if (!res) return NULL;
-		header = *header_in_out;
-    }
+	if (alctor.ext_fn) {
+		DasAllocExtArgs args = { .ptr = ptr, .old_size = old_size, .size = size, .align = align };
+		if (alctor.ext_fn(alctor.data, DasAllocExtOp_realloc_zeroed, &args))
+			return args.ptr;
+	}
 
-	void* data = das_ptr_add(header, header_size);
-    void* dst = das_ptr_add(data, idx * elmt_size);
-
-	// shift the elements from idx to (idx + elmts_count), to the right
-	// to make room for the elements
-    memmove(das_ptr_add(dst, elmts_count * elmt_size), dst, (header->count - idx) * elmt_size);
+	void* new_ptr = alctor.fn(alctor.data, ptr, old_size, size, align);
+	if (new_ptr && size > old_size) memset(das_ptr_add(new_ptr, old_size), 0, size - old_size);
+	return new_ptr;
+}
 
-	if (elmts) {
-		memcpy(dst, elmts, elmts_count * elmt_size);
-	}
+//
+// passes the extended operation on to @param(alctor), if it supports it.
+static inline DasBool _DasAlctor_ext(DasAlctor alctor, DasAllocExtOp op, DasAllocExtArgs* args) {
+	return alctor.ext_fn && alctor.ext_fn(alctor.data, op, args);
+}
 
-    header->count = new_count;
-	return dst;
+//
+// asks @param(alctor) if it owns @param(ptr) and ORs the answer in to @param(owns_in_out).
+// returns das_false if the allocator does not support DasAllocExtOp_owns.
+// allocators that are made of other allocators use this, as they can only answer when all of them can.
+static inline DasBool _DasAlctor_owns_or(DasAlctor alctor, void* ptr, uintptr_t* owns_in_out) {
+	DasAllocExtArgs args = { .ptr = ptr };
+	if (!_DasAlctor_ext(alctor, DasAllocExtOp_owns, &args)) return das_false;
+	*owns_in_out |= args.count;
+	return das_true;
 }
 
-void* _DasStk_push_many(_DasStkHeader** header_in_out, uintptr_t header_size, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
-	das_debug_assert(elmts_count != 0, "cannot push zero elements on a stack");
-	_DasStkHeader* header = *header_in_out;
-	uintptr_t count = header ? header->count : 0;
-	uintptr_t cap = header ? header->cap : 0;
-	uintptr_t idx = count;
+// ======================================================================
+//
+//
+// Thread Caching Allocator
+//
+//
+// ======================================================================
 
-	//
-	// increase the capacity if the number of elements
-	// pushed on makes the stack exceed it's capacity.
-	uintptr_t new_count = count + elmts_count;
-	if (new_count > cap) {
-		DasBool res = _DasStk_resize_cap(header_in_out, header_size, das_max_u(new_count, cap * 2), elmt_size);
-		if (!res) return NULL;
-		header = *header_in_out;
-	}
+das_static_assert(das_is_power_of_two(das_tcache_max_size), "das_tcache_max_size must be a power of two");
 
-	void* dst = das_ptr_add(header, header_size + idx * elmt_size);
-	if (elmts) {
-		memcpy(dst, elmts, elmts_count * elmt_size);
-	}
+#define _das_tcache_min_size 16
+#define _das_tcache_min_size_shift 4
+// enough size classes to go all the way up to 2GBs
+#define _das_tcache_classes_cap 28
+// the minimum size of the chunks that are carved up into blocks
+#define _das_tcache_chunk_min_size 65536
 
-	header->count = new_count;
-	return dst;
+typedef struct {
+	void* head;
+	uint32_t count;
+} _DasTCacheThreadList;
+
+typedef struct {
+	DasSpinLock lock;
+	void* head;
+	// keep each size class on it's own cache line so threads using different size classes do not fight.
+	char _pad[das_cache_line_size - sizeof(DasSpinLock) - sizeof(void*)];
+} _DasTCacheCentralList;
+
+static das_thread_local _DasTCacheThreadList _das_tcache_thread_lists[_das_tcache_classes_cap];
+static _DasTCacheCentralList _das_tcache_central_lists[_das_tcache_classes_cap];
+
+//
+// a thread registers a thread exit callback on it's first refill, so the blocks in it's cache
+// are given back to the central free lists when the thread exits.
+static das_thread_local DasBool _das_tcache_thread_is_registered;
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+static pthread_once_t _das_tcache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t _das_tcache_key;
+static DasBool _das_tcache_key_is_valid;
+
+static void _das_tcache_thread_exit(void* arg) {
+	das_tcache_thread_flush();
+	// if another thread exit callback uses the cache after this one, the thread registers again
+	// and the destructors are called another round.
+	_das_tcache_thread_is_registered = das_false;
 }
 
-uintptr_t _DasStk_pop_many(_DasStkHeader* header, uintptr_t elmts_count, uintptr_t elmt_size) {
-	elmts_count = das_min_u(elmts_count, header->count);
-	header->count -= elmts_count;
-	return elmts_count;
+static void _das_tcache_key_create(void) {
+	_das_tcache_key_is_valid = pthread_key_create(&_das_tcache_key, _das_tcache_thread_exit) == 0;
+}
+#elif _WIN32
+static INIT_ONCE _das_tcache_fls_once = INIT_ONCE_STATIC_INIT;
+static DWORD _das_tcache_fls_idx = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI _das_tcache_thread_exit(PVOID arg) {
+	// the callback is also called when the index is freed, so only flush for threads that have registered.
+	if (!arg) return;
+	das_tcache_thread_flush();
+	_das_tcache_thread_is_registered = das_false;
 }
 
-void _DasStk_remove_swap_range(_DasStkHeader* header, uintptr_t header_size, uintptr_t start_idx, uintptr_t end_idx, uintptr_t elmt_size) {
-	das_assert(start_idx <= header->count, "start_idx '%zu' must be less than the count of '%zu'", start_idx, header->count);
-	das_assert(end_idx <= header->count, "end_idx '%zu' must be less than or equal to count of '%zu'", end_idx, header->count);
+static BOOL CALLBACK _das_tcache_fls_create(PINIT_ONCE once, PVOID param, PVOID* ctx) {
+	_das_tcache_fls_idx = FlsAlloc(_das_tcache_thread_exit);
+	return TRUE;
+}
+#endif
 
-	//
-	// get the pointer where the elements are being removed
-	uintptr_t remove_count = end_idx - start_idx;
-	void* data = das_ptr_add(header, header_size);
-	void* dst = das_ptr_add(data, start_idx * elmt_size);
+static void _das_tcache_thread_register(void) {
+	_das_tcache_thread_is_registered = das_true;
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	pthread_once(&_das_tcache_key_once, _das_tcache_key_create);
+	// the destructor is only called for threads that have a non NULL value for the key.
+	if (_das_tcache_key_is_valid) pthread_setspecific(_das_tcache_key, (void*)1);
+#elif _WIN32
+	InitOnceExecuteOnce(&_das_tcache_fls_once, _das_tcache_fls_create, NULL, NULL);
+	if (_das_tcache_fls_idx != FLS_OUT_OF_INDEXES) FlsSetValue(_das_tcache_fls_idx, (PVOID)1);
+#endif
+}
 
-	//
-	// work out where the elements at the back of the stack start from.
-	uintptr_t src_idx = header->count;
-	header->count -= remove_count;
-	if (remove_count > header->count) remove_count = header->count;
-	src_idx -= remove_count;
+static inline uintptr_t _das_tcache_class_size(uintptr_t size, uintptr_t align) {
+	size = das_max_u(size, align);
+	if (size <= _das_tcache_min_size) return _das_tcache_min_size;
+	return (uintptr_t)1 << (das_most_set_bit_idx(size - 1) + 1);
+}
 
-	//
-	// replace the removed elements with the elements from the back of the stack.
-	void* src = das_ptr_add(data, src_idx * elmt_size);
-	memmove(dst, src, remove_count * elmt_size);
+static inline uint32_t _das_tcache_class_idx(uintptr_t class_size) {
+	return das_most_set_bit_idx(class_size) - _das_tcache_min_size_shift;
 }
 
-void _DasStk_remove_shift_range(_DasStkHeader* header, uintptr_t header_size, uintptr_t start_idx, uintptr_t end_idx, uintptr_t elmt_size) {
-	das_assert(start_idx <= header->count, "start_idx '%zu' must be less than the count of '%zu'", start_idx, header->count);
-	das_assert(end_idx <= header->count, "end_idx '%zu' must be less than or equal to count of '%zu'", end_idx, header->count);
+//
+// pushes a chain of blocks, from @param(head) to @param(tail), on to the central free list
+static void _das_tcache_central_push(uint32_t class_idx, void* head, void* tail) {
+	_DasTCacheCentralList* central = &_das_tcache_central_lists[class_idx];
+	das_spin_lock(&central->lock);
+	*(void**)tail = central->head;
+	central->head = head;
+	das_spin_unlock(&central->lock);
+}
+
+//
+// fills up the calling thread's cache with a batch of blocks.
+// the blocks come from the central free list and if that is empty, from a newly carved chunk.
+static DasBool _das_tcache_refill(uint32_t class_idx, uintptr_t class_size) {
+	_DasTCacheThreadList* list = &_das_tcache_thread_lists[class_idx];
+	_DasTCacheCentralList* central = &_das_tcache_central_lists[class_idx];
+	if (!_das_tcache_thread_is_registered) {
+		_das_tcache_thread_register();
+	}
 
 	//
-	// get the pointer where the elements are being removed
-	uintptr_t remove_count = end_idx - start_idx;
-	void* data = das_ptr_add(header, header_size);
-	void* dst = das_ptr_add(data, start_idx * elmt_size);
+	// take up to a batch of blocks from the central free list.
+	das_spin_lock(&central->lock);
+	void* head = central->head;
+	void* tail = NULL;
+	uint32_t count = 0;
+	for (void* block = head; block && count < das_tcache_batch_count; block = *(void**)block) {
+		tail = block;
+		count += 1;
+	}
+	if (tail) {
+		central->head = *(void**)tail;
+	}
+	das_spin_unlock(&central->lock);
+
+	if (count) {
+		*(void**)tail = list->head;
+		list->head = head;
+		list->count += count;
+		return das_true;
+	}
 
 	//
-	// now replace the elements by shifting the elements to the right over them.
-	if (end_idx < header->count) {
-		void* src = das_ptr_add(dst, remove_count * elmt_size);
-		memmove(dst, src, (header->count - (start_idx + remove_count)) * elmt_size);
+	// the central free list is empty, so carve up a new chunk into blocks.
+	// the chunk is aligned to the size class, so every block is too.
+	uintptr_t chunk_size = das_max_u(class_size * das_tcache_batch_count, _das_tcache_chunk_min_size);
+	void* chunk = das_system_alloc_fn(NULL, NULL, 0, chunk_size, das_max_u(class_size, alignof(das_max_align_t)));
+	if (!chunk) return das_false;
+
+	uintptr_t blocks_count = chunk_size / class_size;
+	for (uintptr_t i = 0; i < blocks_count - 1; i += 1) {
+		void* block = das_ptr_add(chunk, i * class_size);
+		*(void**)block = das_ptr_add(block, class_size);
 	}
-	header->count -= remove_count;
+	void* last_block = das_ptr_add(chunk, (blocks_count - 1) * class_size);
+	*(void**)last_block = NULL;
+
+	//
+	// keep the first batch for this thread and give the rest to the central free list.
+	uintptr_t keep_count = das_min_u(das_tcache_batch_count, blocks_count);
+	void* keep_tail = das_ptr_add(chunk, (keep_count - 1) * class_size);
+	if (keep_count < blocks_count) {
+		void* rest_head = *(void**)keep_tail;
+		_das_tcache_central_push(class_idx, rest_head, last_block);
+	}
+
+	*(void**)keep_tail = list->head;
+	list->head = chunk;
+	list->count += keep_count;
+	return das_true;
 }
 
-char* DasStk_push_str(DasStk(char)* stk, char* str) {
-	uintptr_t len = strlen(str);
-	return DasStk_push_many(stk, str, len);
+//
+// gives a batch of blocks from the calling thread's cache back to the central free list.
+static void _das_tcache_release_batch(uint32_t class_idx) {
+	_DasTCacheThreadList* list = &_das_tcache_thread_lists[class_idx];
+	void* head = list->head;
+	void* tail = head;
+	for (uint32_t i = 1; i < das_tcache_batch_count; i += 1) {
+		tail = *(void**)tail;
+	}
+
+	list->head = *(void**)tail;
+	list->count -= das_tcache_batch_count;
+	_das_tcache_central_push(class_idx, head, tail);
 }
 
-void* DasStk_push_str_fmtv(DasStk(char)* stk, char* fmt, va_list args) {
-	va_list args_copy;
-	va_copy(args_copy, args);
+void* das_tcache_alloc_fn(void* alloc_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	if (!ptr && size == 0) {
+		// reset not supported so do nothing
+		return NULL;
+	} else if (!ptr) {
+		// allocate
+		uintptr_t class_size = _das_tcache_class_size(size, align);
+		if (class_size > das_tcache_max_size) {
+			return das_system_alloc_fn(NULL, NULL, 0, size, align);
+		}
 
-	// add 1 so we have enough room for the null terminator that vsnprintf always outputs
-	// vsnprintf will return -1 on an encoding error.
-	uintptr_t count = vsnprintf(NULL, 0, fmt, args_copy) + 1;
-	va_end(args_copy);
-	das_assert(count >= 1, "a vsnprintf encoding error has occurred");
+		uint32_t class_idx = _das_tcache_class_idx(class_size);
+		_DasTCacheThreadList* list = &_das_tcache_thread_lists[class_idx];
+		if (!list->head && !_das_tcache_refill(class_idx, class_size)) {
+			return NULL;
+		}
 
-	//
-	// resize the stack to have enough room to store the pushed formatted string
-	uintptr_t insert_idx = DasStk_count(stk);
-	uintptr_t new_count = DasStk_count(stk) + count;
-	DasBool res = DasStk_resize_cap(stk, new_count);
-	if (!res) return NULL;
+		ptr = list->head;
+		list->head = *(void**)ptr;
+		list->count -= 1;
+		return ptr;
+	} else if (ptr && size > 0) {
+		// reallocate
+		uintptr_t old_class_size = _das_tcache_class_size(old_size, align);
+		uintptr_t class_size = _das_tcache_class_size(size, align);
+		if (old_class_size > das_tcache_max_size && class_size > das_tcache_max_size) {
+			return das_system_alloc_fn(NULL, ptr, old_size, size, align);
+		}
 
-	//
-	// now call vsnprintf for real this time, with a buffer
-	// to actually copy the formatted string.
-	char* ptr = das_ptr_add(DasStk_data(stk), insert_idx);
-	count = vsnprintf(ptr, count, fmt, args);
-	DasStk_set_count(stk, new_count - 1); // now set the new count minus the null terminator
-	return ptr;
+		if (old_class_size == class_size) {
+			return ptr;
+		}
+
+		void* new_ptr = das_tcache_alloc_fn(NULL, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		das_tcache_alloc_fn(NULL, ptr, old_size, 0, align);
+		return new_ptr;
+	} else {
+		// deallocate
+		uintptr_t class_size = _das_tcache_class_size(old_size, align);
+		if (class_size > das_tcache_max_size) {
+			return das_system_alloc_fn(NULL, ptr, old_size, 0, align);
+		}
+
+		uint32_t class_idx = _das_tcache_class_idx(class_size);
+		_DasTCacheThreadList* list = &_das_tcache_thread_lists[class_idx];
+		*(void**)ptr = list->head;
+		list->head = ptr;
+		list->count += 1;
+
+		//
+		// give some back to the central free list, but keep a batch
+		// so alternating allocs and deallocs do not keep moving the same blocks back and forth.
+		if (list->count >= das_tcache_batch_count * 2) {
+			_das_tcache_release_batch(class_idx);
+		}
+		return NULL;
+	}
 }
 
-void* DasStk_push_str_fmt(DasStk(char)* stk, char* fmt, ...) {
-	va_list args;
-	va_start(args, fmt);
-	void* ptr = DasStk_push_str_fmtv(stk, fmt, args);
-	va_end(args);
-	return ptr;
+DasBool das_tcache_alloc_ext_fn(void* alloc_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			return das_false;
+		case DasAllocExtOp_usable_size: {
+			uintptr_t class_size = _das_tcache_class_size(args->old_size, args->align);
+			if (class_size > das_tcache_max_size) {
+				return das_system_alloc_ext_fn(NULL, op, args);
+			}
+
+			args->size = class_size;
+			return das_true;
+		}
+	}
+
+	return das_false;
+}
+
+void das_tcache_thread_flush(void) {
+	for (uint32_t class_idx = 0; class_idx < _das_tcache_classes_cap; class_idx += 1) {
+		_DasTCacheThreadList* list = &_das_tcache_thread_lists[class_idx];
+		if (!list->head) continue;
+
+		void* tail = list->head;
+		while (*(void**)tail) {
+			tail = *(void**)tail;
+		}
+
+		_das_tcache_central_push(class_idx, list->head, tail);
+		list->head = NULL;
+		list->count = 0;
+	}
 }
 
 // ======================================================================
 //
 //
-// DasDeque - double ended queue (ring buffer)
+// Statistics Allocator
 //
 //
 // ======================================================================
 
-static inline uintptr_t _DasDeque_wrapping_add(uintptr_t cap, uintptr_t idx, uintptr_t value) {
-    uintptr_t res = idx + value;
-    if (res >= cap) res = value - (cap - idx);
-    return res;
+static inline uint32_t _DasAllocStats_histogram_bucket(uintptr_t size) {
+	if (size == 0) return 0;
+	return das_min_u(das_most_set_bit_idx(size), DasAllocStats_histogram_buckets_count - 1);
 }
 
-static inline uintptr_t _DasDeque_wrapping_sub(uintptr_t cap, uintptr_t idx, uintptr_t value) {
-    uintptr_t res = idx - value;
-    if (res > idx) res = cap - (value - idx);
-    return res;
+//
+// adds @param(delta) to the live bytes, this can be negative by wrapping around.
+// the peak is bumped up with a compare and swap if the live bytes have gone past it.
+static void _DasStatsAlctor_add_live_bytes(DasStatsAlctor* alctor, uintptr_t delta) {
+	uintptr_t live_bytes = das_atomic_fetch_add_u(&alctor->live_bytes, delta) + delta;
+	if ((intptr_t)delta <= 0)
+		return;
+
+	uintptr_t peak_live_bytes = das_atomic_load_u(&alctor->peak_live_bytes);
+	while (live_bytes > peak_live_bytes) {
+		if (das_atomic_cas_u(&alctor->peak_live_bytes, peak_live_bytes, live_bytes))
+			break;
+		peak_live_bytes = das_atomic_load_u(&alctor->peak_live_bytes);
+	}
 }
 
-DasBool _DasDeque_init_with_alctor(_DasDequeHeader** header_out, uintptr_t header_size, uintptr_t init_cap, DasAlctor alctor, uintptr_t elmt_size) {
-	// add one because the back_idx needs to point to the next empty element slot.
-	init_cap = das_max_u(DasDeque_min_cap, init_cap);
-	init_cap += 1;
+void DasStatsAlctor_init(DasStatsAlctor* alctor, DasAlctor inner) {
+	das_zero_elmt(alctor);
+	alctor->inner = inner;
+}
+
+void DasStatsAlctor_get(DasStatsAlctor* alctor, DasAllocStats* stats_out) {
+	das_zero_elmt(stats_out);
+	for (uint32_t slot_idx = 0; slot_idx < DasStatsAlctor_slots_count; slot_idx += 1) {
+		DasAllocStats* slot = &alctor->slots[slot_idx].stats;
+		stats_out->alloc_count += das_atomic_load_u(&slot->alloc_count);
+		stats_out->realloc_count += das_atomic_load_u(&slot->realloc_count);
+		stats_out->dealloc_count += das_atomic_load_u(&slot->dealloc_count);
+		stats_out->reset_count += das_atomic_load_u(&slot->reset_count);
+		stats_out->failed_count += das_atomic_load_u(&slot->failed_count);
+		stats_out->alloced_bytes += das_atomic_load_u(&slot->alloced_bytes);
+		stats_out->realloc_moved_count += das_atomic_load_u(&slot->realloc_moved_count);
+		stats_out->realloc_moved_bytes += das_atomic_load_u(&slot->realloc_moved_bytes);
+		for (uint32_t i = 0; i < DasAllocStats_histogram_buckets_count; i += 1) {
+			stats_out->size_histogram[i] += das_atomic_load_u(&slot->size_histogram[i]);
+		}
+	}
+
+	stats_out->live_bytes = das_atomic_load_u(&alctor->live_bytes);
+	stats_out->peak_live_bytes = das_atomic_load_u(&alctor->peak_live_bytes);
+}
+
+//
+// records a call to the DasAllocFn with the arguments and the pointer that it returned.
+static void _DasStatsAlctor_record(DasStatsAlctor* alctor, void* ptr, uintptr_t old_size, uintptr_t size, void* new_ptr) {
+	DasAllocStats* slot = &alctor->slots[das_thread_idx() % DasStatsAlctor_slots_count].stats;
+	if (!ptr && size == 0) {
+		// reset
+		das_atomic_fetch_add_u(&slot->reset_count, 1);
+		das_atomic_store_u(&alctor->live_bytes, 0);
+	} else if (!ptr) {
+		// allocate
+		das_atomic_fetch_add_u(&slot->alloc_count, 1);
+		das_atomic_fetch_add_u(&slot->size_histogram[_DasAllocStats_histogram_bucket(size)], 1);
+		if (new_ptr == NULL) {
+			das_atomic_fetch_add_u(&slot->failed_count, 1);
+		} else {
+			das_atomic_fetch_add_u(&slot->alloced_bytes, size);
+			_DasStatsAlctor_add_live_bytes(alctor, size);
+		}
+	} else if (ptr && size > 0) {
+		// reallocate
+		das_atomic_fetch_add_u(&slot->realloc_count, 1);
+		das_atomic_fetch_add_u(&slot->size_histogram[_DasAllocStats_histogram_bucket(size)], 1);
+		if (new_ptr == NULL) {
+			das_atomic_fetch_add_u(&slot->failed_count, 1);
+		} else {
+			if (new_ptr != ptr) {
+				das_atomic_fetch_add_u(&slot->realloc_moved_count, 1);
+				das_atomic_fetch_add_u(&slot->realloc_moved_bytes, das_min_u(old_size, size));
+			}
+			_DasStatsAlctor_add_live_bytes(alctor, size - old_size);
+		}
+	} else {
+		// deallocate
+		das_atomic_fetch_add_u(&slot->dealloc_count, 1);
+		_DasStatsAlctor_add_live_bytes(alctor, -old_size);
+	}
+}
+
+void* DasStatsAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasStatsAlctor* alctor = (DasStatsAlctor*)alctor_data;
+	void* new_ptr = alctor->inner.fn(alctor->inner.data, ptr, old_size, size, align);
+	_DasStatsAlctor_record(alctor, ptr, old_size, size, new_ptr);
+	return new_ptr;
+}
+
+DasBool DasStatsAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasStatsAlctor* alctor = (DasStatsAlctor*)alctor_data;
+	void* ptr = args->ptr;
+	uintptr_t old_size = args->old_size;
+	if (!_DasAlctor_ext(alctor->inner, op, args))
+		return das_false;
+
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			_DasStatsAlctor_record(alctor, ptr, old_size, args->size, ptr);
+			break;
+		case DasAllocExtOp_usable_size:
+			//
+			// the allocation can now be deallocated with the usable size, so count the extra bytes as live.
+			_DasStatsAlctor_add_live_bytes(alctor, args->size - old_size);
+			break;
+		case DasAllocExtOp_alloc_batch:
+			if (args->count == 0) {
+				_DasStatsAlctor_record(alctor, NULL, 0, args->size, NULL);
+			}
+			for (uintptr_t i = 0; i < args->count; i += 1) {
+				_DasStatsAlctor_record(alctor, NULL, 0, args->size, args->ptrs[i]);
+			}
+			break;
+		case DasAllocExtOp_dealloc_batch:
+			for (uintptr_t i = 0; i < args->count; i += 1) {
+				_DasStatsAlctor_record(alctor, args->ptrs[i], args->old_size, 0, NULL);
+			}
+			break;
+		case DasAllocExtOp_alloc_zeroed:
+		case DasAllocExtOp_realloc_zeroed:
+			_DasStatsAlctor_record(alctor, ptr, old_size, args->size, args->ptr);
+			break;
+		case DasAllocExtOp_owns:
+			break;
+	}
+
+	return das_true;
+}
+
+// ======================================================================
+//
+//
+// DasStk - linear stack of elements (LIFO)
+//
+//
+// ======================================================================
 
+DasBool _DasStk_init_with_alctor(_DasStkHeader** header_out, uintptr_t header_size, uintptr_t init_cap, DasAlctor alctor, uintptr_t elmt_size) {
+	init_cap = das_max_u(DasStk_min_cap, init_cap);
 	uintptr_t new_size = header_size + init_cap * elmt_size;
-	_DasDequeHeader* new_header = das_alloc(alctor, new_size, alignof(das_max_align_t));
+	_DasStkHeader* new_header = das_alloc(alctor, new_size, alignof(das_max_align_t));
 	if (!new_header) return das_false;
+	new_size = das_usable_size(alctor, new_header, new_size, alignof(das_max_align_t));
 
 	//
 	// initialize the header and pass out the new header pointer
-	new_header->cap = init_cap;
-	new_header->front_idx = 0;
-	new_header->back_idx = 0;
+	new_header->count = 0;
+	new_header->cap = (new_size - header_size) / elmt_size;
 	new_header->alctor = alctor;
 	*header_out = new_header;
 	return das_true;
-
 }
 
+DasBool _DasStk_init_clone_with_alctor(_DasStkHeader** dst_header_in_out, uintptr_t header_size, _DasStkHeader* src_header, DasAlctor alctor, uintptr_t elmt_size) {
+	uintptr_t src_count = DasStk_count(&src_header);
+	if (!_DasStk_init_with_alctor(dst_header_in_out, header_size, src_count, alctor, elmt_size))
+		return das_false;
 
-void _DasDeque_deinit(_DasDequeHeader** header_in_out, uintptr_t header_size, uintptr_t elmt_size) {
-	_DasDequeHeader* header = *header_in_out;
-	uintptr_t size = header_size + header->cap * elmt_size;
+	_DasStkHeader* dst_header = *dst_header_in_out;
+
+	void* dst = das_ptr_add(dst_header, header_size);
+	void* src = das_ptr_add(src_header, header_size);
+	memcpy(dst, src, src_count * elmt_size);
+	dst_header->count = src_count;
+	return das_true;
+}
+
+void _DasStk_deinit(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t elmt_size) {
+	_DasStkHeader* header = *header_in_out;
+	uintptr_t size = header_size + header->cap * elmt_size;
 	das_dealloc(header->alctor, header, size, alignof(das_max_align_t));
 	*header_in_out = NULL;
 }
 
-uintptr_t _DasDeque_assert_idx(_DasDequeHeader* header, uintptr_t idx, uintptr_t elmt_size) {
-	uintptr_t count = DasDeque_count(&header);
-	das_assert(idx < count, "idx '%zu' is out of bounds for a deque of count '%zu'", idx, count);
-    idx = _DasDeque_wrapping_add(header->cap, header->front_idx, idx);
-    return idx;
+uintptr_t _DasStk_assert_idx(_DasStkHeader* header, uintptr_t idx, uintptr_t elmt_size) {
+	das_assert(header != NULL && idx < header->count, "idx '%zu' is out of bounds for a stack of count '%zu'", idx, header ? header->count : 0);
+	return idx;
 }
 
-DasBool _DasDeque_resize_cap(_DasDequeHeader** header_in_out, uintptr_t header_size, uintptr_t new_cap, uintptr_t elmt_size) {
-	_DasDequeHeader* header = *header_in_out;
+//
+// the same as _DasStk_resize_cap, but when @param(zero_in_out) is das_true, the allocator is asked for zeroed memory
+// for the new capacity. @param(zero_in_out) is set to das_false if the allocator did not zero it.
+static DasBool _DasStk_resize_cap_zeroed(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t new_cap, DasBool* zero_in_out, uintptr_t elmt_size) {
+	_DasStkHeader* header = *header_in_out;
 	uintptr_t cap = header ? header->cap : 0;
-	new_cap = das_max_u(das_max_u(DasDeque_min_cap, new_cap), DasDeque_count(header_in_out));
-	// add one because the back_idx needs to point to the next empty element slot.
-	new_cap += 1;
-	if (new_cap == cap) return das_true;
-
+	uintptr_t count = header ? header->count : 0;
 	DasAlctor alctor = header && header->alctor.fn != NULL ? header->alctor : DasAlctor_default;
 
+	//
+	// return if the capacity has not changed
+	new_cap = das_max_u(das_max_u(DasStk_min_cap, new_cap), count);
+	if (cap == new_cap) {
+		*zero_in_out = das_false;
+		return das_true;
+	}
+
+	//
+	// reallocate the stack while taking into account of size of the header.
+	// the block of memory is aligned to alignof(das_max_align_t).
 	uintptr_t size = header ? header_size + cap * elmt_size : 0;
 	uintptr_t new_size = header_size + new_cap * elmt_size;
-	_DasDequeHeader* new_header = das_realloc(alctor, header, size, new_size, alignof(das_max_align_t));
+
+	//
+	// only use the allocator to zero the memory if it can do it for free,
+	// otherwise it would zero all of the new capacity and not just the elements that need it.
+	DasAllocExtArgs args = { .ptr = header, .old_size = size, .size = new_size, .align = alignof(das_max_align_t) };
+	DasAllocExtOp zeroed_op = header ? DasAllocExtOp_realloc_zeroed : DasAllocExtOp_alloc_zeroed;
+	if (!(*zero_in_out && new_cap > cap && alctor.ext_fn && alctor.ext_fn(alctor.data, zeroed_op, &args))) {
+		*zero_in_out = das_false;
+	}
+
+	_DasStkHeader* new_header;
+	if (*zero_in_out) {
+		new_header = args.ptr;
+	} else if (header && new_cap > cap && das_try_expand(alctor, header, size, new_size, alignof(das_max_align_t))) {
+		//
+		// grown in place, this avoids the allocator copying the elements.
+		new_header = header;
+	} else {
+		new_header = das_realloc(alctor, header, size, new_size, alignof(das_max_align_t));
+	}
+
 	if (!new_header) return das_false;
 	if (!header) {
 		new_header->alctor = alctor;
-		new_header->front_idx = 0;
-		new_header->back_idx = 0;
-		new_header->cap = 0;
+		new_header->count = 0;
 	}
 
-	uintptr_t old_cap = new_header->cap;
-	new_header->cap = new_cap;
-	*header_in_out = new_header;
-
-	void* data = das_ptr_add(new_header, header_size);
-
-	// move the front_idx and back_idx around to resolve the gaps that could have been created after resizing the buffer
 	//
-    // A - no gaps created so no need to change
-    // --------
-    //   F     B        F     B
-    // [ V V V . ] -> [ V V V . . . . ]
-    //
-    // B - less elements before back_idx than elements from front_idx, so copy back_idx after the front_idx
-    //       B F                  F         B
-    // [ V V . V V V ] -> [ . . . V V V V V . . . . . ]
-    //
-    // C - more elements before back_idx than elements from front_idx, so copy front_idx to the end
-    //       B F           B           F
-    // [ V V . V] -> [ V V . . . . . . V ]
-    //
-    if (new_header->front_idx <= new_header->back_idx) { // A
-		// do nothing
-    } else if (new_header->back_idx  < old_cap - new_header->front_idx) { // B
-        memcpy(das_ptr_add(data, old_cap * elmt_size), data, new_header->back_idx * elmt_size);
-        new_header->back_idx += old_cap;
-        das_debug_assert(new_header->back_idx > new_header->front_idx, "back_idx must come after front_idx");
-    } else { // C
-        uintptr_t new_front_idx = new_cap - (old_cap - new_header->front_idx);
-        memcpy(das_ptr_add(data, new_front_idx * elmt_size), das_ptr_add(data, new_header->front_idx * elmt_size), (old_cap - new_header->front_idx) * elmt_size);
-        new_header->front_idx = new_front_idx;
-        das_debug_assert(new_header->back_idx < new_header->front_idx, "front_idx must come after back_idx");
-    }
+	// use any extra bytes the allocator has given us, so we do not resize as often.
+	new_size = das_usable_size(alctor, new_header, new_size, alignof(das_max_align_t));
+	new_cap = (new_size - header_size) / elmt_size;
 
-	das_debug_assert(new_header->back_idx < new_cap, "back_idx must remain in bounds");
-	das_debug_assert(new_header->front_idx < new_cap, "front_idx must remain in bounds");
+	//
+	// update the capacity in the header and pass out the new header pointer
+	new_header->cap = new_cap;
+	*header_in_out = new_header;
 	return das_true;
 }
 
-void _DasDeque_read(_DasDequeHeader* header, uintptr_t header_size, uintptr_t idx, void* elmts_out, uintptr_t elmts_count, uintptr_t elmt_size) {
-	uintptr_t count = DasDeque_count(&header);
-	das_assert(idx + elmts_count <= count, "idx '%zu' and elmts_count '%zu' will go out of bounds for a deque of count '%zu'", idx, count);
-
-    idx = _DasDeque_wrapping_add(header->cap, header->front_idx, idx);
+DasBool _DasStk_resize(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t new_count, DasBool zero, uintptr_t elmt_size) {
+	_DasStkHeader* header = *header_in_out;
+	if (new_count == 0) {
+		if (header) {
+			_DasStk_deinit(header_in_out, header_size, elmt_size);
+		}
+		return das_true;
+	}
 
-	void* data = das_ptr_add(header, header_size);
-	if (header->cap < idx + elmts_count) {
-		//
-		// there is enough elements that the read will
-		// exceed the back and cause the idx to loop around.
-		// so copy in two parts
-		uintptr_t rem_count = header->cap - idx;
-		// copy to the end of the buffer
-		memcpy(elmts_out, das_ptr_add(data, idx * elmt_size), rem_count * elmt_size);
-		// copy to the beginning of the buffer
-		memcpy(das_ptr_add(elmts_out, rem_count * elmt_size), data, ((elmts_count - rem_count) * elmt_size));
-	} else {
-		//
-		// coping the elements can be done in a single copy
-		memcpy(elmts_out, das_ptr_add(data, idx * elmt_size), elmts_count * elmt_size);
+	//
+	// extend the capacity of the stack if the new count extends past the capacity.
+	// if we need zeroed elements, ask the allocator to give us zeroed memory for the new capacity.
+	uintptr_t old_cap = DasStk_cap(header_in_out);
+	DasBool is_grown_zeroed = das_false;
+	if (old_cap < new_count) {
+		is_grown_zeroed = zero;
+		DasBool res = _DasStk_resize_cap_zeroed(header_in_out, header_size, das_max_u(new_count, old_cap * 2), &is_grown_zeroed, elmt_size);
+		if (!res) return das_false;
+		header = *header_in_out;
 	}
-}
 
-void _DasDeque_write(_DasDequeHeader* header, uintptr_t header_size, uintptr_t idx, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
-	uintptr_t count = DasDeque_count(&header);
-	das_assert(idx + elmts_count <= count, "idx '%zu' and elmts_count '%zu' will go out of bounds for a deque of count '%zu'", idx, count);
+	//
+	// zero the new memory if requested, the memory past the old capacity may have already been zeroed by the allocator.
+	uintptr_t count = header->count;
+	uintptr_t zero_end = is_grown_zeroed ? das_min_u(new_count, old_cap) : new_count;
+	if (zero && zero_end > count) {
+		void* data = das_ptr_add(header, header_size);
+		memset(das_ptr_add(data, count * elmt_size), 0, (zero_end - count) * elmt_size);
+	}
 
-    idx = _DasDeque_wrapping_add(header->cap, header->front_idx, idx);
+	header->count = new_count;
+	return das_true;
+}
 
-	void* data = das_ptr_add(header, header_size);
-	if (header->cap < idx + elmts_count) {
-		//
-		// there is enough elements that the write will
-		// exceed the back and cause the idx to loop around.
-		// so copy in two parts
-		uintptr_t rem_count = header->cap - idx;
-		// copy to the end of the buffer
-		memcpy(das_ptr_add(data, idx * elmt_size), elmts, rem_count * elmt_size);
-		// copy to the beginning of the buffer
-		memcpy(data, das_ptr_add(elmts, rem_count * elmt_size), ((elmts_count - rem_count) * elmt_size));
-	} else {
-		//
-		// coping the elements can be done in a single copy
-		memcpy(das_ptr_add(data, idx * elmt_size), elmts, elmts_count * elmt_size);
-	}
+DasBool _DasStk_resize_cap(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t new_cap, uintptr_t elmt_size) {
+	DasBool zero = das_false;
+	return _DasStk_resize_cap_zeroed(header_in_out, header_size, new_cap, &zero, elmt_size);
 }
 
-uintptr_t _DasDeque_push_front_many(_DasDequeHeader** header_in_out, uintptr_t header_size, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
-	_DasDequeHeader* header = *header_in_out;
-	uintptr_t new_count = DasDeque_count(header_in_out) + elmts_count;
+void* _DasStk_insert_many(_DasStkHeader** header_in_out, uintptr_t header_size, uintptr_t idx, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
+	_DasStkHeader* header = *header_in_out;
+	das_assert(idx <= header->count, "insert idx '%zu' must be less than or equal to count of '%zu'", idx, header->count);
+	uintptr_t count = header ? header->count : 0;
 	uintptr_t cap = header ? header->cap : 0;
-	if (cap < new_count + 1) {
-		DasBool res = _DasDeque_resize_cap(header_in_out, header_size, das_max_u(cap * 2, new_count), elmt_size);
-		if (!res) return UINTPTR_MAX;
+
+	//
+	// increase the capacity if the number of elements
+	// inserted makes the stack exceed it's capacity.
+    uintptr_t new_count = count + elmts_count;
+    if (cap < new_count) {
+		DasBool res = _DasStk_resize_cap(header_in_out, header_size, das_max_u(new_count, cap * 2), elmt_size);
+		if (!res) return NULL;
 		header = *header_in_out;
-	}
+    }
 
-	header->front_idx = _DasDeque_wrapping_sub(header->cap, header->front_idx, elmts_count);
+	void* data = das_ptr_add(header, header_size);
+    void* dst = das_ptr_add(data, idx * elmt_size);
+
+	// shift the elements from idx to (idx + elmts_count), to the right
+	// to make room for the elements
+    memmove(das_ptr_add(dst, elmts_count * elmt_size), dst, (header->count - idx) * elmt_size);
 
 	if (elmts) {
-		_DasDeque_write(header, header_size, 0, elmts, elmts_count, elmt_size);
+		memcpy(dst, elmts, elmts_count * elmt_size);
 	}
 
-	return 0;
+    header->count = new_count;
+	return dst;
 }
 
-uintptr_t _DasDeque_push_back_many(_DasDequeHeader** header_in_out, uintptr_t header_size, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
-	_DasDequeHeader* header = *header_in_out;
-	uintptr_t insert_idx = DasDeque_count(header_in_out);
-	uintptr_t new_count = insert_idx + elmts_count;
+void* _DasStk_push_many(_DasStkHeader** header_in_out, uintptr_t header_size, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
+	das_debug_assert(elmts_count != 0, "cannot push zero elements on a stack");
+	_DasStkHeader* header = *header_in_out;
+	uintptr_t count = header ? header->count : 0;
 	uintptr_t cap = header ? header->cap : 0;
-	if (cap < new_count + 1) {
-		DasBool res = _DasDeque_resize_cap(header_in_out, header_size, das_max_u(cap * 2, new_count), elmt_size);
-		if (!res) return UINTPTR_MAX;
+	uintptr_t idx = count;
+
+	//
+	// increase the capacity if the number of elements
+	// pushed on makes the stack exceed it's capacity.
+	uintptr_t new_count = count + elmts_count;
+	if (new_count > cap) {
+		DasBool res = _DasStk_resize_cap(header_in_out, header_size, das_max_u(new_count, cap * 2), elmt_size);
+		if (!res) return NULL;
 		header = *header_in_out;
 	}
 
-	header->back_idx = _DasDeque_wrapping_add(header->cap, header->back_idx, elmts_count);
-
+	void* dst = das_ptr_add(header, header_size + idx * elmt_size);
 	if (elmts) {
-		_DasDeque_write(header, header_size, insert_idx, elmts, elmts_count, elmt_size);
+		memcpy(dst, elmts, elmts_count * elmt_size);
 	}
 
-	return insert_idx;
+	header->count = new_count;
+	return dst;
 }
 
-uintptr_t _DasDeque_pop_front_many(_DasDequeHeader* header, uintptr_t elmts_count, uintptr_t elmt_size) {
-    if (header->front_idx == header->back_idx) return 0;
-	elmts_count = das_min_u(elmts_count, DasDeque_count(&header));
-
-	header->front_idx = _DasDeque_wrapping_add(header->cap, header->front_idx, elmts_count);
+uintptr_t _DasStk_pop_many(_DasStkHeader* header, uintptr_t elmts_count, uintptr_t elmt_size) {
+	elmts_count = das_min_u(elmts_count, header->count);
+	header->count -= elmts_count;
 	return elmts_count;
 }
 
-uintptr_t _DasDeque_pop_back_many(_DasDequeHeader* header, uintptr_t elmts_count, uintptr_t elmt_size) {
-    if (header->front_idx == header->back_idx) return 0;
-	elmts_count = das_min_u(elmts_count, DasDeque_count(&header));
+void _DasStk_remove_swap_range(_DasStkHeader* header, uintptr_t header_size, uintptr_t start_idx, uintptr_t end_idx, uintptr_t elmt_size) {
+	das_assert(start_idx <= header->count, "start_idx '%zu' must be less than the count of '%zu'", start_idx, header->count);
+	das_assert(end_idx <= header->count, "end_idx '%zu' must be less than or equal to count of '%zu'", end_idx, header->count);
 
-	header->back_idx = _DasDeque_wrapping_sub(header->cap, header->back_idx, elmts_count);
-	return elmts_count;
-}
+	//
+	// get the pointer where the elements are being removed
+	uintptr_t remove_count = end_idx - start_idx;
+	void* data = das_ptr_add(header, header_size);
+	void* dst = das_ptr_add(data, start_idx * elmt_size);
 
-// ===========================================================================
-//
-//
-// Stacktrace
-//
-//
-// ===========================================================================
+	//
+	// work out where the elements at the back of the stack start from.
+	uintptr_t src_idx = header->count;
+	header->count -= remove_count;
+	if (remove_count > header->count) remove_count = header->count;
+	src_idx -= remove_count;
 
-#ifdef __GNUC__
-#include <execinfo.h>
-#endif
+	//
+	// replace the removed elements with the elements from the back of the stack.
+	void* src = das_ptr_add(data, src_idx * elmt_size);
+	memmove(dst, src, remove_count * elmt_size);
+}
 
-DasBool das_stacktrace(uint32_t ignore_levels_count, DasStk(char)* string_out) {
-#define STACKTRACE_LEVELS_MAX 128
-#if defined(__GNUC__)
-	void* stacktrace_levels[STACKTRACE_LEVELS_MAX];
-	int stacktrace_levels_count = backtrace(stacktrace_levels, STACKTRACE_LEVELS_MAX);
+void _DasStk_remove_shift_range(_DasStkHeader* header, uintptr_t header_size, uintptr_t start_idx, uintptr_t end_idx, uintptr_t elmt_size) {
+	das_assert(start_idx <= header->count, "start_idx '%zu' must be less than the count of '%zu'", start_idx, header->count);
+	das_assert(end_idx <= header->count, "end_idx '%zu' must be less than or equal to count of '%zu'", end_idx, header->count);
 
-	char** strings = backtrace_symbols(stacktrace_levels, stacktrace_levels_count);
-	if (strings == NULL) return das_false;
+	//
+	// get the pointer where the elements are being removed
+	uintptr_t remove_count = end_idx - start_idx;
+	void* data = das_ptr_add(header, header_size);
+	void* dst = das_ptr_add(data, start_idx * elmt_size);
 
-	for (int i = ignore_levels_count; i < stacktrace_levels_count; i += 1) {
-		if (!DasStk_push_str_fmt(string_out, "%u: %s\n", stacktrace_levels_count - i - 1, strings[i])) {
-			return das_false;
-		}
+	//
+	// now replace the elements by shifting the elements to the right over them.
+	if (end_idx < header->count) {
+		void* src = das_ptr_add(dst, remove_count * elmt_size);
+		memmove(dst, src, (header->count - (start_idx + remove_count)) * elmt_size);
 	}
+	header->count -= remove_count;
+}
 
-	free(strings);
-#elif defined(_WIN32)
-	void* stacktrace_levels[STACKTRACE_LEVELS_MAX];
-	HANDLE process = GetCurrentProcess();
+char* DasStk_push_str(DasStk(char)* stk, char* str) {
+	uintptr_t len = strlen(str);
+	return DasStk_push_many(stk, str, len);
+}
 
-	SymInitialize(process, NULL, TRUE);
+void* DasStk_push_str_fmtv(DasStk(char)* stk, char* fmt, va_list args) {
+	va_list args_copy;
+	va_copy(args_copy, args);
 
-	uint32_t stacktrace_levels_count = CaptureStackBackTrace(0, STACKTRACE_LEVELS_MAX, stacktrace_levels, NULL);
-	SYMBOL_INFO* symbol = (SYMBOL_INFO*)calloc(sizeof(SYMBOL_INFO) + 256 * sizeof(char), 1);
-	symbol->MaxNameLen   = 255;
-	symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+	// add 1 so we have enough room for the null terminator that vsnprintf always outputs
+	// vsnprintf will return -1 on an encoding error.
+	uintptr_t count = vsnprintf(NULL, 0, fmt, args_copy) + 1;
+	va_end(args_copy);
+	das_assert(count >= 1, "a vsnprintf encoding error has occurred");
 
-	for (uint32_t i = ignore_levels_count; i < stacktrace_levels_count; i += 1) {
-		SymFromAddr(process, (DWORD64)stacktrace_levels[i], 0, symbol);
-		if (!DasStk_push_str_fmt(string_out, "%u: %s - [0x%0X]\n", stacktrace_levels_count - i - 1, symbol->Name, symbol->Address)) {
-			return das_false;
-		}
-	}
+	//
+	// resize the stack to have enough room to store the pushed formatted string
+	uintptr_t insert_idx = DasStk_count(stk);
+	uintptr_t new_count = DasStk_count(stk) + count;
+	DasBool res = DasStk_resize_cap(stk, new_count);
+	if (!res) return NULL;
 
-	free(symbol);
-#else
-#error "das_stacktrace has been unimplemented for this platform"
-#endif
+	//
+	// now call vsnprintf for real this time, with a buffer
+	// to actually copy the formatted string.
+	char* ptr = das_ptr_add(DasStk_data(stk), insert_idx);
+	count = vsnprintf(ptr, count, fmt, args);
+	DasStk_set_count(stk, new_count - 1); // now set the new count minus the null terminator
+	return ptr;
+}
 
-	return das_true;
+void* DasStk_push_str_fmt(DasStk(char)* stk, char* fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	void* ptr = DasStk_push_str_fmtv(stk, fmt, args);
+	va_end(args);
+	return ptr;
 }
 
-// ===========================================================================
+// ======================================================================
 //
 //
-// Platform Error Handling
+// DasDeque - double ended queue (ring buffer)
 //
 //
-// ===========================================================================
+// ======================================================================
 
-DasError _das_get_last_error() {
-#ifdef __linux__
-	return errno;
-#elif _WIN32
-    return GetLastError();
-#else
-#error "unimplemented virtual memory API for this platform"
-#endif
+static inline uintptr_t _DasDeque_wrapping_add(uintptr_t cap, uintptr_t idx, uintptr_t value) {
+    uintptr_t res = idx + value;
+    if (res >= cap) res = value - (cap - idx);
+    return res;
 }
 
-DasErrorStrRes das_get_error_string(DasError error, char* buf_out, uint32_t buf_out_len) {
-#if _WIN32
-	DWORD res = FormatMessage(FORMAT_MESSAGE_FROM_SYSTEM, NULL, error, 0, (LPTSTR)buf_out, buf_out_len, NULL);
-	if (res == 0) {
-		error = GetLastError();
-		das_abort("TODO handle error code: %u", error);
-	}
-#elif _GNU_SOURCE
-	// GNU version (screw these guys for changing the way this works)
-	char* buf = strerror_r(error, buf_out, buf_out_len);
-	if (strcmp(buf, "Unknown error") == 0) {
-		return DasErrorStrRes_invalid_error_arg;
-	}
+static inline uintptr_t _DasDeque_wrapping_sub(uintptr_t cap, uintptr_t idx, uintptr_t value) {
+    uintptr_t res = idx - value;
+    if (res > idx) res = cap - (value - idx);
+    return res;
+}
 
-	// if its static string then copy it to the buffer
-	if (buf != buf_out) {
-		strncpy(buf_out, buf, buf_out_len);
+DasBool _DasDeque_init_with_alctor(_DasDequeHeader** header_out, uintptr_t header_size, uintptr_t init_cap, DasAlctor alctor, uintptr_t elmt_size) {
+	// add one because the back_idx needs to point to the next empty element slot.
+	init_cap = das_max_u(DasDeque_min_cap, init_cap);
+	init_cap += 1;
 
-		uint32_t len = strlen(buf);
-		if (len < buf_out_len) {
-			return DasErrorStrRes_not_enough_space_in_buffer;
-		}
-	}
-#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	// use the XSI standard behavior.
-	int res = strerror_r(error, buf_out, buf_out_len);
-	if (res != 0) {
-		int errnum = res;
-		if (res == -1)
-			errnum = errno;
+	uintptr_t new_size = header_size + init_cap * elmt_size;
+	_DasDequeHeader* new_header = das_alloc(alctor, new_size, alignof(das_max_align_t));
+	if (!new_header) return das_false;
+	new_size = das_usable_size(alctor, new_header, new_size, alignof(das_max_align_t));
 
-		if (errnum == EINVAL) {
-			return DasErrorStrRes_invalid_error_arg;
-		} else if (errnum == ERANGE) {
-			return DasErrorStrRes_not_enough_space_in_buffer;
-		}
-		das_abort("unexpected errno: %u", errnum);
-	}
-#else
-#error "unimplemented virtual memory error string"
-#endif
-	return DasErrorStrRes_success;
-}
+	//
+	// initialize the header and pass out the new header pointer
+	new_header->cap = (new_size - header_size) / elmt_size;
+	new_header->front_idx = 0;
+	new_header->back_idx = 0;
+	new_header->alctor = alctor;
+	*header_out = new_header;
+	return das_true;
 
-// ===========================================================================
-//
-//
-// File Abstraction
-//
-//
-// ===========================================================================
+}
 
-DasError das_file_open(char* path, DasFileFlags flags, DasFileHandle* file_handle_out) {
-	das_assert(
-		(flags & (DasFileFlags_read | DasFileFlags_write | DasFileFlags_append)),
-		"DasFileFlags_{read, write or append} must be set when opening a file"
-	);
 
-	das_assert(
-		(flags & (DasFileFlags_write | DasFileFlags_append))
-			|| !(flags & (DasFileFlags_create_if_not_exist | DasFileFlags_create_new | DasFileFlags_truncate)),
-		"file must be opened with DasFileFlags_{write or append} if DasFileFlags_{create_if_not_exist, create_new or truncate} exists"
-	);
+void _DasDeque_deinit(_DasDequeHeader** header_in_out, uintptr_t header_size, uintptr_t elmt_size) {
+	_DasDequeHeader* header = *header_in_out;
+	uintptr_t size = header_size + header->cap * elmt_size;
+	das_dealloc(header->alctor, header, size, alignof(das_max_align_t));
+	*header_in_out = NULL;
+}
 
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	int fd_flags = O_CLOEXEC;
+uintptr_t _DasDeque_assert_idx(_DasDequeHeader* header, uintptr_t idx, uintptr_t elmt_size) {
+	uintptr_t count = DasDeque_count(&header);
+	das_assert(idx < count, "idx '%zu' is out of bounds for a deque of count '%zu'", idx, count);
+    idx = _DasDeque_wrapping_add(header->cap, header->front_idx, idx);
+    return idx;
+}
 
-	if (flags & DasFileFlags_create_new) {
-		fd_flags |= O_CREAT | O_EXCL;
-	} else {
-		if (flags & DasFileFlags_create_if_not_exist) {
-			fd_flags |= O_CREAT;
-		}
+DasBool _DasDeque_resize_cap(_DasDequeHeader** header_in_out, uintptr_t header_size, uintptr_t new_cap, uintptr_t elmt_size) {
+	_DasDequeHeader* header = *header_in_out;
+	uintptr_t cap = header ? header->cap : 0;
+	new_cap = das_max_u(das_max_u(DasDeque_min_cap, new_cap), DasDeque_count(header_in_out));
+	// add one because the back_idx needs to point to the next empty element slot.
+	new_cap += 1;
+	if (new_cap == cap) return das_true;
 
-		if (flags & DasFileFlags_truncate) {
-			fd_flags |= O_TRUNC;
-		}
-	}
+	DasAlctor alctor = header && header->alctor.fn != NULL ? header->alctor : DasAlctor_default;
 
-	if ((flags & DasFileFlags_read) && (flags & DasFileFlags_write)) {
-		fd_flags |= O_RDWR;
-		if (flags & DasFileFlags_append) {
-			fd_flags |= O_APPEND;
-		}
-	} else if (flags & DasFileFlags_read) {
-		fd_flags |= O_RDONLY;
-	} else if (flags & DasFileFlags_write) {
-		fd_flags |= O_WRONLY;
-		if (flags & DasFileFlags_append) {
-			fd_flags |= O_APPEND;
-		}
-	}
+	uintptr_t size = header ? header_size + cap * elmt_size : 0;
+	uintptr_t new_size = header_size + new_cap * elmt_size;
 
-	mode_t mode = 0666; // TODO allow the user to supply a mode.
-	int fd = open(path, fd_flags, mode);
-	if (fd == -1) return _das_get_last_error();
+	_DasDequeHeader* new_header;
+	if (header && new_cap > cap && das_try_expand(alctor, header, size, new_size, alignof(das_max_align_t))) {
+		//
+		// grown in place, so only the elements that wrapped around need to be moved below.
+		new_header = header;
+	} else if (header && header->front_idx > header->back_idx) {
+		//
+		// the elements wrap around, so a realloc would copy them all and then have to move the wrapped ones again.
+		// instead, copy them to a new block in order, so they start from 0 and do not wrap.
+		new_header = das_alloc(alctor, new_size, alignof(das_max_align_t));
+		if (!new_header) return das_false;
 
-	*file_handle_out = (DasFileHandle) { .raw = fd };
-#elif _WIN32
-	DWORD win_access = 0;
-	DWORD win_creation = 0;
+		uintptr_t count = DasDeque_count(header_in_out);
+		memcpy(new_header, header, header_size);
+		_DasDeque_read(header, header_size, 0, das_ptr_add(new_header, header_size), count, elmt_size);
+		das_dealloc(alctor, header, size, alignof(das_max_align_t));
 
-	if (flags & DasFileFlags_create_new) {
-		win_creation |= CREATE_NEW;
+		new_header->front_idx = 0;
+		new_header->back_idx = count;
 	} else {
-		if ((flags & DasFileFlags_create_if_not_exist) && (flags & DasFileFlags_truncate)) {
-			win_creation |= CREATE_ALWAYS;
-		} else if (flags & DasFileFlags_create_if_not_exist) {
-			win_creation |= OPEN_ALWAYS;
-		} else if (flags & DasFileFlags_truncate) {
-			win_creation |= TRUNCATE_EXISTING;
+		new_header = das_realloc(alctor, header, size, new_size, alignof(das_max_align_t));
+		if (!new_header) return das_false;
+		if (!header) {
+			new_header->alctor = alctor;
+			new_header->front_idx = 0;
+			new_header->back_idx = 0;
+			new_header->cap = 0;
 		}
 	}
 
-	if (win_creation == 0)
-		win_creation = OPEN_EXISTING;
-
-	if (flags & DasFileFlags_read) {
-		win_access |= GENERIC_READ;
-	}
+	//
+	// use any extra bytes the allocator has given us, so we do not resize as often.
+	new_size = das_usable_size(alctor, new_header, new_size, alignof(das_max_align_t));
+	new_cap = (new_size - header_size) / elmt_size;
 
-	if (flags & DasFileFlags_write) {
-		if (flags & DasFileFlags_append) {
-			win_access |= FILE_GENERIC_WRITE & ~FILE_WRITE_DATA;
-		} else {
-			win_access |= GENERIC_WRITE;
-		}
-	}
+	uintptr_t old_cap = new_header->cap;
+	new_header->cap = new_cap;
+	*header_in_out = new_header;
 
-	HANDLE handle = CreateFileA(path, win_access, 0, NULL, win_creation, FILE_ATTRIBUTE_NORMAL, 0);
-	if (handle == INVALID_HANDLE_VALUE)
-		return _das_get_last_error();
+	void* data = das_ptr_add(new_header, header_size);
 
-	*file_handle_out = (DasFileHandle) { .raw = handle };
+	// move the front_idx and back_idx around to resolve the gaps that could have been created after resizing the buffer
+	//
+    // A - no gaps created so no need to change
+    // --------
+    //   F     B        F     B
+    // [ V V V . ] -> [ V V V . . . . ]
+    //
+    // B - less elements before back_idx than elements from front_idx, so copy back_idx after the front_idx
+    //       B F                  F         B
+    // [ V V . V V V ] -> [ . . . V V V V V . . . . . ]
+    //
+    // C - more elements before back_idx than elements from front_idx, so copy front_idx to the end
+    //       B F           B           F
+    // [ V V . V] -> [ V V . . . . . . V ]
+    //
+    if (new_header->front_idx <= new_header->back_idx) { // A
+		// do nothing
+    } else if (new_header->back_idx  < old_cap - new_header->front_idx) { // B
+        memcpy(das_ptr_add(data, old_cap * elmt_size), data, new_header->back_idx * elmt_size);
+        new_header->back_idx += old_cap;
+        das_debug_assert(new_header->back_idx > new_header->front_idx, "back_idx must come after front_idx");
+    } else { // C
+        uintptr_t new_front_idx = new_cap - (old_cap - new_header->front_idx);
+        memcpy(das_ptr_add(data, new_front_idx * elmt_size), das_ptr_add(data, new_header->front_idx * elmt_size), (old_cap - new_header->front_idx) * elmt_size);
+        new_header->front_idx = new_front_idx;
+        das_debug_assert(new_header->back_idx < new_header->front_idx, "front_idx must come after back_idx");
+    }
+
+	das_debug_assert(new_header->back_idx < new_cap, "back_idx must remain in bounds");
+	das_debug_assert(new_header->front_idx < new_cap, "front_idx must remain in bounds");
+	return das_true;
+}
+
+void _DasDeque_read(_DasDequeHeader* header, uintptr_t header_size, uintptr_t idx, void* elmts_out, uintptr_t elmts_count, uintptr_t elmt_size) {
+	uintptr_t count = DasDeque_count(&header);
+	das_assert(idx + elmts_count <= count, "idx '%zu' and elmts_count '%zu' will go out of bounds for a deque of count '%zu'", idx, count);
+
+    idx = _DasDeque_wrapping_add(header->cap, header->front_idx, idx);
+
+	void* data = das_ptr_add(header, header_size);
+	if (header->cap < idx + elmts_count) {
+		//
+		// there is enough elements that the read will
+		// exceed the back and cause the idx to loop around.
+		// so copy in two parts
+		uintptr_t rem_count = header->cap - idx;
+		// copy to the end of the buffer
+		memcpy(elmts_out, das_ptr_add(data, idx * elmt_size), rem_count * elmt_size);
+		// copy to the beginning of the buffer
+		memcpy(das_ptr_add(elmts_out, rem_count * elmt_size), data, ((elmts_count - rem_count) * elmt_size));
+	} else {
+		//
+		// coping the elements can be done in a single copy
+		memcpy(elmts_out, das_ptr_add(data, idx * elmt_size), elmts_count * elmt_size);
+	}
+}
+
+void _DasDeque_write(_DasDequeHeader* header, uintptr_t header_size, uintptr_t idx, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
+	uintptr_t count = DasDeque_count(&header);
+	das_assert(idx + elmts_count <= count, "idx '%zu' and elmts_count '%zu' will go out of bounds for a deque of count '%zu'", idx, count);
+
+    idx = _DasDeque_wrapping_add(header->cap, header->front_idx, idx);
+
+	void* data = das_ptr_add(header, header_size);
+	if (header->cap < idx + elmts_count) {
+		//
+		// there is enough elements that the write will
+		// exceed the back and cause the idx to loop around.
+		// so copy in two parts
+		uintptr_t rem_count = header->cap - idx;
+		// copy to the end of the buffer
+		memcpy(das_ptr_add(data, idx * elmt_size), elmts, rem_count * elmt_size);
+		// copy to the beginning of the buffer
+		memcpy(data, das_ptr_add(elmts, rem_count * elmt_size), ((elmts_count - rem_count) * elmt_size));
+	} else {
+		//
+		// coping the elements can be done in a single copy
+		memcpy(das_ptr_add(data, idx * elmt_size), elmts, elmts_count * elmt_size);
+	}
+}
+
+uintptr_t _DasDeque_push_front_many(_DasDequeHeader** header_in_out, uintptr_t header_size, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
+	_DasDequeHeader* header = *header_in_out;
+	uintptr_t new_count = DasDeque_count(header_in_out) + elmts_count;
+	uintptr_t cap = header ? header->cap : 0;
+	if (cap < new_count + 1) {
+		DasBool res = _DasDeque_resize_cap(header_in_out, header_size, das_max_u(cap * 2, new_count), elmt_size);
+		if (!res) return UINTPTR_MAX;
+		header = *header_in_out;
+	}
+
+	header->front_idx = _DasDeque_wrapping_sub(header->cap, header->front_idx, elmts_count);
+
+	if (elmts) {
+		_DasDeque_write(header, header_size, 0, elmts, elmts_count, elmt_size);
+	}
+
+	return 0;
+}
+
+uintptr_t _DasDeque_push_back_many(_DasDequeHeader** header_in_out, uintptr_t header_size, void* elmts, uintptr_t elmts_count, uintptr_t elmt_size) {
+	_DasDequeHeader* header = *header_in_out;
+	uintptr_t insert_idx = DasDeque_count(header_in_out);
+	uintptr_t new_count = insert_idx + elmts_count;
+	uintptr_t cap = header ? header->cap : 0;
+	if (cap < new_count + 1) {
+		DasBool res = _DasDeque_resize_cap(header_in_out, header_size, das_max_u(cap * 2, new_count), elmt_size);
+		if (!res) return UINTPTR_MAX;
+		header = *header_in_out;
+	}
+
+	header->back_idx = _DasDeque_wrapping_add(header->cap, header->back_idx, elmts_count);
+
+	if (elmts) {
+		_DasDeque_write(header, header_size, insert_idx, elmts, elmts_count, elmt_size);
+	}
+
+	return insert_idx;
+}
+
+uintptr_t _DasDeque_pop_front_many(_DasDequeHeader* header, uintptr_t elmts_count, uintptr_t elmt_size) {
+    if (header->front_idx == header->back_idx) return 0;
+	elmts_count = das_min_u(elmts_count, DasDeque_count(&header));
+
+	header->front_idx = _DasDeque_wrapping_add(header->cap, header->front_idx, elmts_count);
+	return elmts_count;
+}
+
+uintptr_t _DasDeque_pop_back_many(_DasDequeHeader* header, uintptr_t elmts_count, uintptr_t elmt_size) {
+    if (header->front_idx == header->back_idx) return 0;
+	elmts_count = das_min_u(elmts_count, DasDeque_count(&header));
+
+	header->back_idx = _DasDeque_wrapping_sub(header->cap, header->back_idx, elmts_count);
+	return elmts_count;
+}
+
+// ===========================================================================
+//
+//
+// Stacktrace
+//
+//
+// ===========================================================================
+
+#ifdef __GNUC__
+#include <execinfo.h>
+#endif
+
+DasBool das_stacktrace(uint32_t ignore_levels_count, DasStk(char)* string_out) {
+#define STACKTRACE_LEVELS_MAX 128
+#if defined(__GNUC__)
+	void* stacktrace_levels[STACKTRACE_LEVELS_MAX];
+	int stacktrace_levels_count = backtrace(stacktrace_levels, STACKTRACE_LEVELS_MAX);
+
+	char** strings = backtrace_symbols(stacktrace_levels, stacktrace_levels_count);
+	if (strings == NULL) return das_false;
+
+	for (int i = ignore_levels_count; i < stacktrace_levels_count; i += 1) {
+		if (!DasStk_push_str_fmt(string_out, "%u: %s\n", stacktrace_levels_count - i - 1, strings[i])) {
+			return das_false;
+		}
+	}
+
+	free(strings);
+#elif defined(_WIN32)
+	void* stacktrace_levels[STACKTRACE_LEVELS_MAX];
+	HANDLE process = GetCurrentProcess();
+
+	SymInitialize(process, NULL, TRUE);
+
+	uint32_t stacktrace_levels_count = CaptureStackBackTrace(0, STACKTRACE_LEVELS_MAX, stacktrace_levels, NULL);
+	SYMBOL_INFO* symbol = (SYMBOL_INFO*)calloc(sizeof(SYMBOL_INFO) + 256 * sizeof(char), 1);
+	symbol->MaxNameLen   = 255;
+	symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+
+	for (uint32_t i = ignore_levels_count; i < stacktrace_levels_count; i += 1) {
+		SymFromAddr(process, (DWORD64)stacktrace_levels[i], 0, symbol);
+		if (!DasStk_push_str_fmt(string_out, "%u: %s - [0x%0X]\n", stacktrace_levels_count - i - 1, symbol->Name, symbol->Address)) {
+			return das_false;
+		}
+	}
+
+	free(symbol);
+#else
+#error "das_stacktrace has been unimplemented for this platform"
+#endif
+
+	return das_true;
+}
+
+// ===========================================================================
+//
+//
+// Platform Error Handling
+//
+//
+// ===========================================================================
+
+DasError _das_get_last_error() {
+#ifdef __linux__
+	return errno;
+#elif _WIN32
+    return GetLastError();
+#else
+#error "unimplemented virtual memory API for this platform"
+#endif
+}
+
+DasErrorStrRes das_get_error_string(DasError error, char* buf_out, uint32_t buf_out_len) {
+#if _WIN32
+	DWORD res = FormatMessage(FORMAT_MESSAGE_FROM_SYSTEM, NULL, error, 0, (LPTSTR)buf_out, buf_out_len, NULL);
+	if (res == 0) {
+		error = GetLastError();
+		das_abort("TODO handle error code: %u", error);
+	}
+#elif _GNU_SOURCE
+	// GNU version (screw these guys for changing the way this works)
+	char* buf = strerror_r(error, buf_out, buf_out_len);
+	if (strcmp(buf, "Unknown error") == 0) {
+		return DasErrorStrRes_invalid_error_arg;
+	}
+
+	// if its static string then copy it to the buffer
+	if (buf != buf_out) {
+		strncpy(buf_out, buf, buf_out_len);
+
+		uint32_t len = strlen(buf);
+		if (len < buf_out_len) {
+			return DasErrorStrRes_not_enough_space_in_buffer;
+		}
+	}
+#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	// use the XSI standard behavior.
+	int res = strerror_r(error, buf_out, buf_out_len);
+	if (res != 0) {
+		int errnum = res;
+		if (res == -1)
+			errnum = errno;
+
+		if (errnum == EINVAL) {
+			return DasErrorStrRes_invalid_error_arg;
+		} else if (errnum == ERANGE) {
+			return DasErrorStrRes_not_enough_space_in_buffer;
+		}
+		das_abort("unexpected errno: %u", errnum);
+	}
+#else
+#error "unimplemented virtual memory error string"
 #endif
+	return DasErrorStrRes_success;
+}
+
+// ===========================================================================
+//
+//
+// File Abstraction
+//
+//
+// ===========================================================================
+
+DasError das_file_open(char* path, DasFileFlags flags, DasFileHandle* file_handle_out) {
+	das_assert(
+		(flags & (DasFileFlags_read | DasFileFlags_write | DasFileFlags_append)),
+		"DasFileFlags_{read, write or append} must be set when opening a file"
+	);
+
+	das_assert(
+		(flags & (DasFileFlags_write | DasFileFlags_append))
+			|| !(flags & (DasFileFlags_create_if_not_exist | DasFileFlags_create_new | DasFileFlags_truncate)),
+		"file must be opened with DasFileFlags_{write or append} if DasFileFlags_{create_if_not_exist, create_new or truncate} exists"
+	);
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	int fd_flags = O_CLOEXEC;
+
+	if (flags & DasFileFlags_create_new) {
+		fd_flags |= O_CREAT | O_EXCL;
+	} else {
+		if (flags & DasFileFlags_create_if_not_exist) {
+			fd_flags |= O_CREAT;
+		}
+
+		if (flags & DasFileFlags_truncate) {
+			fd_flags |= O_TRUNC;
+		}
+	}
+
+	if ((flags & DasFileFlags_read) && (flags & DasFileFlags_write)) {
+		fd_flags |= O_RDWR;
+		if (flags & DasFileFlags_append) {
+			fd_flags |= O_APPEND;
+		}
+	} else if (flags & DasFileFlags_read) {
+		fd_flags |= O_RDONLY;
+	} else if (flags & DasFileFlags_write) {
+		fd_flags |= O_WRONLY;
+		if (flags & DasFileFlags_append) {
+			fd_flags |= O_APPEND;
+		}
+	}
+
+	mode_t mode = 0666; // TODO allow the user to supply a mode.
+	int fd = open(path, fd_flags, mode);
+	if (fd == -1) return _das_get_last_error();
+
+	*file_handle_out = (DasFileHandle) { .raw = fd };
+#elif _WIN32
+	DWORD win_access = 0;
+	DWORD win_creation = 0;
+
+	if (flags & DasFileFlags_create_new) {
+		win_creation |= CREATE_NEW;
+	} else {
+		if ((flags & DasFileFlags_create_if_not_exist) && (flags & DasFileFlags_truncate)) {
+			win_creation |= CREATE_ALWAYS;
+		} else if (flags & DasFileFlags_create_if_not_exist) {
+			win_creation |= OPEN_ALWAYS;
+		} else if (flags & DasFileFlags_truncate) {
+			win_creation |= TRUNCATE_EXISTING;
+		}
+	}
+
+	if (win_creation == 0)
+		win_creation = OPEN_EXISTING;
+
+	if (flags & DasFileFlags_read) {
+		win_access |= GENERIC_READ;
+	}
+
+	if (flags & DasFileFlags_write) {
+		if (flags & DasFileFlags_append) {
+			win_access |= FILE_GENERIC_WRITE & ~FILE_WRITE_DATA;
+		} else {
+			win_access |= GENERIC_WRITE;
+		}
+	}
+
+	HANDLE handle = CreateFileA(path, win_access, 0, NULL, win_creation, FILE_ATTRIBUTE_NORMAL, 0);
+	if (handle == INVALID_HANDLE_VALUE)
+		return _das_get_last_error();
+
+	*file_handle_out = (DasFileHandle) { .raw = handle };
+#endif
+
+	return DasError_success;
+}
+
+DasError das_file_close(DasFileHandle handle) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	if (close(handle.raw) != 0)
+		return _das_get_last_error();
+#elif _WIN32
+	if (CloseHandle(handle.raw) == 0)
+		return _das_get_last_error();
+#else
+#error "unimplemented file API for this platform"
+#endif
+
+	return DasError_success;
+}
+
+DasError das_file_size(DasFileHandle handle, uint64_t* size_out) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	// get the size of the file
+	struct stat s = {0};
+	if (fstat(handle.raw, &s) != 0) return _das_get_last_error();
+	*size_out = s.st_size;
+#elif _WIN32
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(handle.raw, &size)) return _das_get_last_error();
+	*size_out = size.QuadPart;
+#else
+#error "unimplemented file API for this platform"
+#endif
+	return DasError_success;
+}
+
+DasError das_file_read(DasFileHandle handle, void* data_out, uintptr_t length, uintptr_t* bytes_read_out) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	ssize_t bytes_read = read(handle.raw, data_out, length);
+	if (bytes_read == (ssize_t)-1)
+		return _das_get_last_error();
+#elif _WIN32
+	length = das_min_u(length, UINT32_MAX);
+	DWORD bytes_read;
+	if (ReadFile(handle.raw, data_out, length, &bytes_read, NULL) == 0)
+		return _das_get_last_error();
+#else
+#error "unimplemented file API for this platform"
+#endif
+
+	*bytes_read_out = bytes_read;
+	return DasError_success;
+}
+
+DasError das_file_read_exact(DasFileHandle handle, void* data_out, uintptr_t length, uintptr_t* bytes_read_out) {
+	uintptr_t og_length = length;
+	while (length) {
+		uintptr_t bytes_read;
+		DasError error = das_file_read(handle, data_out, length, &bytes_read);
+		if (error) return error;
+
+		if (bytes_read == 0)
+			break;
+
+		data_out = das_ptr_add(data_out, bytes_read);
+		length -= bytes_read;
+	}
+
+	*bytes_read_out = og_length - length;
+	return DasError_success;
+}
+
+DasError das_file_write(DasFileHandle handle, void* data, uintptr_t length, uintptr_t* bytes_written_out) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	ssize_t bytes_written = write(handle.raw, data, length);
+	if (bytes_written == (ssize_t)-1)
+		return _das_get_last_error();
+#elif _WIN32
+	length = das_min_u(length, UINT32_MAX);
+	DWORD bytes_written;
+	if (WriteFile(handle.raw, data, length, &bytes_written, NULL) == 0)
+		return _das_get_last_error();
+#else
+#error "unimplemented file API for this platform"
+#endif
+
+	*bytes_written_out = bytes_written;
+	return DasError_success;
+}
+
+DasError das_file_write_exact(DasFileHandle handle, void* data, uintptr_t length, uintptr_t* bytes_written_out) {
+	uintptr_t og_length = length;
+	while (length) {
+		uintptr_t bytes_written;
+		DasError error = das_file_write(handle, data, length, &bytes_written);
+		if (error) return error;
+
+		if (bytes_written == 0)
+			break;
+
+		data = das_ptr_add(data, bytes_written);
+		length -= bytes_written;
+	}
+
+	*bytes_written_out = og_length - length;
+	return DasError_success;
+}
+
+DasError das_file_seek(DasFileHandle handle, int64_t offset, DasFileSeekFrom from, uint64_t* cursor_offset_out) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	int whence = 0;
+	switch (from) {
+		case DasFileSeekFrom_start: whence = SEEK_SET; break;
+		case DasFileSeekFrom_current: whence = SEEK_CUR; break;
+		case DasFileSeekFrom_end: whence = SEEK_END; break;
+	}
+	off_t cursor_offset = lseek(handle.raw, offset, whence);
+	if (cursor_offset == (off_t)-1)
+		return _das_get_last_error();
+	*cursor_offset_out = cursor_offset;
+#elif _WIN32
+	int move_method = 0;
+	switch (from) {
+		case DasFileSeekFrom_start: move_method = FILE_BEGIN; break;
+		case DasFileSeekFrom_current: move_method = FILE_CURRENT; break;
+		case DasFileSeekFrom_end: move_method = FILE_END; break;
+	}
+	LARGE_INTEGER distance_to_move;
+	distance_to_move.QuadPart = offset;
+	LARGE_INTEGER new_offset = {0};
+
+	if (!SetFilePointerEx(handle.raw, distance_to_move, &new_offset, move_method))
+		return _das_get_last_error();
+
+	*cursor_offset_out = new_offset.QuadPart;
+#else
+#error "unimplemented file API for this platform"
+#endif
+	return DasError_success;
+}
+
+DasError das_file_flush(DasFileHandle handle) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	if (fsync(handle.raw) != 0)
+		return _das_get_last_error();
+#elif _WIN32
+	if (FlushFileBuffers(handle.raw) == 0)
+		return _das_get_last_error();
+#else
+#error "unimplemented file API for this platform"
+#endif
+	return DasError_success;
+}
+
+// ===========================================================================
+//
+//
+// Trace Allocator
+//
+//
+// ===========================================================================
+
+static uint64_t _das_trace_timestamp_ns(void) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#elif _WIN32
+	static LARGE_INTEGER frequency;
+	if (frequency.QuadPart == 0) {
+		QueryPerformanceFrequency(&frequency);
+	}
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	uint64_t seconds = counter.QuadPart / frequency.QuadPart;
+	uint64_t remainder = counter.QuadPart % frequency.QuadPart;
+	return seconds * 1000000000 + remainder * 1000000000 / frequency.QuadPart;
+#else
+#error "unimplemented monotonic clock for this platform"
+#endif
+}
+
+//
+// the mutex that the trace allocators write their files under.
+// this is a mutex that puts the waiting threads to sleep, as a write to a file can take a long time.
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+static pthread_mutex_t _das_trace_file_mutex = PTHREAD_MUTEX_INITIALIZER;
+#elif _WIN32
+static SRWLOCK _das_trace_file_mutex = SRWLOCK_INIT;
+#endif
+
+static void _das_trace_file_lock(void) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	pthread_mutex_lock(&_das_trace_file_mutex);
+#elif _WIN32
+	AcquireSRWLockExclusive(&_das_trace_file_mutex);
+#endif
+}
+
+static void _das_trace_file_unlock(void) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	pthread_mutex_unlock(&_das_trace_file_mutex);
+#elif _WIN32
+	ReleaseSRWLockExclusive(&_das_trace_file_mutex);
+#endif
+}
+
+//
+// writes @param(size) bytes to the file and turns a short write into an error.
+static DasError _das_trace_file_write(DasFileHandle file_handle, void* data, uintptr_t size) {
+	uintptr_t bytes_written;
+	DasError error = das_file_write_exact(file_handle, data, size, &bytes_written);
+	if (!error && bytes_written != size) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+		error = EIO;
+#elif _WIN32
+		error = ERROR_WRITE_FAULT;
+#endif
+	}
+	return error;
+}
+
+//
+// writes @param(events_count) events to the file. the slot lock must not be held by the caller.
+static DasError _DasTraceAlctor_write_events(DasTraceAlctor* alctor, DasTraceEvent* events, uint32_t events_count) {
+	if (events_count == 0)
+		return DasError_success;
+
+	_das_trace_file_lock();
+	DasError error = _das_trace_file_write(alctor->file_handle, events, (uintptr_t)events_count * sizeof(DasTraceEvent));
+	_das_trace_file_unlock();
+	return error;
+}
+
+DasError DasTraceAlctor_init(DasTraceAlctor* alctor, DasAlctor inner, char* path) {
+	das_zero_elmt(alctor);
+	alctor->inner = inner;
+
+	DasError error = das_file_open(path, DasFileFlags_write | DasFileFlags_create_if_not_exist | DasFileFlags_truncate, &alctor->file_handle);
+	if (error) return error;
+
+	DasTraceHeader header = {0};
+	memcpy(header.magic, DasTraceHeader_magic, sizeof(header.magic));
+	header.version = DasTraceHeader_version;
+	header.event_size = sizeof(DasTraceEvent);
+	error = _das_trace_file_write(alctor->file_handle, &header, sizeof(header));
+	if (error) {
+		das_file_close(alctor->file_handle);
+		return error;
+	}
+
+	//
+	// the buffers come from the system allocator and not the inner allocator, so they do not show up in the trace.
+	// each slot has two buffers, so one can be filled while the other is written to the file.
+	uintptr_t events_size = (uintptr_t)DasTraceAlctor_slots_count * DasTraceAlctor_slot_events_cap * 2 * sizeof(DasTraceEvent);
+	alctor->events = das_system_alloc_fn(NULL, NULL, 0, events_size, alignof(DasTraceEvent));
+	for (uint32_t slot_idx = 0; slot_idx < DasTraceAlctor_slots_count; slot_idx += 1) {
+		alctor->slots[slot_idx].events = &alctor->events[slot_idx * 2 * DasTraceAlctor_slot_events_cap];
+		alctor->slots[slot_idx].spare_events = &alctor->events[(slot_idx * 2 + 1) * DasTraceAlctor_slot_events_cap];
+	}
+	return DasError_success;
+}
+
+DasError DasTraceAlctor_flush(DasTraceAlctor* alctor) {
+	for (uint32_t slot_idx = 0; slot_idx < DasTraceAlctor_slots_count; slot_idx += 1) {
+		//
+		// no other thread is using the allocator, so the events can be written without holding the slot lock.
+		_DasTraceAlctorSlot* slot = &alctor->slots[slot_idx];
+		das_spin_lock(&slot->lock);
+		uint32_t events_count = slot->events_count;
+		slot->events_count = 0;
+		das_spin_unlock(&slot->lock);
+
+		DasError error = _DasTraceAlctor_write_events(alctor, slot->events, events_count);
+		if (error) return error;
+	}
+
+	return (DasError)alctor->write_error;
+}
+
+DasError DasTraceAlctor_deinit(DasTraceAlctor* alctor) {
+	DasError error = DasTraceAlctor_flush(alctor);
+	DasError close_error = das_file_close(alctor->file_handle);
+	if (!error) error = close_error;
+
+	uintptr_t events_size = (uintptr_t)DasTraceAlctor_slots_count * DasTraceAlctor_slot_events_cap * 2 * sizeof(DasTraceEvent);
+	das_system_alloc_fn(NULL, alctor->events, events_size, 0, alignof(DasTraceEvent));
+	das_zero_elmt(alctor);
+	return error;
+}
+
+//
+// adds an event for a call to the DasAllocFn with the arguments and the pointer that it returned.
+static void _DasTraceAlctor_record(DasTraceAlctor* alctor, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align, void* new_ptr) {
+	DasTraceOp op;
+	if (!ptr && size == 0) {
+		op = DasTraceOp_reset;
+	} else if (!ptr) {
+		op = DasTraceOp_alloc;
+	} else if (ptr && size > 0) {
+		op = DasTraceOp_realloc;
+	} else {
+		op = DasTraceOp_dealloc;
+	}
+
+	uint32_t thread_idx = das_thread_idx();
+	_DasTraceAlctorSlot* slot = &alctor->slots[thread_idx % DasTraceAlctor_slots_count];
+	das_spin_lock(&slot->lock);
+	while (slot->events_count == DasTraceAlctor_slot_events_cap) {
+		if (slot->spare_events) {
+			//
+			// swap in the spare buffer and write the full one to the file after we unlock,
+			// so the other threads on this slot can carry on while the file is being written.
+			DasTraceEvent* full_events = slot->events;
+			slot->events = slot->spare_events;
+			slot->spare_events = NULL;
+			slot->events_count = 0;
+			das_spin_unlock(&slot->lock);
+
+			//
+			// we cannot return the error from here, so keep the first one for DasTraceAlctor_flush to return.
+			DasError error = _DasTraceAlctor_write_events(alctor, full_events, DasTraceAlctor_slot_events_cap);
+			if (error) das_atomic_cas_u(&alctor->write_error, 0, (uintptr_t)error);
+
+			das_spin_lock(&slot->lock);
+			slot->spare_events = full_events;
+		} else {
+			//
+			// both buffers are full and the other one is still being written to the file.
+			// wait on the file mutex, so we sleep until that write is done instead of spinning.
+			das_spin_unlock(&slot->lock);
+			_das_trace_file_lock();
+			_das_trace_file_unlock();
+			das_cpu_relax();
+			das_spin_lock(&slot->lock);
+		}
+	}
+
+	DasTraceEvent* event = &slot->events[slot->events_count];
+	event->timestamp_ns = _das_trace_timestamp_ns();
+	event->ptr = (uint64_t)(uintptr_t)ptr;
+	event->new_ptr = (uint64_t)(uintptr_t)new_ptr;
+	event->old_size = old_size;
+	event->size = size;
+	event->thread_idx = thread_idx;
+	event->op = op;
+	event->align_log2 = align ? das_most_set_bit_idx(align) : 0;
+	event->_reserved = 0;
+	slot->events_count += 1;
+	das_spin_unlock(&slot->lock);
+}
+
+void* DasTraceAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasTraceAlctor* alctor = (DasTraceAlctor*)alctor_data;
+	void* new_ptr = alctor->inner.fn(alctor->inner.data, ptr, old_size, size, align);
+	_DasTraceAlctor_record(alctor, ptr, old_size, size, align, new_ptr);
+	return new_ptr;
+}
+
+DasBool DasTraceAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasTraceAlctor* alctor = (DasTraceAlctor*)alctor_data;
+	void* ptr = args->ptr;
+	uintptr_t old_size = args->old_size;
+	if (!_DasAlctor_ext(alctor->inner, op, args))
+		return das_false;
+
+	//
+	// the extended operations are written as the DasAllocFn calls they replace,
+	// so the trace can be replayed without knowing about them.
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+		case DasAllocExtOp_usable_size:
+			// the allocation now has the new size, without moving.
+			if (args->size != old_size) {
+				_DasTraceAlctor_record(alctor, ptr, old_size, args->size, args->align, ptr);
+			}
+			break;
+		case DasAllocExtOp_alloc_batch:
+			if (args->count == 0) {
+				_DasTraceAlctor_record(alctor, NULL, 0, args->size, args->align, NULL);
+			}
+			for (uintptr_t i = 0; i < args->count; i += 1) {
+				_DasTraceAlctor_record(alctor, NULL, 0, args->size, args->align, args->ptrs[i]);
+			}
+			break;
+		case DasAllocExtOp_dealloc_batch:
+			for (uintptr_t i = 0; i < args->count; i += 1) {
+				_DasTraceAlctor_record(alctor, args->ptrs[i], args->old_size, 0, args->align, NULL);
+			}
+			break;
+		case DasAllocExtOp_alloc_zeroed:
+		case DasAllocExtOp_realloc_zeroed:
+			_DasTraceAlctor_record(alctor, ptr, old_size, args->size, args->align, args->ptr);
+			break;
+		case DasAllocExtOp_owns:
+			break;
+	}
+
+	return das_true;
+}
+
+// ===========================================================================
+//
+//
+// Guard Allocator
+//
+//
+// ===========================================================================
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#include <signal.h>
+#endif
+
+static DasGuardAlctor* _das_guard_alctors_head;
+static DasSpinLock _das_guard_alctors_lock;
+static DasBool _das_guard_fault_handler_is_installed;
+
+// the number of allocations left until the next one is sampled.
+static das_thread_local uint32_t _das_guard_countdown;
+static das_thread_local uint32_t _das_guard_rng_state;
+
+//
+// returns das_true if this allocation should be put in a guarded slot.
+// the gap between samples is random so allocation patterns that repeat do not always miss the same allocation.
+static DasBool _das_guard_should_sample(uint32_t sample_rate) {
+	if (_das_guard_countdown == 0) {
+		if (_das_guard_rng_state == 0) {
+			_das_guard_rng_state = (das_thread_idx() + 1) * 2654435761u;
+		}
+
+		// xorshift32
+		uint32_t x = _das_guard_rng_state;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		_das_guard_rng_state = x;
+
+		// picks from 1 to (sample_rate * 2 - 1) so on average, it is the sample_rate.
+		sample_rate = das_max_u(sample_rate, 1);
+		_das_guard_countdown = 1 + x % (sample_rate * 2 - 1);
+	}
+
+	_das_guard_countdown -= 1;
+	return _das_guard_countdown == 0;
+}
+
+static inline void* _DasGuardAlctor_slot_page(DasGuardAlctor* alctor, uint32_t slot_idx) {
+	return das_ptr_add(alctor->address_space, ((uintptr_t)slot_idx * 2 + 1) * alctor->page_size);
+}
+
+static inline DasBool _DasGuardAlctor_owns(DasGuardAlctor* alctor, void* ptr) {
+	return ptr >= alctor->address_space && ptr < das_ptr_add(alctor->address_space, alctor->reserved_size);
+}
+
+//
+// the fault report is built with these instead of printf, as it is written from a signal handler on POSIX
+// and only async signal safe functions can be called there. anything past the end of the buffer is dropped.
+typedef struct {
+	char data[512];
+	uint32_t count;
+} _DasGuardReport;
+
+static void _das_guard_report_str(_DasGuardReport* report, const char* str) {
+	while (*str && report->count < sizeof(report->data)) {
+		report->data[report->count] = *str;
+		report->count += 1;
+		str += 1;
+	}
+}
+
+static void _das_guard_report_uint(_DasGuardReport* report, uintptr_t value, uint32_t base) {
+	char digits[sizeof(uintptr_t) * 8 + 1];
+	uint32_t idx = sizeof(digits) - 1;
+	digits[idx] = '\0';
+	do {
+		idx -= 1;
+		digits[idx] = "0123456789abcdef"[value % base];
+		value /= base;
+	} while (value);
+
+	if (base == 16) _das_guard_report_str(report, "0x");
+	_das_guard_report_str(report, &digits[idx]);
+}
+
+//
+// prints a report to stderr if @param(fault_addr) is in one of the guard allocators.
+// returns das_true if it was.
+static DasBool _das_guard_report_fault(void* fault_addr) {
+	for (DasGuardAlctor* alctor = das_atomic_load_ptr((void**)&_das_guard_alctors_head); alctor; alctor = alctor->next_registered) {
+		if (!_DasGuardAlctor_owns(alctor, fault_addr))
+			continue;
+
+		char* kind;
+		_DasGuardSlot* slot = NULL;
+		uintptr_t page_idx = das_ptr_diff(fault_addr, alctor->address_space) / alctor->page_size;
+		if (page_idx % 2 == 1) {
+			kind = "use after free";
+			slot = &alctor->slots[page_idx / 2];
+		} else {
+			//
+			// it is a guard page, allocations are at the end of the slot's page
+			// so it is most likely an overflow of the slot before the guard page.
+			uint32_t slot_idx = page_idx / 2;
+			if (slot_idx > 0 && alctor->slots[slot_idx - 1].is_allocated) {
+				kind = "heap buffer overflow";
+				slot = &alctor->slots[slot_idx - 1];
+			} else if (slot_idx < alctor->slots_count && alctor->slots[slot_idx].is_allocated) {
+				kind = "heap buffer underflow";
+				slot = &alctor->slots[slot_idx];
+			} else {
+				kind = "out of bounds access next to a freed allocation";
+			}
+		}
+
+		//
+		// the buffer is on the stack, so threads that fault at the same time do not write over each other's report.
+		_DasGuardReport report;
+		report.count = 0;
+		_das_guard_report_str(&report, "DasGuardAlctor: ");
+		_das_guard_report_str(&report, kind);
+		_das_guard_report_str(&report, " at address ");
+		_das_guard_report_uint(&report, (uintptr_t)fault_addr, 16);
+		_das_guard_report_str(&report, "\n");
+		if (slot && slot->ptr) {
+			_das_guard_report_str(&report, "the ");
+			_das_guard_report_str(&report, slot->is_allocated ? "live" : "freed");
+			_das_guard_report_str(&report, " allocation is ");
+			_das_guard_report_uint(&report, slot->size, 10);
+			_das_guard_report_str(&report, " bytes at ");
+			_das_guard_report_uint(&report, (uintptr_t)slot->ptr, 16);
+			_das_guard_report_str(&report, " and was made on thread ");
+			_das_guard_report_uint(&report, slot->thread_idx, 10);
+			_das_guard_report_str(&report, "\n");
+		}
+		_das_guard_report_str(&report, "stacktrace:\n");
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+		//
+		// backtrace_symbols_fd writes straight to the file without allocating, unlike das_stacktrace.
+		if (write(STDERR_FILENO, report.data, report.count) < 0) {
+			// there is nowhere else to report this, so carry on and try the stacktrace.
+		}
+		void* stacktrace_levels[64];
+		int stacktrace_levels_count = backtrace(stacktrace_levels, 64);
+		backtrace_symbols_fd(stacktrace_levels, stacktrace_levels_count, STDERR_FILENO);
+#elif _WIN32
+		//
+		// this runs in a vectored exception handler and not a signal handler, so das_stacktrace is fine here.
+		fwrite(report.data, 1, report.count, stderr);
+		DasStk(char) stacktrace = NULL;
+		if (das_stacktrace(0, &stacktrace)) {
+			fwrite(DasStk_data(&stacktrace), 1, DasStk_count(&stacktrace), stderr);
+		}
+		DasStk_deinit(&stacktrace);
+		fflush(stderr);
+#endif
+		return das_true;
+	}
+	return das_false;
+}
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+static struct sigaction _das_guard_prev_sigsegv_action;
+static struct sigaction _das_guard_prev_sigbus_action;
+
+static void _das_guard_signal_handler(int signal, siginfo_t* info, void* ucontext) {
+	_das_guard_report_fault(info->si_addr);
+
+	//
+	// pass the fault on to the handler that was installed before ours.
+	// our handler stays installed, so faults outside of the guard allocators do not stop us from catching the next one.
+	struct sigaction* prev_action = signal == SIGSEGV ? &_das_guard_prev_sigsegv_action : &_das_guard_prev_sigbus_action;
+	if (prev_action->sa_flags & SA_SIGINFO) {
+		prev_action->sa_sigaction(signal, info, ucontext);
+	} else if (prev_action->sa_handler != SIG_DFL && prev_action->sa_handler != SIG_IGN) {
+		prev_action->sa_handler(signal);
+	} else {
+		//
+		// there is no previous handler, so put back the default action and return.
+		// the faulting instruction will run again and crash the program.
+		// ignoring the signal would just fault forever, so that is treated the same.
+		struct sigaction action = {0};
+		action.sa_handler = SIG_DFL;
+		sigemptyset(&action.sa_mask);
+		sigaction(signal, &action, NULL);
+	}
+}
+
+static void _das_guard_install_fault_handler(void) {
+	//
+	// the first call to backtrace can load libgcc and allocate, so get that out of the way before it is needed in the signal handler.
+	void* stacktrace_level;
+	backtrace(&stacktrace_level, 1);
+
+	struct sigaction action = {0};
+	action.sa_sigaction = _das_guard_signal_handler;
+	action.sa_flags = SA_SIGINFO;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGSEGV, &action, &_das_guard_prev_sigsegv_action);
+	// macOS uses SIGBUS for accessing protected memory
+	sigaction(SIGBUS, &action, &_das_guard_prev_sigbus_action);
+}
+
+static void _das_guard_uninstall_fault_handler(void) {
+	sigaction(SIGSEGV, &_das_guard_prev_sigsegv_action, NULL);
+	sigaction(SIGBUS, &_das_guard_prev_sigbus_action, NULL);
+}
+#elif _WIN32
+static void* _das_guard_exception_handler_handle;
+
+static LONG WINAPI _das_guard_exception_handler(EXCEPTION_POINTERS* info) {
+	if (info->ExceptionRecord->ExceptionCode == EXCEPTION_ACCESS_VIOLATION) {
+		_das_guard_report_fault((void*)info->ExceptionRecord->ExceptionInformation[1]);
+	}
+	return EXCEPTION_CONTINUE_SEARCH;
+}
+
+static void _das_guard_install_fault_handler(void) {
+	_das_guard_exception_handler_handle = AddVectoredExceptionHandler(1, _das_guard_exception_handler);
+}
+
+static void _das_guard_uninstall_fault_handler(void) {
+	RemoveVectoredExceptionHandler(_das_guard_exception_handler_handle);
+	_das_guard_exception_handler_handle = NULL;
+}
+#else
+#error "unimplemented guard allocator fault handler for this platform"
+#endif
+
+DasError DasGuardAlctor_init(DasGuardAlctor* alctor, DasAlctor inner, uint32_t slots_count, uint32_t sample_rate) {
+	das_zero_elmt(alctor);
+	das_assert(slots_count > 0, "the guard allocator needs atleast a single slot");
+
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
+
+	//
+	// every slot has a guard page before it and there is one more guard page at the end.
+	uintptr_t reserved_size = das_round_up_nearest_multiple_u(((uintptr_t)slots_count * 2 + 1) * page_size, reserve_align);
+	error = das_virt_mem_reserve(NULL, reserved_size, &alctor->address_space);
+	if (error) return error;
+
+	//
+	// the slot metadata comes from the system allocator, so it is not near the slots that can be overflowed.
+	alctor->slots = das_system_alloc_fn(NULL, NULL, 0, (uintptr_t)slots_count * sizeof(_DasGuardSlot), alignof(_DasGuardSlot));
+	memset(alctor->slots, 0, (uintptr_t)slots_count * sizeof(_DasGuardSlot));
+	for (uint32_t i = 0; i < slots_count; i += 1) {
+		alctor->slots[i].next_free_id = i + 2;
+	}
+	alctor->slots[slots_count - 1].next_free_id = 0;
+
+	alctor->inner = inner;
+	alctor->reserved_size = reserved_size;
+	alctor->page_size = page_size;
+	alctor->slots_count = slots_count;
+	alctor->sample_rate = sample_rate;
+	alctor->free_slot_head_id = 1;
+	alctor->free_slot_tail_id = slots_count;
+
+	das_spin_lock(&_das_guard_alctors_lock);
+	alctor->next_registered = _das_guard_alctors_head;
+	das_atomic_store_ptr((void**)&_das_guard_alctors_head, alctor);
+	if (!_das_guard_fault_handler_is_installed) {
+		_das_guard_install_fault_handler();
+		_das_guard_fault_handler_is_installed = das_true;
+	}
+	das_spin_unlock(&_das_guard_alctors_lock);
+
+	return DasError_success;
+}
+
+DasError DasGuardAlctor_deinit(DasGuardAlctor* alctor) {
+	das_spin_lock(&_das_guard_alctors_lock);
+	DasGuardAlctor** link = &_das_guard_alctors_head;
+	while (*link != alctor) {
+		link = &(*link)->next_registered;
+	}
+	das_atomic_store_ptr((void**)link, alctor->next_registered);
+
+	//
+	// the last guard allocator is gone, so give the faults back to the handler that was installed before ours.
+	if (_das_guard_alctors_head == NULL && _das_guard_fault_handler_is_installed) {
+		_das_guard_uninstall_fault_handler();
+		_das_guard_fault_handler_is_installed = das_false;
+	}
+	das_spin_unlock(&_das_guard_alctors_lock);
+
+	DasError error = das_virt_mem_release(alctor->address_space, alctor->reserved_size);
+	if (error) return error;
+
+	das_system_alloc_fn(NULL, alctor->slots, (uintptr_t)alctor->slots_count * sizeof(_DasGuardSlot), 0, alignof(_DasGuardSlot));
+	das_zero_elmt(alctor);
+	return DasError_success;
+}
+
+//
+// puts the allocation in a free slot, returns NULL if all of the slots are in use.
+static void* _DasGuardAlctor_slot_alloc(DasGuardAlctor* alctor, uintptr_t size) {
+	das_spin_lock(&alctor->lock);
+	uint32_t slot_id = alctor->free_slot_head_id;
+	if (slot_id) {
+		alctor->free_slot_head_id = alctor->slots[slot_id - 1].next_free_id;
+		if (alctor->free_slot_head_id == 0) alctor->free_slot_tail_id = 0;
+	}
+	das_spin_unlock(&alctor->lock);
+	if (!slot_id) return NULL;
+
+	void* page = _DasGuardAlctor_slot_page(alctor, slot_id - 1);
+	DasError error = das_virt_mem_commit(page, alctor->page_size, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+
+	//
+	// put the allocation at the end of the page so an overflow goes straight into the next guard page.
+	void* ptr = das_ptr_add(page, alctor->page_size - das_round_up_nearest_multiple_u(size, das_guard_alctor_min_align));
+	_DasGuardSlot* slot = &alctor->slots[slot_id - 1];
+	slot->ptr = ptr;
+	slot->size = size;
+	slot->next_free_id = 0;
+	slot->thread_idx = das_thread_idx();
+	slot->is_allocated = das_true;
+	return ptr;
+}
+
+static void _DasGuardAlctor_slot_dealloc(DasGuardAlctor* alctor, void* ptr) {
+	uint32_t slot_idx = das_ptr_diff(ptr, alctor->address_space) / alctor->page_size / 2;
+	_DasGuardSlot* slot = &alctor->slots[slot_idx];
+	das_assert(slot->is_allocated && slot->ptr == ptr, "DasGuardAlctor: double free or invalid free of %p", ptr);
+	slot->is_allocated = das_false;
+
+	//
+	// decommit the page so any use after free will fault.
+	DasError error = das_virt_mem_decommit(_DasGuardAlctor_slot_page(alctor, slot_idx), alctor->page_size);
+	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+
+	//
+	// put it at the end of the free list so it is the last slot to be reused.
+	das_spin_lock(&alctor->lock);
+	if (alctor->free_slot_tail_id) {
+		alctor->slots[alctor->free_slot_tail_id - 1].next_free_id = slot_idx + 1;
+	} else {
+		alctor->free_slot_head_id = slot_idx + 1;
+	}
+	alctor->free_slot_tail_id = slot_idx + 1;
+	das_spin_unlock(&alctor->lock);
+}
+
+void* DasGuardAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasGuardAlctor* alctor = (DasGuardAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset
+		return alctor->inner.fn(alctor->inner.data, ptr, old_size, size, align);
+	} else if (!ptr) {
+		// allocate
+		if (size <= alctor->page_size && align <= das_guard_alctor_min_align && _das_guard_should_sample(alctor->sample_rate)) {
+			void* new_ptr = _DasGuardAlctor_slot_alloc(alctor, size);
+			if (new_ptr) return new_ptr;
+		}
+
+		return alctor->inner.fn(alctor->inner.data, ptr, old_size, size, align);
+	} else if (ptr && size > 0) {
+		// reallocate
+		if (!_DasGuardAlctor_owns(alctor, ptr)) {
+			return alctor->inner.fn(alctor->inner.data, ptr, old_size, size, align);
+		}
+
+		//
+		// always move, so the new size is right up against the guard page.
+		void* new_ptr = DasGuardAlctor_alloc_fn(alctor, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		_DasGuardAlctor_slot_dealloc(alctor, ptr);
+		return new_ptr;
+	} else {
+		// deallocate
+		if (!_DasGuardAlctor_owns(alctor, ptr)) {
+			return alctor->inner.fn(alctor->inner.data, ptr, old_size, size, align);
+		}
+
+		_DasGuardAlctor_slot_dealloc(alctor, ptr);
+		return NULL;
+	}
+
+	return NULL;
+}
+
+DasBool DasGuardAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasGuardAlctor* alctor = (DasGuardAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+		case DasAllocExtOp_usable_size:
+		case DasAllocExtOp_realloc_zeroed:
+			//
+			// a guarded allocation has to stay right up against the guard page, so it is not resized in place.
+			if (_DasGuardAlctor_owns(alctor, args->ptr)) return das_false;
+			break;
+		case DasAllocExtOp_alloc_batch:
+		case DasAllocExtOp_alloc_zeroed:
+			//
+			// allocations that could be sampled go through DasGuardAlctor_alloc_fn one at a time.
+			if (args->size <= alctor->page_size && args->align <= das_guard_alctor_min_align) return das_false;
+			break;
+		case DasAllocExtOp_dealloc_batch:
+			for (uintptr_t i = 0; i < args->count; i += 1) {
+				if (_DasGuardAlctor_owns(alctor, args->ptrs[i])) return das_false;
+			}
+			break;
+		case DasAllocExtOp_owns:
+			args->count = _DasGuardAlctor_owns(alctor, args->ptr);
+			return _DasAlctor_owns_or(alctor->inner, args->ptr, &args->count);
+	}
+
+	return _DasAlctor_ext(alctor->inner, op, args);
+}
+
+// ===========================================================================
+//
+//
+// Virtual Memory Abstraction
+//
+//
+// ===========================================================================
+
+#ifdef __linux__
+// these are not defined when compiling with a strict C standard.
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+#ifndef MADV_HUGEPAGE
+#define MADV_HUGEPAGE 14
+#endif
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+// from linux/mempolicy.h, which is not included by the C library headers.
+#define _DAS_MPOL_PREFERRED 1
+#endif
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+static int _das_virt_mem_prot_unix(DasVirtMemProtection prot) {
+	switch (prot) {
+		case DasVirtMemProtection_no_access: return 0;
+		case DasVirtMemProtection_read: return PROT_READ;
+		case DasVirtMemProtection_read_write: return PROT_READ | PROT_WRITE;
+		case DasVirtMemProtection_exec_read: return PROT_EXEC | PROT_READ;
+		case DasVirtMemProtection_exec_read_write: return PROT_READ | PROT_WRITE | PROT_EXEC;
+	}
+	return 0;
+}
+#elif _WIN32
+static DWORD _das_virt_mem_prot_windows(DasVirtMemProtection prot) {
+	switch (prot) {
+		case DasVirtMemProtection_no_access: return PAGE_NOACCESS;
+		case DasVirtMemProtection_read: return PAGE_READONLY;
+		case DasVirtMemProtection_read_write: return PAGE_READWRITE;
+		case DasVirtMemProtection_exec_read: return PAGE_EXECUTE_READ;
+		case DasVirtMemProtection_exec_read_write: return PAGE_EXECUTE_READWRITE;
+	}
+	return 0;
+}
+#else
+#error "unimplemented virtual memory API for this platform"
+#endif
+
+DasError das_virt_mem_page_size(uintptr_t* page_size_out, uintptr_t* reserve_align_out) {
+#ifdef __linux__
+	long page_size = sysconf(_SC_PAGESIZE);
+	if (page_size ==  (long)-1)
+		return _das_get_last_error();
+
+	*page_size_out = page_size;
+	*reserve_align_out = page_size;
+#elif _WIN32
+	SYSTEM_INFO si;
+    GetNativeSystemInfo(&si);
+	*page_size_out = si.dwPageSize;
+	*reserve_align_out = si.dwAllocationGranularity;
+#else
+#error "unimplemented virtual memory API for this platform"
+#endif
+
+	return DasError_success;
+}
+
+DasError das_virt_mem_huge_page_size(uintptr_t* huge_page_size_out) {
+	// assume the common 2MBs if the OS does not tell us.
+	uintptr_t huge_page_size = 2 * 1024 * 1024;
+#ifdef __linux__
+	int fd = open("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", O_RDONLY);
+	if (fd != -1) {
+		char buf[32];
+		ssize_t read_size = read(fd, buf, sizeof(buf) - 1);
+		close(fd);
+		if (read_size > 0) {
+			buf[read_size] = '\0';
+			uintptr_t size = strtoull(buf, NULL, 10);
+			if (size) huge_page_size = size;
+		}
+	}
+#elif _WIN32
+	uintptr_t size = GetLargePageMinimum();
+	if (size) huge_page_size = size;
+#endif
+
+	*huge_page_size_out = huge_page_size;
+	return DasError_success;
+}
+
+DasError das_virt_mem_huge_page_size_with_flags(DasVirtMemFlags flags, uintptr_t* huge_page_size_out) {
+#ifdef __linux__
+	if (flags & DasVirtMemFlags_huge_pages) {
+		// assume the common 2MBs if the OS does not tell us.
+		uintptr_t huge_page_size = 2 * 1024 * 1024;
+
+		//
+		// MAP_HUGETLB without a size uses the default hugetlb page size. this is in /proc/meminfo as a line like
+		// "Hugepagesize:       2048 kB", and it does not have to match the transparent huge page size.
+		int fd = open("/proc/meminfo", O_RDONLY);
+		if (fd != -1) {
+			char buf[4096];
+			ssize_t read_size = read(fd, buf, sizeof(buf) - 1);
+			close(fd);
+			if (read_size > 0) {
+				buf[read_size] = '\0';
+				char* line = strstr(buf, "Hugepagesize:");
+				if (line) {
+					uintptr_t size_kb = strtoull(line + sizeof("Hugepagesize:") - 1, NULL, 10);
+					if (size_kb) huge_page_size = size_kb * 1024;
+				}
+			}
+		}
+
+		*huge_page_size_out = huge_page_size;
+		return DasError_success;
+	}
+#else
+	(void)flags;
+#endif
+	return das_virt_mem_huge_page_size(huge_page_size_out);
+}
+
+// stores the NUMA nodes count so 0 means it has not been read from the OS yet.
+static uintptr_t _das_numa_nodes_count;
+
+uint32_t das_numa_nodes_count(void) {
+	uintptr_t nodes_count = das_atomic_load_u(&_das_numa_nodes_count);
+	if (nodes_count) return nodes_count;
+
+	nodes_count = 1;
+#ifdef __linux__
+	//
+	// the file is a list of node ranges like "0-1" or "0,2-3".
+	// the node indices are used directly by the OS, so the count is the highest node + 1.
+	int fd = open("/sys/devices/system/node/possible", O_RDONLY);
+	if (fd != -1) {
+		char buf[256];
+		ssize_t read_size = read(fd, buf, sizeof(buf) - 1);
+		close(fd);
+		if (read_size > 0) {
+			buf[read_size] = '\0';
+			char* str = buf;
+			while (*str) {
+				if (*str >= '0' && *str <= '9') {
+					uintptr_t node = strtoull(str, &str, 10);
+					nodes_count = das_max_u(nodes_count, node + 1);
+				} else {
+					str += 1;
+				}
+			}
+		}
+	}
+#elif _WIN32
+	ULONG highest_node;
+	if (GetNumaHighestNodeNumber(&highest_node)) {
+		nodes_count = (uintptr_t)highest_node + 1;
+	}
+#endif
+
+	das_atomic_store_u(&_das_numa_nodes_count, nodes_count);
+	return nodes_count;
+}
+
+uint32_t das_numa_node(void) {
+	if (das_numa_nodes_count() == 1) return 0;
+
+#if defined(__linux__) && defined(SYS_getcpu)
+	unsigned cpu;
+	unsigned node;
+	if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) {
+		return node;
+	}
+#elif _WIN32
+	PROCESSOR_NUMBER processor_number;
+	USHORT node;
+	GetCurrentProcessorNumberEx(&processor_number);
+	if (GetNumaProcessorNodeEx(&processor_number, &node)) {
+		return node;
+	}
+#endif
+	return 0;
+}
+
+#ifdef _WIN32
+static void* _das_virt_mem_reserve_windows(void* requested_addr, uintptr_t size, uint32_t numa_node) {
+	if (numa_node == das_numa_node_any) {
+		return VirtualAlloc(requested_addr, size, MEM_RESERVE, PAGE_NOACCESS);
+	}
+	//
+	// the preferred node is stored with the reservation and used when the pages are committed with VirtualAlloc.
+	return VirtualAllocExNuma(GetCurrentProcess(), requested_addr, size, MEM_RESERVE, PAGE_NOACCESS, numa_node);
+}
+#endif
+
+#ifdef __linux__
+//
+// the reservation cache, see das_virt_mem_release.
+// the address ranges are bucketed by the power of two below their size and are only handed out for the exact same size,
+// as the caller will release them with that size.
+//
+
+typedef struct {
+	void* addr;
+	uintptr_t size;
+} _DasVirtMemRange;
+
+#define _das_virt_mem_cache_buckets_count (sizeof(uintptr_t) * 8)
+
+static _DasVirtMemRange _das_virt_mem_cache_ranges[_das_virt_mem_cache_buckets_count][das_virt_mem_cache_bucket_cap];
+static uint32_t _das_virt_mem_cache_counts[_das_virt_mem_cache_buckets_count];
+static uintptr_t _das_virt_mem_cache_size;
+static uintptr_t _das_virt_mem_cache_budget = das_virt_mem_cache_budget;
+// the reservations with flags or a NUMA node that have not been released yet, they must not be cached.
+// this grows as needed, so any number of them can be alive at once.
+static _DasVirtMemRange* _das_virt_mem_cache_special_ranges;
+static uint32_t _das_virt_mem_cache_special_count;
+static uint32_t _das_virt_mem_cache_special_cap;
+static DasSpinLock _das_virt_mem_cache_lock;
+
+static DasBool _das_virt_mem_cache_take(uintptr_t size, void** addr_out) {
+	if (das_atomic_load_u(&_das_virt_mem_cache_budget) == 0) return das_false;
+
+	uint32_t bucket_idx = das_most_set_bit_idx(size);
+	_DasVirtMemRange* ranges = _das_virt_mem_cache_ranges[bucket_idx];
+	DasBool is_found = das_false;
+
+	das_spin_lock(&_das_virt_mem_cache_lock);
+	uint32_t count = _das_virt_mem_cache_counts[bucket_idx];
+	for (uint32_t i = 0; i < count; i += 1) {
+		if (ranges[i].size == size) {
+			*addr_out = ranges[i].addr;
+			ranges[i] = ranges[count - 1];
+			_das_virt_mem_cache_counts[bucket_idx] = count - 1;
+			_das_virt_mem_cache_size -= size;
+			is_found = das_true;
+			break;
+		}
+	}
+	das_spin_unlock(&_das_virt_mem_cache_lock);
+
+	return is_found;
+}
+
+//
+// these are tracked even when the cache is off, as it can be turned on before they are released.
+// returns das_false if the table could not grow to fit the address range.
+static DasBool _das_virt_mem_cache_track_special(void* addr, uintptr_t size) {
+	das_spin_lock(&_das_virt_mem_cache_lock);
+	if (_das_virt_mem_cache_special_count == _das_virt_mem_cache_special_cap) {
+		//
+		// this only happens a handful of times, as the capacity doubles each time.
+		uint32_t old_cap = _das_virt_mem_cache_special_cap;
+		uint32_t new_cap = old_cap ? old_cap * 2 : 16;
+		_DasVirtMemRange* ranges = das_system_alloc_fn(NULL, _das_virt_mem_cache_special_ranges,
+			old_cap * sizeof(_DasVirtMemRange), new_cap * sizeof(_DasVirtMemRange), alignof(_DasVirtMemRange));
+		if (!ranges) {
+			das_spin_unlock(&_das_virt_mem_cache_lock);
+			return das_false;
+		}
+		_das_virt_mem_cache_special_ranges = ranges;
+		_das_virt_mem_cache_special_cap = new_cap;
+	}
+
+	_das_virt_mem_cache_special_ranges[_das_virt_mem_cache_special_count] = (_DasVirtMemRange){ .addr = addr, .size = size };
+	_das_virt_mem_cache_special_count += 1;
+	das_spin_unlock(&_das_virt_mem_cache_lock);
+	return das_true;
+}
+
+//
+// returns das_true if the address range has been decommitted and put in the cache.
+static DasBool _das_virt_mem_cache_put(void* addr, uintptr_t size) {
+	das_spin_lock(&_das_virt_mem_cache_lock);
+	DasBool is_special = das_false;
+	for (uint32_t i = 0; i < _das_virt_mem_cache_special_count; i += 1) {
+		_DasVirtMemRange* range = &_das_virt_mem_cache_special_ranges[i];
+		if (addr >= range->addr && addr < das_ptr_add(range->addr, range->size)) {
+			if (addr == range->addr && size >= range->size) {
+				_das_virt_mem_cache_special_count -= 1;
+				*range = _das_virt_mem_cache_special_ranges[_das_virt_mem_cache_special_count];
+			}
+			is_special = das_true;
+			break;
+		}
+	}
+	DasBool is_full = _das_virt_mem_cache_size + size > _das_virt_mem_cache_budget;
+	das_spin_unlock(&_das_virt_mem_cache_lock);
+	if (is_special || is_full) return das_false;
+
+	//
+	// decommit outside of the lock. this fails on locked pages, so those are not cached.
+	if (das_virt_mem_decommit(addr, size) != 0) return das_false;
+
+	uint32_t bucket_idx = das_most_set_bit_idx(size);
+	DasBool is_put = das_false;
+	das_spin_lock(&_das_virt_mem_cache_lock);
+	uint32_t count = _das_virt_mem_cache_counts[bucket_idx];
+	if (count < das_virt_mem_cache_bucket_cap && _das_virt_mem_cache_size + size <= _das_virt_mem_cache_budget) {
+		_das_virt_mem_cache_ranges[bucket_idx][count] = (_DasVirtMemRange){ .addr = addr, .size = size };
+		_das_virt_mem_cache_counts[bucket_idx] = count + 1;
+		_das_virt_mem_cache_size += size;
+		is_put = das_true;
+	}
+	das_spin_unlock(&_das_virt_mem_cache_lock);
+
+	return is_put;
+}
+#endif // __linux__
+
+DasError das_virt_mem_reserve(void* requested_addr, uintptr_t size, void** addr_out) {
+	return das_virt_mem_reserve_on_numa_node(requested_addr, size, DasVirtMemFlags_none, das_numa_node_any, addr_out);
+}
+
+DasError das_virt_mem_reserve_with_flags(void* requested_addr, uintptr_t size, DasVirtMemFlags flags, void** addr_out) {
+	return das_virt_mem_reserve_on_numa_node(requested_addr, size, flags, das_numa_node_any, addr_out);
+}
+
+DasError das_virt_mem_reserve_on_numa_node(void* requested_addr, uintptr_t size, DasVirtMemFlags flags, uint32_t numa_node, void** addr_out) {
+	//
+	// there is nothing to choose from on a single node machine.
+	if (numa_node >= das_numa_nodes_count() || das_numa_nodes_count() == 1) {
+		numa_node = das_numa_node_any;
+	}
+
+#ifdef __linux__
+	if (requested_addr == NULL && flags == DasVirtMemFlags_none && numa_node == das_numa_node_any) {
+		if (_das_virt_mem_cache_take(size, addr_out)) return DasError_success;
+	}
+#endif
+
+	uintptr_t huge_page_size = 0;
+	if (flags & (DasVirtMemFlags_huge_pages | DasVirtMemFlags_huge_page_align)) {
+		DasError error = das_virt_mem_huge_page_size_with_flags(flags, &huge_page_size);
+		if (error) return error;
+	}
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	// memory is automatically commited on Unix based OSs,
+	// so we will restrict the memory from being accessed on reserved.
+	int prot = 0;
+
+	// MAP_ANON = means map physical memory and not a file. it also means the memory will be initialized to zero
+	// MAP_PRIVATE = keep memory private so child process cannot access them
+	// MAP_NORESERVE = do not reserve any swap space for this mapping
+	int map_flags = MAP_ANON | MAP_PRIVATE | MAP_NORESERVE;
+	uintptr_t align_pad = flags & DasVirtMemFlags_huge_page_align ? huge_page_size : 0;
+#ifdef __linux__
+	if (flags & DasVirtMemFlags_huge_pages) {
+		// MAP_HUGETLB = take the pages from the pool of huge pages, these mappings are always aligned to the huge page size.
+		// MAP_NORESERVE is left out so the kernel takes the huge pages out of the pool now and we fail here if there is not enough.
+		// if not, we would crash with a SIGBUS when the memory is first touched.
+		map_flags = MAP_ANON | MAP_PRIVATE | MAP_HUGETLB;
+		align_pad = 0;
+	}
+#endif
+
+	//
+	// to align the address space, we reserve an extra huge page and then give back the unaligned start and the left over end.
+	void* addr = mmap(requested_addr, size + align_pad, prot, map_flags, -1, 0);
+	if (addr == MAP_FAILED)
+		return _das_get_last_error();
+	if (align_pad) {
+		void* aligned_addr = das_ptr_round_up_align(addr, huge_page_size);
+		uintptr_t head_size = das_ptr_diff(aligned_addr, addr);
+		uintptr_t tail_size = align_pad - head_size;
+		if (head_size && munmap(addr, head_size) != 0) return _das_get_last_error();
+		if (tail_size && munmap(das_ptr_add(aligned_addr, size), tail_size) != 0) return _das_get_last_error();
+		addr = aligned_addr;
+	}
+
+#ifdef __linux__
+	if (flags & DasVirtMemFlags_transparent_huge_pages) {
+		// this is just advice, so ignore the error that happens when the kernel does not support transparent huge pages.
+		madvise(addr, size, MADV_HUGEPAGE);
+	}
+
+	if (numa_node != das_numa_node_any && numa_node < sizeof(unsigned long) * 8) {
+		//
+		// the policy is applied to the pages when they are first touched after being committed.
+		// the kernel drops the last bit of the mask size, so pass in one more than we have.
+		// this is just advice, so ignore the errors that happen when the kernel does not support NUMA
+		// or the node is not allowed for this process.
+		unsigned long nodemask = 1UL << numa_node;
+		syscall(SYS_mbind, addr, size, _DAS_MPOL_PREFERRED, &nodemask, sizeof(nodemask) * 8 + 1, 0);
+	}
+
+	//
+	// these keep their huge pages or NUMA policy when they are decommitted, so they cannot be given out from the cache.
+	if ((flags & (DasVirtMemFlags_huge_pages | DasVirtMemFlags_transparent_huge_pages)) || numa_node != das_numa_node_any) {
+		if (!_das_virt_mem_cache_track_special(addr, size)) {
+			munmap(addr, size);
+			return ENOMEM;
+		}
+	}
+#endif
+#elif _WIN32
+	void* addr;
+	if (flags & DasVirtMemFlags_huge_page_align) {
+		//
+		// Windows cannot release part of a reservation. so reserve an extra huge page to find an aligned address,
+		// then release it and reserve again at the aligned address.
+		// another thread can take the address space in between, so try a few times.
+		addr = NULL;
+		for (uint32_t attempt = 0; attempt < 8 && addr == NULL; attempt += 1) {
+			void* padded_addr = VirtualAlloc(requested_addr, size + huge_page_size, MEM_RESERVE, PAGE_NOACCESS);
+			if (padded_addr == NULL)
+				return _das_get_last_error();
+			VirtualFree(padded_addr, 0, MEM_RELEASE);
+			addr = _das_virt_mem_reserve_windows(das_ptr_round_up_align(padded_addr, huge_page_size), size, numa_node);
+		}
+	} else {
+		addr = _das_virt_mem_reserve_windows(requested_addr, size, numa_node);
+	}
+	if (addr == NULL)
+		return _das_get_last_error();
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+
+	*addr_out = addr;
+	return DasError_success;
+}
+
+DasError das_virt_mem_commit(void* addr, uintptr_t size, DasVirtMemProtection protection) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	// memory is automatically commited on Unix based OSs,
+	// memory is restricted from being accessed in our das_virt_mem_reserve.
+	// so lets just apply the protection for the address space.
+	// and then advise the OS that these pages will be used soon.
+	int prot = _das_virt_mem_prot_unix(protection);
+	if (mprotect(addr, size, prot) != 0) return _das_get_last_error();
+	if (madvise(addr, size, MADV_WILLNEED) != 0) return _das_get_last_error();
+#elif _WIN32
+	DWORD prot = _das_virt_mem_prot_windows(protection);
+	if (VirtualAlloc(addr, size, MEM_COMMIT, prot) == NULL)
+		return _das_get_last_error();
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+	return DasError_success;
+}
+
+DasError das_virt_mem_protection_set(void* addr, uintptr_t size, DasVirtMemProtection protection) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	int prot = _das_virt_mem_prot_unix(protection);
+	if (mprotect(addr, size, prot) != 0)
+		return _das_get_last_error();
+#elif _WIN32
+	DWORD prot = _das_virt_mem_prot_windows(protection);
+	DWORD old_prot; // unused
+	if (!VirtualProtect(addr, size, prot, &old_prot))
+		return _das_get_last_error();
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+	return DasError_success;
+}
+
+DasError das_virt_mem_decommit(void* addr, uintptr_t size) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+
+	//
+	// advise the OS that these pages will not be needed.
+	// the OS will zero fill these pages before you next access them.
+	if (madvise(addr, size, MADV_DONTNEED) != 0)
+		return _das_get_last_error();
+
+	// memory is automatically commited on Unix based OSs,
+	// so we will restrict the memory from being accessed when we "decommit.
+	int prot = 0;
+	if (mprotect(addr, size, prot) != 0)
+		return _das_get_last_error();
+#elif _WIN32
+	if (VirtualFree(addr, size, MEM_DECOMMIT) == 0)
+		return _das_get_last_error();
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+	return DasError_success;
+}
+
+DasError das_virt_mem_lock(void* addr, uintptr_t size) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	if (mlock(addr, size) != 0)
+		return _das_get_last_error();
+#elif _WIN32
+	if (!VirtualLock(addr, size))
+		return _das_get_last_error();
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+	return DasError_success;
+}
+
+DasError das_virt_mem_unlock(void* addr, uintptr_t size) {
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	if (munlock(addr, size) != 0)
+		return _das_get_last_error();
+#elif _WIN32
+	if (!VirtualUnlock(addr, size))
+		return _das_get_last_error();
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+	return DasError_success;
+}
+
+//
+// the states of DasLinearAlctor.commit_ahead_state and _DasPool.commit_ahead_state.
+// the allocator only changes the committed size when the state is idle or ready,
+// so the background worker can read it while it commits the next chunk.
+typedef uintptr_t _DasCommitAheadState;
+enum {
+	_DasCommitAheadState_idle,
+	_DasCommitAheadState_in_progress,
+	// the next chunk is committed but the allocator has not added it to the committed size yet.
+	_DasCommitAheadState_ready,
+};
+
+//
+// faults in the committed pages, so the first access of the pages will not page fault.
+static void _das_virt_mem_prefault(void* addr, uintptr_t size, DasCommitAhead commit_ahead) {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+#ifdef __linux__
+	// only supported on Linux 5.14 or later, so we touch each page ourselves if this fails.
+	if (madvise(addr, size, MADV_POPULATE_WRITE) != 0)
+#endif
+	{
+		//
+		// these are new pages that nothing has been allocated from yet, so writing a zero does not change them.
+		for (uintptr_t offset = 0; offset < size; offset += page_size) {
+			*(volatile uint8_t*)das_ptr_add(addr, offset) = 0;
+		}
+	}
+
+	if (commit_ahead == DasCommitAhead_prefault_and_lock) {
+		// locking is just advice, so ignore the error if we are not allowed to lock any more memory.
+		das_virt_mem_lock(addr, size);
+	}
+}
+
+static DasError _das_virt_mem_release(void* addr, uintptr_t size) {
+#ifdef __linux__
+	if (munmap(addr, size) != 0)
+		return _das_get_last_error();
+#elif _WIN32
+	//
+	// unfortunately on Windows all memory must be release at once
+	// that was reserved with VirtualAlloc.
+	if (!VirtualFree(addr, 0, MEM_RELEASE))
+		return _das_get_last_error();
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+	return DasError_success;
+}
+
+DasError das_virt_mem_release(void* addr, uintptr_t size) {
+#ifdef __linux__
+	if (_das_virt_mem_cache_put(addr, size)) return DasError_success;
+#endif
+	return _das_virt_mem_release(addr, size);
+}
+
+DasError das_virt_mem_cache_set_budget(uintptr_t budget) {
+#ifdef __linux__
+	das_spin_lock(&_das_virt_mem_cache_lock);
+	das_atomic_store_u(&_das_virt_mem_cache_budget, budget);
+	DasBool is_over_budget = _das_virt_mem_cache_size > budget;
+	das_spin_unlock(&_das_virt_mem_cache_lock);
+
+	if (is_over_budget) return das_virt_mem_cache_flush();
+#else
+	(void)budget;
+#endif
+	return DasError_success;
+}
+
+DasError das_virt_mem_cache_flush(void) {
+#ifdef __linux__
+	for (uint32_t bucket_idx = 0; bucket_idx < _das_virt_mem_cache_buckets_count; bucket_idx += 1) {
+		while (1) {
+			das_spin_lock(&_das_virt_mem_cache_lock);
+			uint32_t count = _das_virt_mem_cache_counts[bucket_idx];
+			if (count == 0) {
+				das_spin_unlock(&_das_virt_mem_cache_lock);
+				break;
+			}
+
+			_DasVirtMemRange range = _das_virt_mem_cache_ranges[bucket_idx][count - 1];
+			_das_virt_mem_cache_counts[bucket_idx] = count - 1;
+			_das_virt_mem_cache_size -= range.size;
+			das_spin_unlock(&_das_virt_mem_cache_lock);
+
+			DasError error = _das_virt_mem_release(range.addr, range.size);
+			if (error) return error;
+		}
+	}
+#endif
+	return DasError_success;
+}
+
+uintptr_t das_virt_mem_cache_size(void) {
+#ifdef __linux__
+	das_spin_lock(&_das_virt_mem_cache_lock);
+	uintptr_t size = _das_virt_mem_cache_size;
+	das_spin_unlock(&_das_virt_mem_cache_lock);
+	return size;
+#else
+	return 0;
+#endif
+}
+
+DasError das_virt_mem_map_file(void* requested_addr, DasFileHandle file_handle, DasVirtMemProtection protection, uint64_t offset, uintptr_t size, void** addr_out, DasMapFileHandle* map_file_handle_out) {
+	das_assert(protection != DasVirtMemProtection_no_access, "cannot map a file with no access");
+
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
+
+	//
+	// round down the offset to the nearest multiple of reserve_align
+	//
+	uint64_t offset_diff = offset % reserve_align;
+	offset -= offset_diff;
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	*map_file_handle_out = NULL;
+	int prot = _das_virt_mem_prot_unix(protection);
+
+	size = das_round_up_nearest_multiple_u(size, page_size);
+	void* addr = mmap(requested_addr, size, prot, MAP_SHARED, file_handle.raw, offset);
+	if (addr == MAP_FAILED)
+		return _das_get_last_error();
+#elif _WIN32
+
+	DWORD prot = _das_virt_mem_prot_windows(protection);
+
+	DWORD size_high = size >> 32;
+	DWORD size_low = size;
+
+	// create a file mapping object for the file
+	HANDLE map_file_handle = CreateFileMappingA(file_handle.raw, NULL, prot, 0, 0, NULL);
+	if (map_file_handle == NULL)
+		return _das_get_last_error();
+	*map_file_handle_out = map_file_handle;
+
+	DWORD access = 0;
+	switch (protection) {
+		case DasVirtMemProtection_exec_read:
+		case DasVirtMemProtection_read:
+			access = FILE_MAP_READ;
+			break;
+		case DasVirtMemProtection_exec_read_write:
+		case DasVirtMemProtection_read_write:
+			access = FILE_MAP_ALL_ACCESS;
+			break;
+	}
+
+	DWORD offset_high = offset >> 32;
+	DWORD offset_low = offset;
+
+	void* addr = MapViewOfFile(map_file_handle, access, offset_high, offset_low, size);
+	if (addr == NULL)
+		return _das_get_last_error();
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+
+	//
+	// move the pointer to where the user's request offset into the file will be.
+	addr = das_ptr_add(addr, offset_diff);
+	*addr_out = addr;
+
+	return DasError_success;
+}
+
+DasError das_virt_mem_unmap_file(void* addr, uintptr_t size, DasMapFileHandle map_file_handle) {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
+
+	//
+	// when mapping a file the user is given an offset from the start of the range pages that are mapped
+	// to match the file offset they requested.
+	// so round down to the address to the nearest reserve align.
+	addr = das_ptr_round_down_align(addr, reserve_align);
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+	size = das_round_up_nearest_multiple_u(size, page_size);
+	// file mappings must not go in to the reservation cache.
+	return _das_virt_mem_release(addr, size);
+#elif _WIN32
+
+	if (!UnmapViewOfFile(addr))
+		return _das_get_last_error();
+
+	if (!CloseHandle(map_file_handle))
+		return _das_get_last_error();
+
+	return DasError_success;
+#else
+#error "TODO implement virtual memory for this platform"
+#endif
+}
+
+// ===========================================================================
+//
+//
+// Linear Allocator
+//
+//
+// ===========================================================================
+
+DasError DasLinearAlctor_init(DasLinearAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size) {
+	return DasLinearAlctor_init_on_numa_node(alctor, reserved_size, commit_grow_size, DasVirtMemFlags_none, das_numa_node_any);
+}
+
+DasError DasLinearAlctor_init_with_flags(DasLinearAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size, DasVirtMemFlags flags) {
+	return DasLinearAlctor_init_on_numa_node(alctor, reserved_size, commit_grow_size, flags, das_numa_node_any);
+}
+
+DasError DasLinearAlctor_init_on_numa_node(DasLinearAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size, DasVirtMemFlags flags, uint32_t numa_node) {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
+
+	//
+	// with huge pages, we work in huge pages and not the normal page size.
+	if (flags) {
+		if (flags & DasVirtMemFlags_transparent_huge_pages) flags |= DasVirtMemFlags_huge_page_align;
+		error = das_virt_mem_huge_page_size_with_flags(flags, &page_size);
+		if (error) return error;
+		reserve_align = das_max_u(reserve_align, page_size);
+	}
+
+	// reserved_size must be a multiple of the reserve_align.
+	// commit_grow_size must be multiple of the page size.
+	commit_grow_size = das_round_up_nearest_multiple_u(commit_grow_size, page_size);
+	reserved_size = das_round_up_nearest_multiple_u(reserved_size, reserve_align);
+	reserved_size = das_round_up_nearest_multiple_u(reserved_size, commit_grow_size);
+	void* address_space;
+	error = das_virt_mem_reserve_on_numa_node(NULL, reserved_size, flags, numa_node, &address_space);
+	if (error) return error;
+
+	alctor->address_space = address_space;
+	alctor->pos = 0;
+	alctor->commited_size = 0;
+	alctor->commit_grow_size = commit_grow_size;
+	alctor->reserved_size = reserved_size;
+	alctor->peak_pos = 0;
+	alctor->dirty_pos = 0;
+	alctor->retained_size = 0;
+	alctor->retention_shift = 0;
+	alctor->commit_ahead = DasCommitAhead_none;
+	alctor->commit_ahead_state = _DasCommitAheadState_idle;
+	alctor->commit_lock = 0;
+	return DasError_success;
+}
+
+//
+// the size of the next chunk to commit, so the committed memory does not go past the reserved address space.
+static uintptr_t _DasLinearAlctor_next_chunk_size(DasLinearAlctor* alctor) {
+	return das_min_u(alctor->commit_grow_size, alctor->reserved_size - das_atomic_load_u(&alctor->commited_size));
+}
+
+static void _DasLinearAlctor_commit_ahead_job(void* data, uintptr_t arg) {
+	DasLinearAlctor* alctor = (DasLinearAlctor*)data;
+	void* next_pages_start = das_ptr_add(alctor->address_space, das_atomic_load_u(&alctor->commited_size));
+	uintptr_t grow_size = _DasLinearAlctor_next_chunk_size(alctor);
+
+	DasError error = das_virt_mem_commit(next_pages_start, grow_size, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "failed to commit memory next_pages_start(%p), grow_size(%zu), error_code(0x%x)",
+		next_pages_start, grow_size, error);
+	_das_virt_mem_prefault(next_pages_start, grow_size, alctor->commit_ahead);
+
+	das_atomic_store_u(&alctor->commit_ahead_state, _DasCommitAheadState_ready);
+}
+
+//
+// starts committing the next chunk on the background worker, if @param(next_pos) is within half a chunk of the commited memory.
+static void _DasLinearAlctor_commit_ahead(DasLinearAlctor* alctor, uintptr_t next_pos) {
+	uintptr_t commited_size = das_atomic_load_u(&alctor->commited_size);
+	if (next_pos + alctor->commit_grow_size / 2 <= commited_size || commited_size == alctor->reserved_size)
+		return;
+	if (das_atomic_load_u(&alctor->commit_ahead_state) != _DasCommitAheadState_idle)
+		return;
+
+	//
+	// hold the commit lock, so another thread cannot be committing memory while the background worker reads the commited size.
+	// if another thread has the lock, it is already committing so we do not need to.
+	if (!das_spin_try_lock(&alctor->commit_lock))
+		return;
+
+	if (das_atomic_load_u(&alctor->commit_ahead_state) == _DasCommitAheadState_idle && das_atomic_load_u(&alctor->commited_size) < alctor->reserved_size) {
+		das_atomic_store_u(&alctor->commit_ahead_state, _DasCommitAheadState_in_progress);
+		if (!_das_worker_post(_DasLinearAlctor_commit_ahead_job, alctor, 0)) {
+			das_atomic_store_u(&alctor->commit_ahead_state, _DasCommitAheadState_idle);
+		}
+	}
+	das_spin_unlock(&alctor->commit_lock);
+}
+
+//
+// if a chunk is being committed ahead, wait for the background worker to finish it and add it to the commited memory.
+// if the background worker has not started on it yet, then the job is cancelled so we do not wait behind the other jobs in the queue.
+// returns das_true if a chunk was added, otherwise the caller must commit the memory itself.
+static DasBool _DasLinearAlctor_commit_ahead_finish(DasLinearAlctor* alctor) {
+	if (das_atomic_load_u(&alctor->commit_ahead_state) == _DasCommitAheadState_idle)
+		return das_false;
+
+	if (_das_worker_cancel(_DasLinearAlctor_commit_ahead_job, alctor)) {
+		das_atomic_store_u(&alctor->commit_ahead_state, _DasCommitAheadState_idle);
+		return das_false;
+	}
+
+	while (das_atomic_load_u(&alctor->commit_ahead_state) != _DasCommitAheadState_ready) {
+		das_cpu_relax();
+	}
+
+	uintptr_t grow_size = _DasLinearAlctor_next_chunk_size(alctor);
+	das_atomic_store_u(&alctor->commited_size, alctor->commited_size + grow_size);
+	das_atomic_store_u(&alctor->commit_ahead_state, _DasCommitAheadState_idle);
+	return das_true;
+}
+
+DasError DasLinearAlctor_deinit(DasLinearAlctor* alctor) {
+	// make sure the background worker is not using the memory we are about to release.
+	_DasLinearAlctor_commit_ahead_finish(alctor);
+	return das_virt_mem_release(alctor->address_space, alctor->reserved_size);
+}
+
+DasLinearAlctorMarker DasLinearAlctor_save(DasLinearAlctor* alctor) {
+	return alctor->pos;
+}
+
+static inline DasBool _DasLinearAlctor_owns(DasLinearAlctor* alctor, void* ptr) {
+	return ptr >= alctor->address_space && ptr < das_ptr_add(alctor->address_space, alctor->reserved_size);
+}
+
+//
+// marks the memory up to @param(pos) as used, before the position goes down below it.
+// this is atomic as the concurrent version can shrink the last allocation while other threads are allocating.
+static void _DasLinearAlctor_dirty_up_to(DasLinearAlctor* alctor, uintptr_t pos) {
+	uintptr_t dirty_pos = das_atomic_load_u(&alctor->dirty_pos);
+	while (dirty_pos < pos && !das_atomic_cas_u(&alctor->dirty_pos, dirty_pos, pos)) {
+		dirty_pos = das_atomic_load_u(&alctor->dirty_pos);
+	}
+}
+
+void DasLinearAlctor_restore(DasLinearAlctor* alctor, DasLinearAlctorMarker marker) {
+	das_assert(marker <= alctor->pos, "marker(%zu) is past the current position(%zu), it must have been invalidated by a restore or reset", marker, alctor->pos);
+	alctor->peak_pos = das_max_u(alctor->peak_pos, alctor->pos);
+	_DasLinearAlctor_dirty_up_to(alctor, alctor->pos);
+	alctor->pos = marker;
+}
+
+DasError DasLinearAlctor_shrink(DasLinearAlctor* alctor, uintptr_t keep_size) {
+	_DasLinearAlctor_commit_ahead_finish(alctor);
+
+	//
+	// keep whole commit chunks, so the next commit starts where the commit grow size expects.
+	keep_size = das_max_u(keep_size, alctor->pos);
+	keep_size = das_round_up_nearest_multiple_u(keep_size, alctor->commit_grow_size);
+	if (keep_size >= alctor->commited_size)
+		return DasError_success;
+
+	void* decommit_addr = das_ptr_add(alctor->address_space, keep_size);
+	uintptr_t decommit_size = alctor->commited_size - keep_size;
+	if (alctor->commit_ahead == DasCommitAhead_prefault_and_lock) {
+		// locked pages cannot be decommitted. ignore the error as some of these pages may not have been locked.
+		das_virt_mem_unlock(decommit_addr, decommit_size);
+	}
+
+	DasError error = das_virt_mem_decommit(decommit_addr, decommit_size);
+	if (error) return error;
+
+	alctor->commited_size = keep_size;
+	// the decommitted memory will be zeroed by the OS when it is committed again.
+	alctor->dirty_pos = das_min_u(das_max_u(alctor->dirty_pos, alctor->pos), keep_size);
+	return DasError_success;
+}
+
+void DasLinearAlctor_retention_set(DasLinearAlctor* alctor, uint8_t retention_shift) {
+	das_assert(retention_shift < sizeof(uintptr_t) * 8, "retention_shift(%u) must be less than the bits in a uintptr_t", retention_shift);
+	alctor->retention_shift = retention_shift;
+}
+
+void DasLinearAlctor_commit_ahead_set(DasLinearAlctor* alctor, DasCommitAhead commit_ahead) {
+	// the background worker reads the mode, so wait for it to finish first.
+	_DasLinearAlctor_commit_ahead_finish(alctor);
+	alctor->commit_ahead = commit_ahead;
+}
+
+static DasBool _DasLinearAlctor_commit_next_chunk(DasLinearAlctor* alctor) {
+	if (alctor->commited_size == alctor->reserved_size) {
+		// linear alloctor reserved_size has been exhausted.
+		// there is no more memory to commit.
+		return das_false;
+	} else if (_DasLinearAlctor_commit_ahead_finish(alctor)) {
+		//
+		// the background worker has committed the next chunk for us.
+		return das_true;
+	} else {
+		//
+		// commit the next pages of memory using the grow size the linear allocator was initialized with.
+		void* next_pages_start = das_ptr_add(alctor->address_space, alctor->commited_size);
+		uintptr_t grow_size = _DasLinearAlctor_next_chunk_size(alctor);
+
+		DasError error = das_virt_mem_commit(next_pages_start, grow_size, DasVirtMemProtection_read_write);
+		das_assert(error == 0, "failed to commit memory next_pages_start(%p), grow_size(%zu), error_code(0x%x)",
+			next_pages_start, grow_size, error);
+
+		// stored atomically as DasLinearAlctor_concurrent_alloc_fn reads this without holding the commit lock.
+		das_atomic_store_u(&alctor->commited_size, alctor->commited_size + grow_size);
+		return das_true;
+	}
+}
+
+//
+// commits memory until the commited memory reaches @param(needed_size).
+// only one thread commits at a time, the rest will wait and then see the memory the other thread commited.
+static DasBool _DasLinearAlctor_concurrent_commit(DasLinearAlctor* alctor, uintptr_t needed_size) {
+	if (needed_size > alctor->reserved_size)
+		return das_false;
+
+	das_spin_lock(&alctor->commit_lock);
+	DasBool success = das_true;
+	while (das_atomic_load_u(&alctor->commited_size) < needed_size) {
+		if (!_DasLinearAlctor_commit_next_chunk(alctor)) {
+			success = das_false;
+			break;
+		}
+	}
+	das_spin_unlock(&alctor->commit_lock);
+	return success;
+}
+
+//
+// extends the allocation in place, if it is the last allocation.
+static DasBool _DasLinearAlctor_try_expand(DasLinearAlctor* alctor, void* ptr, uintptr_t old_size, uintptr_t size) {
+	if (das_ptr_add(alctor->address_space, alctor->pos - old_size) != ptr)
+		return das_false;
+
+	uintptr_t next_pos = das_ptr_diff(ptr, alctor->address_space) + size;
+	while (next_pos > alctor->commited_size) {
+		//
+		// not enough room in the linear block of memory that is commited.
+		// so lets try to commit more memory.
+		if (!_DasLinearAlctor_commit_next_chunk(alctor))
+			return das_false;
+	}
+
+	if (next_pos < alctor->pos) _DasLinearAlctor_dirty_up_to(alctor, alctor->pos);
+	alctor->pos = next_pos;
+	if (alctor->commit_ahead) _DasLinearAlctor_commit_ahead(alctor, next_pos);
+	return das_true;
+}
+
+void* DasLinearAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasLinearAlctor* alctor = (DasLinearAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset by decommiting the memory back to the OS but retaining the reserved address space.
+		uintptr_t keep_size = 0;
+		if (alctor->retention_shift) {
+			//
+			// move the average towards the peak of this use, without the subtraction going negative.
+			uintptr_t peak_pos = das_max_u(alctor->peak_pos, alctor->pos);
+			uintptr_t shift = alctor->retention_shift;
+			alctor->retained_size = alctor->retained_size - (alctor->retained_size >> shift) + (peak_pos >> shift);
+			keep_size = alctor->retained_size;
+		}
+
+		_DasLinearAlctor_dirty_up_to(alctor, alctor->pos);
+		alctor->pos = 0;
+		alctor->peak_pos = 0;
+		DasError error = DasLinearAlctor_shrink(alctor, keep_size);
+		das_assert(error == 0, "failed to decommit memory address_space(%p), commited_size(%zu)",
+			alctor->address_space, alctor->commited_size);
+	} else if (!ptr) {
+		// allocate
+		while (1) {
+			//
+			// get the next pointer and align it
+			ptr = das_ptr_add(alctor->address_space, alctor->pos);
+			ptr = das_ptr_round_up_align(ptr, align);
+			uintptr_t next_pos = das_ptr_diff(ptr, alctor->address_space) + size;
+			if (next_pos <= alctor->commited_size) {
+				//
+				// success, the requested size can fit in the linear block of memory.
+				alctor->pos = next_pos;
+				if (alctor->commit_ahead) _DasLinearAlctor_commit_ahead(alctor, next_pos);
+				return ptr;
+			} else {
+				//
+				// failure, not enough room in the linear block of memory that is commited.
+				// so lets try to commit more memory.
+				if (!_DasLinearAlctor_commit_next_chunk(alctor))
+					return NULL;
+			}
+		}
+	} else if (ptr && size > 0) {
+		// reallocate
+
+		// check if the ptr is the last allocation to resize in place
+		if (_DasLinearAlctor_try_expand(alctor, ptr, old_size, size))
+			return ptr;
+
+		// if we cannot extend in place, then just allocate a new block.
+		void* new_ptr = DasLinearAlctor_alloc_fn(alctor, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, size < old_size ? size : old_size);
+		return new_ptr;
+	} else {
+		// deallocate
+		// do nothing
+		return NULL;
+	}
+
+	return NULL;
+}
+
+//
+// makes the batch out of a single allocation, so it only bumps the next allocation position once.
+static DasBool _DasLinearAlctor_alloc_batch(DasLinearAlctor* alctor, DasAllocFn alloc_fn, DasAllocExtArgs* args) {
+	if (args->count == 0) return das_true;
+
+	uintptr_t stride = das_round_up_nearest_multiple_u(args->size, args->align);
+	void* ptr = alloc_fn(alctor, NULL, 0, stride * (args->count - 1) + args->size, args->align);
+	if (!ptr) {
+		args->count = 0;
+		return das_true;
+	}
+
+	for (uintptr_t i = 0; i < args->count; i += 1) {
+		args->ptrs[i] = das_ptr_add(ptr, i * stride);
+	}
+	return das_true;
+}
+
+//
+// zeros the part of @param(ptr) to @param(ptr) + @param(size) that has been used since it was committed.
+// the rest has not been touched since the OS zeroed it.
+static void _DasLinearAlctor_zero_dirty(DasLinearAlctor* alctor, void* ptr, uintptr_t size) {
+	uintptr_t offset = das_ptr_diff(ptr, alctor->address_space);
+	uintptr_t dirty_pos = das_atomic_load_u(&alctor->dirty_pos);
+	if (offset < dirty_pos) {
+		memset(ptr, 0, das_min_u(size, dirty_pos - offset));
+	}
+}
+
+//
+// handles DasAllocExtOp_alloc_zeroed and DasAllocExtOp_realloc_zeroed for both versions of the linear allocator.
+// the new memory always starts at the position. so if there is used memory past the position,
+// return das_false and let the caller zero it, as the caller may only need some of it zeroed.
+static DasBool _DasLinearAlctor_alloc_zeroed(DasLinearAlctor* alctor, DasAllocFn alloc_fn, DasAllocExtArgs* args) {
+	if (das_atomic_load_u(&alctor->dirty_pos) > das_atomic_load_u(&alctor->pos))
+		return das_false;
+
+	//
+	// a concurrent deallocation can move the position back after the check,
+	// so the used memory is still zeroed, but this is normally nothing.
+	if (!args->ptr) {
+		args->ptr = alloc_fn(alctor, NULL, 0, args->size, args->align);
+		if (args->ptr) _DasLinearAlctor_zero_dirty(alctor, args->ptr, args->size);
+	} else {
+		args->ptr = alloc_fn(alctor, args->ptr, args->old_size, args->size, args->align);
+		if (args->ptr && args->size > args->old_size) {
+			_DasLinearAlctor_zero_dirty(alctor, das_ptr_add(args->ptr, args->old_size), args->size - args->old_size);
+		}
+	}
+	return das_true;
+}
+
+DasBool DasLinearAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasLinearAlctor* alctor = (DasLinearAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			return _DasLinearAlctor_try_expand(alctor, args->ptr, args->old_size, args->size);
+		case DasAllocExtOp_alloc_batch:
+			return _DasLinearAlctor_alloc_batch(alctor, DasLinearAlctor_alloc_fn, args);
+		case DasAllocExtOp_dealloc_batch:
+			// do nothing
+			return das_true;
+		case DasAllocExtOp_alloc_zeroed:
+			args->ptr = NULL;
+			return _DasLinearAlctor_alloc_zeroed(alctor, DasLinearAlctor_alloc_fn, args);
+		case DasAllocExtOp_realloc_zeroed:
+			return _DasLinearAlctor_alloc_zeroed(alctor, DasLinearAlctor_alloc_fn, args);
+		case DasAllocExtOp_owns:
+			args->count = _DasLinearAlctor_owns(alctor, args->ptr);
+			return das_true;
+	}
+
+	return das_false;
+}
+
+//
+// extends the allocation in place, if it is still the last allocation across all threads.
+static DasBool _DasLinearAlctor_concurrent_try_expand(DasLinearAlctor* alctor, void* ptr, uintptr_t old_size, uintptr_t size) {
+	uintptr_t ptr_pos = das_ptr_diff(ptr, alctor->address_space);
+	uintptr_t end_pos = ptr_pos + old_size;
+	uintptr_t next_pos = ptr_pos + size;
+	while (das_atomic_load_u(&alctor->pos) == end_pos) {
+		if (next_pos < end_pos) _DasLinearAlctor_dirty_up_to(alctor, end_pos);
+		if (next_pos <= das_atomic_load_u(&alctor->commited_size)) {
+			if (das_atomic_cas_u(&alctor->pos, end_pos, next_pos)) {
+				if (alctor->commit_ahead) _DasLinearAlctor_commit_ahead(alctor, next_pos);
+				return das_true;
+			}
+		} else if (!_DasLinearAlctor_concurrent_commit(alctor, next_pos)) {
+			return das_false;
+		}
+	}
+
+	return das_false;
+}
+
+void* DasLinearAlctor_concurrent_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasLinearAlctor* alctor = (DasLinearAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset is not thread safe, so it is the same as the single threaded version.
+		return DasLinearAlctor_alloc_fn(alctor_data, ptr, old_size, size, align);
+	} else if (!ptr) {
+		// allocate
+		while (1) {
+			//
+			// get the next pointer and align it
+			uintptr_t pos = das_atomic_load_u(&alctor->pos);
+			ptr = das_ptr_add(alctor->address_space, pos);
+			ptr = das_ptr_round_up_align(ptr, align);
+			uintptr_t next_pos = das_ptr_diff(ptr, alctor->address_space) + size;
+			if (next_pos <= das_atomic_load_u(&alctor->commited_size)) {
+				//
+				// the requested size can fit in the commited memory, so try to claim it.
+				// if another thread beat us to it then try again from their new position.
+				if (das_atomic_cas_u(&alctor->pos, pos, next_pos)) {
+					if (alctor->commit_ahead) _DasLinearAlctor_commit_ahead(alctor, next_pos);
+					return ptr;
+				}
+			} else {
+				//
+				// not enough room in the linear block of memory that is commited.
+				// so lets try to commit more memory.
+				if (!_DasLinearAlctor_concurrent_commit(alctor, next_pos))
+					return NULL;
+			}
+		}
+	} else if (ptr && size > 0) {
+		// reallocate
+
+		//
+		// try to resize in place if the ptr is still the last allocation.
+		if (_DasLinearAlctor_concurrent_try_expand(alctor, ptr, old_size, size))
+			return ptr;
+
+		// if we cannot extend in place, then just allocate a new block.
+		void* new_ptr = DasLinearAlctor_concurrent_alloc_fn(alctor, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, size < old_size ? size : old_size);
+		return new_ptr;
+	} else {
+		// deallocate
+		// do nothing
+		return NULL;
+	}
+
+	return NULL;
+}
+
+DasBool DasLinearAlctor_concurrent_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasLinearAlctor* alctor = (DasLinearAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			return _DasLinearAlctor_concurrent_try_expand(alctor, args->ptr, args->old_size, args->size);
+		case DasAllocExtOp_alloc_batch:
+			return _DasLinearAlctor_alloc_batch(alctor, DasLinearAlctor_concurrent_alloc_fn, args);
+		case DasAllocExtOp_dealloc_batch:
+			// do nothing
+			return das_true;
+		case DasAllocExtOp_alloc_zeroed:
+			args->ptr = NULL;
+			return _DasLinearAlctor_alloc_zeroed(alctor, DasLinearAlctor_concurrent_alloc_fn, args);
+		case DasAllocExtOp_realloc_zeroed:
+			return _DasLinearAlctor_alloc_zeroed(alctor, DasLinearAlctor_concurrent_alloc_fn, args);
+		case DasAllocExtOp_owns:
+			args->count = _DasLinearAlctor_owns(alctor, args->ptr);
+			return das_true;
+	}
+
+	return das_false;
+}
+
+// ===========================================================================
+//
+//
+// NUMA Arenas
+//
+//
+// ===========================================================================
+
+DasError DasNumaArenas_init(DasNumaArenas* arenas, uintptr_t reserved_size, uintptr_t commit_grow_size, DasVirtMemFlags flags) {
+	uint32_t arenas_count = das_min_u(das_numa_nodes_count(), das_numa_nodes_max);
+	for (uint32_t node = 0; node < arenas_count; node += 1) {
+		DasError error = DasLinearAlctor_init_on_numa_node(&arenas->arenas[node], reserved_size, commit_grow_size, flags, node);
+		if (error) {
+			while (node) {
+				node -= 1;
+				DasLinearAlctor_deinit(&arenas->arenas[node]);
+			}
+			return error;
+		}
+	}
+
+	arenas->arenas_count = arenas_count;
+	return DasError_success;
+}
+
+DasError DasNumaArenas_deinit(DasNumaArenas* arenas) {
+	for (uint32_t node = 0; node < arenas->arenas_count; node += 1) {
+		DasError error = DasLinearAlctor_deinit(&arenas->arenas[node]);
+		if (error) return error;
+	}
+
+	arenas->arenas_count = 0;
+	return DasError_success;
+}
+
+DasLinearAlctor* DasNumaArenas_get(DasNumaArenas* arenas) {
+	das_debug_assert(arenas->arenas_count, "the NUMA arenas have not been initialized");
+	return &arenas->arenas[das_numa_node() % arenas->arenas_count];
+}
+
+// ===========================================================================
+//
+//
+// Scratch Arenas
+//
+//
+// ===========================================================================
+
+static das_thread_local DasLinearAlctor _das_scratch_arenas[das_scratch_arenas_count];
+
+DasScratch das_scratch_begin(DasAlctor* conflicts, uint32_t conflicts_count) {
+	for (uint32_t i = 0; i < das_scratch_arenas_count; i += 1) {
+		DasLinearAlctor* arena = &_das_scratch_arenas[i];
+
+		DasBool is_conflict = das_false;
+		for (uint32_t j = 0; j < conflicts_count; j += 1) {
+			if (conflicts[j].data == arena) {
+				is_conflict = das_true;
+				break;
+			}
+		}
+		if (is_conflict) continue;
+
+		if (arena->address_space == NULL) {
+			DasError error = DasLinearAlctor_init(arena, das_scratch_reserved_size, das_scratch_commit_grow_size);
+			das_assert(error == 0, "failed to initialize the scratch arena: 0x%x", error);
+		}
+
+		DasScratch scratch;
+		scratch.alctor = DasLinearAlctor_as_das(arena);
+		scratch.arena = arena;
+		scratch.marker = DasLinearAlctor_save(arena);
+		return scratch;
+	}
+
+	das_abort("every scratch arena is in the conflicts, increase das_scratch_arenas_count to have more than %u", das_scratch_arenas_count);
+}
+
+void das_scratch_end(DasScratch* scratch) {
+	DasLinearAlctor_restore(scratch->arena, scratch->marker);
+}
+
+void das_scratch_thread_deinit(void) {
+	for (uint32_t i = 0; i < das_scratch_arenas_count; i += 1) {
+		DasLinearAlctor* arena = &_das_scratch_arenas[i];
+		if (arena->address_space == NULL) continue;
+
+		DasError error = DasLinearAlctor_deinit(arena);
+		das_assert(error == 0, "failed to deinitialize the scratch arena: 0x%x", error);
+		das_zero_elmt(arena);
+	}
+}
+
+// ===========================================================================
+//
+//
+// Frame Allocator
+//
+//
+// ===========================================================================
+
+DasError DasFrameAlctor_init(DasFrameAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size) {
+	das_zero_elmt(alctor);
+
+	DasError error = DasLinearAlctor_init(&alctor->arenas[0], reserved_size, commit_grow_size);
+	if (error) return error;
+
+	error = DasLinearAlctor_init(&alctor->arenas[1], reserved_size, commit_grow_size);
+	if (error) {
+		DasLinearAlctor_deinit(&alctor->arenas[0]);
+		return error;
+	}
+
+	return DasError_success;
+}
+
+DasError DasFrameAlctor_deinit(DasFrameAlctor* alctor) {
+	for (uint32_t i = 0; i < 2; i += 1) {
+		DasError error = DasLinearAlctor_deinit(&alctor->arenas[i]);
+		if (error) return error;
+	}
+
+	das_zero_elmt(alctor);
+	return DasError_success;
+}
+
+void DasFrameAlctor_next_frame(DasFrameAlctor* alctor) {
+	uint32_t arena_idx = !alctor->arena_idx;
+	DasLinearAlctor* arena = &alctor->arenas[arena_idx];
+
+	//
+	// the arena is about to be reused, so record how far it got in the frame it was last used for.
+	uintptr_t high_water_pos = das_max_u(alctor->high_water_pos[arena_idx], arena->pos);
+	alctor->frames_count[arena_idx] += 1;
+	if (alctor->frames_count[arena_idx] >= das_frame_alctor_decommit_frames_count) {
+		//
+		// decommit the memory that has not been needed in any of these frames.
+		DasError error = DasLinearAlctor_shrink(arena, high_water_pos);
+		das_assert(error == 0, "failed to decommit the frame arena: 0x%x", error);
+
+		high_water_pos = 0;
+		alctor->frames_count[arena_idx] = 0;
+	}
+	alctor->high_water_pos[arena_idx] = high_water_pos;
+
+	DasLinearAlctor_restore(arena, 0);
+	alctor->arena_idx = arena_idx;
+}
+
+void* DasFrameAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasFrameAlctor* alctor = (DasFrameAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset both of the arenas
+		for (uint32_t i = 0; i < 2; i += 1) {
+			DasLinearAlctor_alloc_fn(&alctor->arenas[i], NULL, 0, 0, 0);
+			alctor->frames_count[i] = 0;
+			alctor->high_water_pos[i] = 0;
+		}
+		return NULL;
+	}
+
+	//
+	// the linear allocator only extends in place when the pointer is it's last allocation,
+	// so allocations from the previous frame's arena are copied into the current one.
+	return DasLinearAlctor_alloc_fn(&alctor->arenas[alctor->arena_idx], ptr, old_size, size, align);
+}
+
+DasBool DasFrameAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasFrameAlctor* alctor = (DasFrameAlctor*)alctor_data;
+	if (op == DasAllocExtOp_owns) {
+		args->count = _DasLinearAlctor_owns(&alctor->arenas[0], args->ptr) || _DasLinearAlctor_owns(&alctor->arenas[1], args->ptr);
+		return das_true;
+	}
+
+	return DasLinearAlctor_alloc_ext_fn(&alctor->arenas[alctor->arena_idx], op, args);
+}
+
+// ===========================================================================
+//
+//
+// Ring Allocator
+//
+//
+// ===========================================================================
+
+// the header of every block in the ring, it comes just before the allocation.
+// blocks that are only used to pad are put in the ring as freed.
+typedef struct {
+	uintptr_t size;
+	uintptr_t is_freed;
+} _DasRingBlock;
+
+// every block is a multiple of this, so there is always room for a padding block's header.
+#define _das_ring_block_align sizeof(_DasRingBlock)
+
+static inline _DasRingBlock* _DasRingAlctor_block(DasRingAlctor* alctor, uintptr_t offset) {
+	return das_ptr_add(alctor->address_space, offset);
+}
+
+static inline DasBool _DasRingAlctor_owns(DasRingAlctor* alctor, void* ptr) {
+	return ptr >= alctor->address_space && ptr < das_ptr_add(alctor->address_space, alctor->size);
+}
+
+static inline void _DasRingAlctor_put_padding(DasRingAlctor* alctor, uintptr_t offset, uintptr_t size) {
+	_DasRingBlock* block = _DasRingAlctor_block(alctor, offset);
+	block->size = size;
+	block->is_freed = das_true;
+}
+
+static void _DasRingAlctor_commit(DasRingAlctor* alctor, uintptr_t end_offset) {
+	if (end_offset <= alctor->commited_size)
+		return;
+
+	uintptr_t commited_size = das_round_up_nearest_multiple_u(end_offset, alctor->page_size);
+	DasError error = das_virt_mem_commit(das_ptr_add(alctor->address_space, alctor->commited_size), commited_size - alctor->commited_size, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+	alctor->commited_size = commited_size;
+}
+
+//
+// allocates at the head of the ring, returns NULL if it does not fit.
+static void* _DasRingAlctor_alloc(DasRingAlctor* alctor, uintptr_t size, uintptr_t align) {
+	if (align > alctor->page_size)
+		return NULL;
+
+	align = das_max_u(align, _das_ring_block_align);
+	uintptr_t block_size = sizeof(_DasRingBlock) + das_round_up_nearest_multiple_u(size, _das_ring_block_align);
+	uintptr_t head = alctor->head_pos % alctor->size;
+
+	//
+	// the block's header goes just before the aligned allocation,
+	// any gap before the header is filled with a padding block.
+	uintptr_t wrap_size = 0;
+	uintptr_t block_offset = das_round_up_nearest_multiple_u(head + sizeof(_DasRingBlock), align) - sizeof(_DasRingBlock);
+	if (block_offset + block_size > alctor->size) {
+		//
+		// it does not fit before the end of the ring, so wrap around to the start.
+		// the rest of the ring at the end is filled with a padding block.
+		wrap_size = alctor->size - head;
+		block_offset = das_round_up_nearest_multiple_u(sizeof(_DasRingBlock), align) - sizeof(_DasRingBlock);
+		if (block_offset + block_size > alctor->size)
+			return NULL;
+		head = 0;
+	}
+
+	uintptr_t needed_size = wrap_size + (block_offset - head) + block_size;
+	if (alctor->head_pos - alctor->tail_pos + needed_size > alctor->size)
+		return NULL;
+
+	_DasRingAlctor_commit(alctor, wrap_size ? alctor->size : block_offset + block_size);
+	if (wrap_size) {
+		_DasRingAlctor_put_padding(alctor, alctor->size - wrap_size, wrap_size);
+	}
+	if (block_offset > head) {
+		_DasRingAlctor_put_padding(alctor, head, block_offset - head);
+	}
+
+	_DasRingBlock* block = _DasRingAlctor_block(alctor, block_offset);
+	block->size = block_size;
+	block->is_freed = das_false;
+	alctor->head_pos += needed_size;
+	return das_ptr_add(block, sizeof(_DasRingBlock));
+}
+
+static void _DasRingAlctor_dealloc(DasRingAlctor* alctor, void* ptr) {
+	_DasRingBlock* block = das_ptr_sub(ptr, sizeof(_DasRingBlock));
+	das_debug_assert(!block->is_freed, "double free detected in the ring allocator");
+	block->is_freed = das_true;
+
+	//
+	// move the tail past every freed block at the tail of the ring.
+	while (alctor->tail_pos != alctor->head_pos) {
+		_DasRingBlock* tail_block = _DasRingAlctor_block(alctor, alctor->tail_pos % alctor->size);
+		if (!tail_block->is_freed)
+			break;
+		alctor->tail_pos += tail_block->size;
+	}
+
+	//
+	// the ring is empty, so start from the beginning again to keep using the same memory.
+	if (alctor->tail_pos == alctor->head_pos) {
+		alctor->head_pos = 0;
+		alctor->tail_pos = 0;
+	}
+}
+
+DasError DasRingAlctor_init(DasRingAlctor* alctor, uintptr_t size, DasAlctor fallback) {
+	das_zero_elmt(alctor);
+
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
+
+	size = das_round_up_nearest_multiple_u(size, reserve_align);
+	error = das_virt_mem_reserve(NULL, size, &alctor->address_space);
+	if (error) return error;
+
+	alctor->fallback = fallback;
+	alctor->size = size;
+	alctor->page_size = page_size;
+	return DasError_success;
+}
+
+DasError DasRingAlctor_deinit(DasRingAlctor* alctor) {
+	DasError error = das_virt_mem_release(alctor->address_space, alctor->size);
+	if (error) return error;
+
+	das_zero_elmt(alctor);
+	return DasError_success;
+}
+
+void* DasRingAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasRingAlctor* alctor = (DasRingAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset
+		alctor->head_pos = 0;
+		alctor->tail_pos = 0;
+		return alctor->fallback.fn(alctor->fallback.data, ptr, old_size, size, align);
+	} else if (!ptr) {
+		// allocate
+		void* new_ptr = _DasRingAlctor_alloc(alctor, size, align);
+		if (new_ptr) return new_ptr;
+
+		return alctor->fallback.fn(alctor->fallback.data, ptr, old_size, size, align);
+	} else if (ptr && size > 0) {
+		// reallocate
+		if (!_DasRingAlctor_owns(alctor, ptr)) {
+			return alctor->fallback.fn(alctor->fallback.data, ptr, old_size, size, align);
+		}
+
+		//
+		// if this is the block at the head of the ring, then try to resize in place.
+		_DasRingBlock* block = das_ptr_sub(ptr, sizeof(_DasRingBlock));
+		uintptr_t block_offset = das_ptr_diff(block, alctor->address_space);
+		uintptr_t head = alctor->head_pos % alctor->size;
+		if (alctor->head_pos != alctor->tail_pos && (head == 0 ? alctor->size : head) == block_offset + block->size) {
+			uintptr_t block_size = sizeof(_DasRingBlock) + das_round_up_nearest_multiple_u(size, _das_ring_block_align);
+			uintptr_t used_size = alctor->head_pos - alctor->tail_pos - block->size;
+			if (block_offset + block_size <= alctor->size && used_size + block_size <= alctor->size) {
+				_DasRingAlctor_commit(alctor, block_offset + block_size);
+				alctor->head_pos = alctor->head_pos - block->size + block_size;
+				block->size = block_size;
+				return ptr;
+			}
+		}
+
+		void* new_ptr = DasRingAlctor_alloc_fn(alctor, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		_DasRingAlctor_dealloc(alctor, ptr);
+		return new_ptr;
+	} else {
+		// deallocate
+		if (!_DasRingAlctor_owns(alctor, ptr)) {
+			return alctor->fallback.fn(alctor->fallback.data, ptr, old_size, size, align);
+		}
+
+		_DasRingAlctor_dealloc(alctor, ptr);
+		return NULL;
+	}
+
+	return NULL;
+}
+
+DasBool DasRingAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasRingAlctor* alctor = (DasRingAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_owns:
+			args->count = _DasRingAlctor_owns(alctor, args->ptr);
+			return _DasAlctor_owns_or(alctor->fallback, args->ptr, &args->count);
+	}
+
+	return das_false;
+}
+
+// ===========================================================================
+//
+//
+// Slab Allocator
+//
+//
+// ===========================================================================
+
+//
+// the internal metadata for a slab that is stored outside of the slab's memory.
+// the identifiers are +1 an index so 0 can be used as null.
+typedef struct _DasSlab _DasSlab;
+struct _DasSlab {
+	uint32_t prev_id;
+	uint32_t next_id;
+	uint16_t used_count;
+	uint16_t blocks_count;
+	uint8_t class_idx;
+	// a set bit means the block is allocated.
+	// bits past blocks_count are always set so they are never allocated.
+	uint64_t bitmap[];
+};
+
+static inline _DasSlab* _DasSlabAlctor_slab(DasSlabAlctor* alctor, uint32_t slab_id) {
+	uintptr_t slabs_size = (uintptr_t)alctor->slabs_cap * alctor->slab_size;
+	return das_ptr_add(alctor->address_space, slabs_size + (uintptr_t)(slab_id - 1) * alctor->slab_metadata_size);
+}
+
+static inline void* _DasSlabAlctor_slab_memory(DasSlabAlctor* alctor, uint32_t slab_id) {
+	return das_ptr_add(alctor->address_space, (uintptr_t)(slab_id - 1) * alctor->slab_size);
+}
+
+static inline uint32_t _DasSlabAlctor_bitmap_words_count(DasSlabAlctor* alctor) {
+	return (alctor->slab_metadata_size - sizeof(_DasSlab)) / sizeof(uint64_t);
+}
+
+static void _DasSlabAlctor_partial_push(DasSlabAlctor* alctor, uint32_t class_idx, uint32_t slab_id) {
+	_DasSlab* slab = _DasSlabAlctor_slab(alctor, slab_id);
+	uint32_t head_id = alctor->partial_slab_head_ids[class_idx];
+	if (head_id) {
+		_DasSlabAlctor_slab(alctor, head_id)->prev_id = slab_id;
+	}
+	slab->prev_id = 0;
+	slab->next_id = head_id;
+	alctor->partial_slab_head_ids[class_idx] = slab_id;
+}
+
+static void _DasSlabAlctor_partial_remove(DasSlabAlctor* alctor, uint32_t class_idx, uint32_t slab_id) {
+	_DasSlab* slab = _DasSlabAlctor_slab(alctor, slab_id);
+	if (slab->prev_id) {
+		_DasSlabAlctor_slab(alctor, slab->prev_id)->next_id = slab->next_id;
+	} else {
+		alctor->partial_slab_head_ids[class_idx] = slab->next_id;
+	}
+
+	if (slab->next_id) {
+		_DasSlabAlctor_slab(alctor, slab->next_id)->prev_id = slab->prev_id;
+	}
+	slab->prev_id = 0;
+	slab->next_id = 0;
+}
+
+//
+// takes a slab from the free slab list, or a never used slab from the end
+// and commits it's memory. returns 0 if the reserved address space has been exhausted.
+static uint32_t _DasSlabAlctor_take_slab(DasSlabAlctor* alctor) {
+	uint32_t slab_id;
+	if (alctor->free_slab_head_id) {
+		slab_id = alctor->free_slab_head_id;
+		alctor->free_slab_head_id = _DasSlabAlctor_slab(alctor, slab_id)->next_id;
+	} else {
+		if (alctor->slabs_count == alctor->slabs_cap)
+			return 0;
+
+		//
+		// commit more of the metadata if the new slab's metadata goes past the commited memory.
+		uintptr_t metadata_end = (uintptr_t)(alctor->slabs_count + 1) * alctor->slab_metadata_size;
+		if (metadata_end > alctor->slab_metadata_commited_size) {
+			void* metadata_to_commit = das_ptr_add(_DasSlabAlctor_slab(alctor, 1), alctor->slab_metadata_commited_size);
+			uintptr_t grow_size = das_round_up_nearest_multiple_u(metadata_end - alctor->slab_metadata_commited_size, alctor->slab_size);
+			DasError error = das_virt_mem_commit(metadata_to_commit, grow_size, DasVirtMemProtection_read_write);
+			das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+			alctor->slab_metadata_commited_size += grow_size;
+		}
+
+		alctor->slabs_count += 1;
+		slab_id = alctor->slabs_count;
+	}
+
+	DasError error = das_virt_mem_commit(_DasSlabAlctor_slab_memory(alctor, slab_id), alctor->slab_size, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+	return slab_id;
+}
+
+DasError DasSlabAlctor_init(DasSlabAlctor* alctor, uintptr_t reserved_size) {
+	das_zero_elmt(alctor);
+
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
+	das_assert(page_size >= 4096, "the slab allocator requires a page size of atleast 4KBs but got %zu", page_size);
+
+	//
+	// the bitmap needs a bit for every block of the smallest size class.
+	uint32_t bitmap_words_count = das_max_u(page_size / DasSlabAlctor_min_size / 64, 1);
+	uint32_t slab_metadata_size = sizeof(_DasSlab) + bitmap_words_count * sizeof(uint64_t);
+
+	//
+	// reserve the whole address space for the slabs and their metadata.
+	uintptr_t slabs_size = das_round_up_nearest_multiple_u(reserved_size, reserve_align);
+	uint32_t slabs_cap = slabs_size / page_size;
+	uintptr_t metadata_size = das_round_up_nearest_multiple_u((uintptr_t)slabs_cap * slab_metadata_size, reserve_align);
+	error = das_virt_mem_reserve(NULL, slabs_size + metadata_size, &alctor->address_space);
+	if (error) return error;
+
+	alctor->reserved_size = slabs_size + metadata_size;
+	alctor->slab_size = page_size;
+	alctor->slab_metadata_size = slab_metadata_size;
+	alctor->slabs_cap = slabs_cap;
+	return DasError_success;
+}
+
+DasError DasSlabAlctor_deinit(DasSlabAlctor* alctor) {
+	DasError error = das_virt_mem_release(alctor->address_space, alctor->reserved_size);
+	if (error) return error;
+
+	das_zero_elmt(alctor);
+	return DasError_success;
+}
+
+void* DasSlabAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasSlabAlctor* alctor = (DasSlabAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset by decommiting the memory back to the OS but retaining the reserved address space.
+		if (alctor->slabs_count) {
+			DasError error = das_virt_mem_decommit(alctor->address_space, (uintptr_t)alctor->slabs_count * alctor->slab_size);
+			das_assert(error == 0, "failed to decommit the slabs: 0x%x", error);
+			error = das_virt_mem_decommit(_DasSlabAlctor_slab(alctor, 1), alctor->slab_metadata_commited_size);
+			das_assert(error == 0, "failed to decommit the slab metadata: 0x%x", error);
+		}
+
+		alctor->slab_metadata_commited_size = 0;
+		alctor->slabs_count = 0;
+		alctor->free_slab_head_id = 0;
+		das_zero_array(alctor->partial_slab_head_ids);
+	} else if (!ptr) {
+		// allocate
+		uintptr_t class_size = das_max_u(das_max_u(size, align), DasSlabAlctor_min_size);
+		if (class_size > DasSlabAlctor_max_size)
+			return NULL;
+
+		uint32_t class_idx = das_most_set_bit_idx(class_size - 1) + 1 - das_most_set_bit_idx((uintptr_t)DasSlabAlctor_min_size);
+		class_size = (uintptr_t)DasSlabAlctor_min_size << class_idx;
+
+		uint32_t slab_id = alctor->partial_slab_head_ids[class_idx];
+		if (!slab_id) {
+			slab_id = _DasSlabAlctor_take_slab(alctor);
+			if (!slab_id) return NULL;
+
+			//
+			// initialize the new slab for the size class and mark the bits past the number of blocks as allocated.
+			_DasSlab* slab = _DasSlabAlctor_slab(alctor, slab_id);
+			uint32_t blocks_count = alctor->slab_size / class_size;
+			slab->used_count = 0;
+			slab->blocks_count = blocks_count;
+			slab->class_idx = class_idx;
+			uint32_t words_count = _DasSlabAlctor_bitmap_words_count(alctor);
+			for (uint32_t i = 0; i < words_count; i += 1) {
+				uint32_t first_bit_idx = i * 64;
+				if (first_bit_idx >= blocks_count) {
+					slab->bitmap[i] = UINT64_MAX;
+				} else if (blocks_count - first_bit_idx < 64) {
+					slab->bitmap[i] = UINT64_MAX << (blocks_count - first_bit_idx);
+				} else {
+					slab->bitmap[i] = 0;
+				}
+			}
+
+			_DasSlabAlctor_partial_push(alctor, class_idx, slab_id);
+		}
+
+		//
+		// find the first free block in the bitmap.
+		// slabs in the partial list are guaranteed to have one.
+		_DasSlab* slab = _DasSlabAlctor_slab(alctor, slab_id);
+		uint32_t word_idx = 0;
+		while (slab->bitmap[word_idx] == UINT64_MAX) {
+			word_idx += 1;
+		}
+		uint32_t bit_idx = das_least_set_bit_idx(~slab->bitmap[word_idx]);
+		slab->bitmap[word_idx] |= (uint64_t)1 << bit_idx;
+		slab->used_count += 1;
+
+		if (slab->used_count == slab->blocks_count) {
+			_DasSlabAlctor_partial_remove(alctor, class_idx, slab_id);
+		}
+
+		uintptr_t block_idx = word_idx * 64 + bit_idx;
+		return das_ptr_add(_DasSlabAlctor_slab_memory(alctor, slab_id), block_idx * class_size);
+	} else if (ptr && size > 0) {
+		// reallocate
+		uint32_t slab_id = das_ptr_diff(ptr, alctor->address_space) / alctor->slab_size + 1;
+		uintptr_t old_class_size = (uintptr_t)DasSlabAlctor_min_size << _DasSlabAlctor_slab(alctor, slab_id)->class_idx;
+		if (das_max_u(size, align) <= old_class_size) {
+			return ptr;
+		}
+
+		void* new_ptr = DasSlabAlctor_alloc_fn(alctor, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		DasSlabAlctor_alloc_fn(alctor, ptr, old_size, 0, align);
+		return new_ptr;
+	} else {
+		// deallocate
+		das_debug_assert(alctor->address_space <= ptr && ptr < das_ptr_add(alctor->address_space, (uintptr_t)alctor->slabs_count * alctor->slab_size), "pointer was not allocated with this slab allocator");
+		uint32_t slab_id = das_ptr_diff(ptr, alctor->address_space) / alctor->slab_size + 1;
+		_DasSlab* slab = _DasSlabAlctor_slab(alctor, slab_id);
+		uint32_t class_idx = slab->class_idx;
+		uintptr_t class_size = (uintptr_t)DasSlabAlctor_min_size << class_idx;
+		uintptr_t block_idx = das_ptr_diff(ptr, _DasSlabAlctor_slab_memory(alctor, slab_id)) / class_size;
+
+		uint64_t bit = (uint64_t)1 << (block_idx % 64);
+		das_debug_assert(slab->bitmap[block_idx / 64] & bit, "double free detected in the slab allocator");
+
+		//
+		// the slab was full so it is not in the partial list, put it back in now it has a free block.
+		if (slab->used_count == slab->blocks_count) {
+			_DasSlabAlctor_partial_push(alctor, class_idx, slab_id);
+		}
+
+		slab->bitmap[block_idx / 64] &= ~bit;
+		slab->used_count -= 1;
+
+		//
+		// give an empty slab back to the OS, unless it is the only slab with free blocks in this size class.
+		if (slab->used_count == 0 && (slab->prev_id || slab->next_id)) {
+			_DasSlabAlctor_partial_remove(alctor, class_idx, slab_id);
+
+			DasError error = das_virt_mem_decommit(_DasSlabAlctor_slab_memory(alctor, slab_id), alctor->slab_size);
+			das_assert(error == 0, "failed to decommit an empty slab: 0x%x", error);
+
+			slab->next_id = alctor->free_slab_head_id;
+			alctor->free_slab_head_id = slab_id;
+		}
+		return NULL;
+	}
+
+	return NULL;
+}
+
+DasBool DasSlabAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasSlabAlctor* alctor = (DasSlabAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			return das_false;
+		case DasAllocExtOp_usable_size: {
+			uint32_t slab_id = das_ptr_diff(args->ptr, alctor->address_space) / alctor->slab_size + 1;
+			args->size = (uintptr_t)DasSlabAlctor_min_size << _DasSlabAlctor_slab(alctor, slab_id)->class_idx;
+			return das_true;
+		}
+		case DasAllocExtOp_owns:
+			args->count = args->ptr >= alctor->address_space && args->ptr < das_ptr_add(alctor->address_space, (uintptr_t)alctor->slabs_count * alctor->slab_size);
+			return das_true;
+	}
+
+	return das_false;
+}
+
+// ===========================================================================
+//
+//
+// TLSF Allocator
+//
+//
+// ===========================================================================
+
+#define _das_tlsf_align 16
+#define _das_tlsf_align_log2 4
+#define _das_tlsf_fl_shift (DasTlsfAlctor_sl_count_log2 + _das_tlsf_align_log2)
+// blocks smaller than this all live in the first level and the second level is linear in _das_tlsf_align steps.
+#define _das_tlsf_small_block_size ((uintptr_t)1 << _das_tlsf_fl_shift)
+#define _das_tlsf_block_header_size 16
+// a free block needs enough room for the free list links
+#define _das_tlsf_block_min_size 16
+#define _das_tlsf_block_free_bit 0x1
+#define _das_tlsf_block_prev_free_bit 0x2
+#define _das_tlsf_block_flags_mask 0x3
+
+struct _DasTlsfBlock {
+	// points to the previous block in memory, only valid when the previous block is free.
+	_DasTlsfBlock* prev_phys;
+	// the size in bytes of the block's payload that comes after the header.
+	// the bottom bits hold the _das_tlsf_block_*_bit flags.
+	uintptr_t size;
+
+	// the payload starts here, so these are only valid when the block is free.
+	_DasTlsfBlock* next_free;
+	_DasTlsfBlock* prev_free;
+};
+
+static inline uintptr_t _DasTlsfBlock_size(_DasTlsfBlock* block) {
+	return block->size & ~(uintptr_t)_das_tlsf_block_flags_mask;
+}
+
+static inline void* _DasTlsfBlock_payload(_DasTlsfBlock* block) {
+	return das_ptr_add(block, _das_tlsf_block_header_size);
+}
+
+static inline _DasTlsfBlock* _DasTlsfBlock_from_payload(void* ptr) {
+	return das_ptr_sub(ptr, _das_tlsf_block_header_size);
+}
+
+static inline _DasTlsfBlock* _DasTlsfBlock_next_phys(_DasTlsfBlock* block) {
+	return das_ptr_add(_DasTlsfBlock_payload(block), _DasTlsfBlock_size(block));
+}
+
+static inline void _DasTlsfBlock_mark_free(_DasTlsfBlock* block) {
+	block->size |= _das_tlsf_block_free_bit;
+	_DasTlsfBlock* next = _DasTlsfBlock_next_phys(block);
+	next->prev_phys = block;
+	next->size |= _das_tlsf_block_prev_free_bit;
+}
+
+static inline void _DasTlsfBlock_mark_used(_DasTlsfBlock* block) {
+	block->size &= ~(uintptr_t)_das_tlsf_block_free_bit;
+	_DasTlsfBlock_next_phys(block)->size &= ~(uintptr_t)_das_tlsf_block_prev_free_bit;
+}
+
+//
+// gets the first and second level indices of the list that a block of @param(size) belongs in.
+static inline void _DasTlsfAlctor_mapping(uintptr_t size, uint32_t* fl_out, uint32_t* sl_out) {
+	if (size < _das_tlsf_small_block_size) {
+		*fl_out = 0;
+		*sl_out = size / (_das_tlsf_small_block_size / DasTlsfAlctor_sl_count);
+	} else {
+		uint32_t msb = das_most_set_bit_idx(size);
+		*sl_out = (size >> (msb - DasTlsfAlctor_sl_count_log2)) ^ DasTlsfAlctor_sl_count;
+		*fl_out = msb - (_das_tlsf_fl_shift - 1);
+	}
+}
+
+//
+// gets the first and second level indices of the first list where every block is atleast @param(size).
+static inline void _DasTlsfAlctor_mapping_search(uintptr_t size, uint32_t* fl_out, uint32_t* sl_out) {
+	if (size >= _das_tlsf_small_block_size) {
+		size += ((uintptr_t)1 << (das_most_set_bit_idx(size) - DasTlsfAlctor_sl_count_log2)) - 1;
+	}
+	_DasTlsfAlctor_mapping(size, fl_out, sl_out);
+}
+
+static void _DasTlsfAlctor_insert(DasTlsfAlctor* alctor, _DasTlsfBlock* block) {
+	uint32_t fl, sl;
+	_DasTlsfAlctor_mapping(_DasTlsfBlock_size(block), &fl, &sl);
+
+	_DasTlsfBlock* head = alctor->free_list_heads[fl][sl];
+	block->next_free = head;
+	block->prev_free = NULL;
+	if (head) head->prev_free = block;
+	alctor->free_list_heads[fl][sl] = block;
+
+	alctor->fl_bitmap |= 1u << fl;
+	alctor->sl_bitmaps[fl] |= 1u << sl;
+}
+
+static void _DasTlsfAlctor_remove(DasTlsfAlctor* alctor, _DasTlsfBlock* block) {
+	uint32_t fl, sl;
+	_DasTlsfAlctor_mapping(_DasTlsfBlock_size(block), &fl, &sl);
+
+	if (block->prev_free) {
+		block->prev_free->next_free = block->next_free;
+	} else {
+		alctor->free_list_heads[fl][sl] = block->next_free;
+		if (!block->next_free) {
+			alctor->sl_bitmaps[fl] &= ~(1u << sl);
+			if (!alctor->sl_bitmaps[fl]) {
+				alctor->fl_bitmap &= ~(1u << fl);
+			}
+		}
+	}
+
+	if (block->next_free) {
+		block->next_free->prev_free = block->prev_free;
+	}
+}
+
+//
+// finds a free block that has atleast @param(size) bytes in O(1) using the bitmaps.
+// returns NULL if there is none.
+static _DasTlsfBlock* _DasTlsfAlctor_find_free(DasTlsfAlctor* alctor, uintptr_t size) {
+	uint32_t fl, sl;
+	_DasTlsfAlctor_mapping_search(size, &fl, &sl);
+	if (fl >= DasTlsfAlctor_fl_count) return NULL;
+
+	//
+	// look for a list in the same first level that is the same size or bigger.
+	// if there are none, then take the smallest list from the next non empty first level.
+	uint32_t sl_map = alctor->sl_bitmaps[fl] & (~0u << sl);
+	if (!sl_map) {
+		uint32_t fl_map = fl + 1 < 32 ? alctor->fl_bitmap & (~0u << (fl + 1)) : 0;
+		if (!fl_map) return NULL;
+
+		fl = das_least_set_bit_idx(fl_map);
+		sl_map = alctor->sl_bitmaps[fl];
+	}
+	sl = das_least_set_bit_idx(sl_map);
+
+	return alctor->free_list_heads[fl][sl];
+}
+
+//
+// splits the end of @param(block) off into a new block, so @param(block) has a payload of @param(size).
+// the new block has no flags set, it is up to the caller to set them.
+static _DasTlsfBlock* _DasTlsfBlock_split(_DasTlsfBlock* block, uintptr_t size) {
+	_DasTlsfBlock* remaining = das_ptr_add(_DasTlsfBlock_payload(block), size);
+	remaining->size = _DasTlsfBlock_size(block) - size - _das_tlsf_block_header_size;
+	block->size = size | (block->size & _das_tlsf_block_flags_mask);
+	return remaining;
+}
+
+//
+// merges @param(block) with the block after it, if that block is free.
+static _DasTlsfBlock* _DasTlsfAlctor_merge_next(DasTlsfAlctor* alctor, _DasTlsfBlock* block) {
+	_DasTlsfBlock* next = _DasTlsfBlock_next_phys(block);
+	if (next->size & _das_tlsf_block_free_bit) {
+		_DasTlsfAlctor_remove(alctor, next);
+		block->size += _das_tlsf_block_header_size + _DasTlsfBlock_size(next);
+	}
+	return block;
+}
 
-	return DasError_success;
+//
+// merges @param(block) with the block before it, if that block is free.
+static _DasTlsfBlock* _DasTlsfAlctor_merge_prev(DasTlsfAlctor* alctor, _DasTlsfBlock* block) {
+	if (block->size & _das_tlsf_block_prev_free_bit) {
+		_DasTlsfBlock* prev = block->prev_phys;
+		_DasTlsfAlctor_remove(alctor, prev);
+		prev->size += _das_tlsf_block_header_size + _DasTlsfBlock_size(block);
+		block = prev;
+	}
+	return block;
 }
 
-DasError das_file_close(DasFileHandle handle) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	if (close(handle.raw) != 0)
-		return _das_get_last_error();
-#elif _WIN32
-	if (CloseHandle(handle.raw) == 0)
-		return _das_get_last_error();
-#else
-#error "unimplemented file API for this platform"
-#endif
+//
+// shrinks a used block down to @param(size) and gives the rest back to the free lists if it is big enough to be a block.
+static void _DasTlsfAlctor_trim_used(DasTlsfAlctor* alctor, _DasTlsfBlock* block, uintptr_t size) {
+	if (_DasTlsfBlock_size(block) < size + _das_tlsf_block_header_size + _das_tlsf_block_min_size)
+		return;
+
+	_DasTlsfBlock* remaining = _DasTlsfBlock_split(block, size);
+	remaining = _DasTlsfAlctor_merge_next(alctor, remaining);
+	_DasTlsfBlock_mark_free(remaining);
+	_DasTlsfAlctor_insert(alctor, remaining);
+}
 
-	return DasError_success;
+//
+// commits enough memory at the end of the commited memory so a free block of atleast @param(size) can be found.
+// the new memory is turned into a free block that takes the place of the sentinel block at the end.
+static DasBool _DasTlsfAlctor_commit_next_chunk(DasTlsfAlctor* alctor, uintptr_t size) {
+	if (alctor->commited_size == alctor->reserved_size) {
+		return das_false;
+	}
+
+	//
+	// make sure we commit enough to pass the round up in _DasTlsfAlctor_mapping_search
+	// and room for the block header and the sentinel block header.
+	uintptr_t needed_size = size + (size >> DasTlsfAlctor_sl_count_log2) + _das_tlsf_block_header_size * 2;
+	uintptr_t grow_size = das_round_up_nearest_multiple_u(needed_size, alctor->commit_grow_size);
+	grow_size = das_min_u(grow_size, alctor->reserved_size - alctor->commited_size);
+
+	void* next_pages_start = das_ptr_add(alctor->address_space, alctor->commited_size);
+	DasError error = das_virt_mem_commit(next_pages_start, grow_size, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "failed to commit memory next_pages_start(%p), grow_size(%zu), error_code(0x%x)",
+		next_pages_start, grow_size, error);
+
+	//
+	// the old sentinel block becomes the new free block.
+	// if this is the first chunk then the new block goes at the start.
+	_DasTlsfBlock* block;
+	if (alctor->commited_size == 0) {
+		block = alctor->address_space;
+		block->prev_phys = NULL;
+		block->size = 0;
+	} else {
+		block = das_ptr_add(alctor->address_space, alctor->commited_size - _das_tlsf_block_header_size);
+	}
+	alctor->commited_size += grow_size;
+
+	_DasTlsfBlock* sentinel = das_ptr_add(alctor->address_space, alctor->commited_size - _das_tlsf_block_header_size);
+	block->size = das_ptr_diff(sentinel, _DasTlsfBlock_payload(block)) | (block->size & _das_tlsf_block_prev_free_bit);
+	sentinel->size = 0;
+
+	block = _DasTlsfAlctor_merge_prev(alctor, block);
+	_DasTlsfBlock_mark_free(block);
+	_DasTlsfAlctor_insert(alctor, block);
+	return das_true;
 }
 
-DasError das_file_size(DasFileHandle handle, uint64_t* size_out) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	// get the size of the file
-	struct stat s = {0};
-	if (fstat(handle.raw, &s) != 0) return _das_get_last_error();
-	*size_out = s.st_size;
-#elif _WIN32
-	LARGE_INTEGER size;
-	if (!GetFileSizeEx(handle.raw, &size)) return _das_get_last_error();
-	*size_out = size.QuadPart;
-#else
-#error "unimplemented file API for this platform"
-#endif
+//
+// finds a free block of atleast @param(size) bytes and removes it from the free lists.
+// commits more memory if there is none.
+static _DasTlsfBlock* _DasTlsfAlctor_take_free(DasTlsfAlctor* alctor, uintptr_t size) {
+	if (size >= alctor->reserved_size) return NULL;
+	while (1) {
+		_DasTlsfBlock* block = _DasTlsfAlctor_find_free(alctor, size);
+		if (block) {
+			_DasTlsfAlctor_remove(alctor, block);
+			return block;
+		}
+
+		if (!_DasTlsfAlctor_commit_next_chunk(alctor, size))
+			return NULL;
+	}
+}
+
+static inline uintptr_t _DasTlsfAlctor_adjust_size(uintptr_t size) {
+	return das_round_up_nearest_multiple_u(das_max_u(size, _das_tlsf_block_min_size), _das_tlsf_align);
+}
+
+DasError DasTlsfAlctor_init(DasTlsfAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size) {
+	das_zero_elmt(alctor);
+
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
+
+	// reserved_size must be a multiple of the reserve_align.
+	// commit_grow_size must be multiple of the page size.
+	commit_grow_size = das_round_up_nearest_multiple_u(commit_grow_size, page_size);
+	reserved_size = das_round_up_nearest_multiple_u(reserved_size, reserve_align);
+	das_assert(reserved_size < (uintptr_t)1 << (DasTlsfAlctor_fl_count + _das_tlsf_fl_shift - 1),
+		"reserved_size of %zu is too large for the TLSF allocator", reserved_size);
+
+	void* address_space;
+	error = das_virt_mem_reserve(NULL, reserved_size, &address_space);
+	if (error) return error;
+
+	alctor->address_space = address_space;
+	alctor->commit_grow_size = commit_grow_size;
+	alctor->reserved_size = reserved_size;
 	return DasError_success;
 }
 
-DasError das_file_read(DasFileHandle handle, void* data_out, uintptr_t length, uintptr_t* bytes_read_out) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	ssize_t bytes_read = read(handle.raw, data_out, length);
-	if (bytes_read == (ssize_t)-1)
-		return _das_get_last_error();
-#elif _WIN32
-	length = das_min_u(length, UINT32_MAX);
-	DWORD bytes_read;
-	if (ReadFile(handle.raw, data_out, length, &bytes_read, NULL) == 0)
-		return _das_get_last_error();
-#else
-#error "unimplemented file API for this platform"
-#endif
+DasError DasTlsfAlctor_deinit(DasTlsfAlctor* alctor) {
+	DasError error = das_virt_mem_release(alctor->address_space, alctor->reserved_size);
+	if (error) return error;
 
-	*bytes_read_out = bytes_read;
+	das_zero_elmt(alctor);
 	return DasError_success;
 }
 
-DasError das_file_read_exact(DasFileHandle handle, void* data_out, uintptr_t length, uintptr_t* bytes_read_out) {
-	uintptr_t og_length = length;
-	while (length) {
-		uintptr_t bytes_read;
-		DasError error = das_file_read(handle, data_out, length, &bytes_read);
-		if (error) return error;
+void* DasTlsfAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasTlsfAlctor* alctor = (DasTlsfAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset by decommiting the memory back to the OS but retaining the reserved address space.
+		if (alctor->commited_size) {
+			DasError error = das_virt_mem_decommit(alctor->address_space, alctor->commited_size);
+			das_assert(error == 0, "failed to decommit memory address_space(%p), commited_size(%zu)",
+				alctor->address_space, alctor->commited_size);
+		}
 
-		if (bytes_read == 0)
-			break;
+		alctor->commited_size = 0;
+		alctor->fl_bitmap = 0;
+		das_zero_array(alctor->sl_bitmaps);
+		das_zero_array(alctor->free_list_heads);
+	} else if (!ptr) {
+		// allocate
+		size = _DasTlsfAlctor_adjust_size(size);
+		_DasTlsfBlock* block;
+		if (align <= _das_tlsf_align) {
+			block = _DasTlsfAlctor_take_free(alctor, size);
+			if (!block) return NULL;
+		} else {
+			//
+			// find a block big enough that we can split off the front of it
+			// to get the payload aligned and still have a valid free block at the front.
+			uintptr_t gap_min_size = _das_tlsf_block_header_size + _das_tlsf_block_min_size;
+			block = _DasTlsfAlctor_take_free(alctor, size + align + gap_min_size);
+			if (!block) return NULL;
+
+			void* payload = _DasTlsfBlock_payload(block);
+			void* aligned_payload = das_ptr_round_up_align(payload, align);
+			uintptr_t gap = das_ptr_diff(aligned_payload, payload);
+			if (gap && gap < gap_min_size) {
+				aligned_payload = das_ptr_round_up_align(das_ptr_add(payload, gap_min_size), align);
+				gap = das_ptr_diff(aligned_payload, payload);
+			}
 
-		data_out = das_ptr_add(data_out, bytes_read);
-		length -= bytes_read;
+			if (gap) {
+				//
+				// the front stays as a free block and the aligned block comes after it.
+				_DasTlsfBlock* aligned_block = _DasTlsfBlock_split(block, gap - _das_tlsf_block_header_size);
+				aligned_block->size |= _das_tlsf_block_prev_free_bit;
+				aligned_block->prev_phys = block;
+				_DasTlsfAlctor_insert(alctor, block);
+				block = aligned_block;
+			}
+		}
+
+		_DasTlsfAlctor_trim_used(alctor, block, size);
+		_DasTlsfBlock_mark_used(block);
+		return _DasTlsfBlock_payload(block);
+	} else if (ptr && size > 0) {
+		// reallocate
+		_DasTlsfBlock* block = _DasTlsfBlock_from_payload(ptr);
+		uintptr_t adjusted_size = _DasTlsfAlctor_adjust_size(size);
+		if (adjusted_size <= _DasTlsfBlock_size(block)) {
+			_DasTlsfAlctor_trim_used(alctor, block, adjusted_size);
+			return ptr;
+		}
+
+		//
+		// if we are the last block or only have a free block after us that is too small,
+		// then commit more memory so the next block becomes a free block that is big enough.
+		_DasTlsfBlock* next = _DasTlsfBlock_next_phys(block);
+		_DasTlsfBlock* sentinel = das_ptr_add(alctor->address_space, alctor->commited_size - _das_tlsf_block_header_size);
+		if (next == sentinel) {
+			_DasTlsfAlctor_commit_next_chunk(alctor, adjusted_size - _DasTlsfBlock_size(block));
+		} else if ((next->size & _das_tlsf_block_free_bit) && _DasTlsfBlock_next_phys(next) == sentinel) {
+			uintptr_t merged_size = _DasTlsfBlock_size(block) + _das_tlsf_block_header_size + _DasTlsfBlock_size(next);
+			if (merged_size < adjusted_size) {
+				_DasTlsfAlctor_commit_next_chunk(alctor, adjusted_size - _DasTlsfBlock_size(block));
+			}
+		}
+
+		//
+		// try to grow in place by merging with the next block if it is free and big enough.
+		if (next->size & _das_tlsf_block_free_bit) {
+			uintptr_t merged_size = _DasTlsfBlock_size(block) + _das_tlsf_block_header_size + _DasTlsfBlock_size(next);
+			if (adjusted_size <= merged_size) {
+				_DasTlsfAlctor_merge_next(alctor, block);
+				_DasTlsfBlock_mark_used(block);
+				_DasTlsfAlctor_trim_used(alctor, block, adjusted_size);
+				return ptr;
+			}
+		}
+
+		// if we cannot extend in place, then just allocate a new block.
+		void* new_ptr = DasTlsfAlctor_alloc_fn(alctor, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		DasTlsfAlctor_alloc_fn(alctor, ptr, old_size, 0, align);
+		return new_ptr;
+	} else {
+		// deallocate
+		_DasTlsfBlock* block = _DasTlsfBlock_from_payload(ptr);
+		das_debug_assert(!(block->size & _das_tlsf_block_free_bit), "double free detected in the TLSF allocator");
+
+		block = _DasTlsfAlctor_merge_prev(alctor, block);
+		block = _DasTlsfAlctor_merge_next(alctor, block);
+		_DasTlsfBlock_mark_free(block);
+		_DasTlsfAlctor_insert(alctor, block);
+		return NULL;
 	}
 
-	*bytes_read_out = og_length - length;
-	return DasError_success;
+	return NULL;
 }
 
-DasError das_file_write(DasFileHandle handle, void* data, uintptr_t length, uintptr_t* bytes_written_out) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	ssize_t bytes_written = write(handle.raw, data, length);
-	if (bytes_written == (ssize_t)-1)
-		return _das_get_last_error();
-#elif _WIN32
-	length = das_min_u(length, UINT32_MAX);
-	DWORD bytes_written;
-	if (WriteFile(handle.raw, data, length, &bytes_written, NULL) == 0)
-		return _das_get_last_error();
-#else
-#error "unimplemented file API for this platform"
-#endif
+DasBool DasTlsfAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasTlsfAlctor* alctor = (DasTlsfAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			return das_false;
+		case DasAllocExtOp_usable_size:
+			args->size = _DasTlsfBlock_size(_DasTlsfBlock_from_payload(args->ptr));
+			return das_true;
+		case DasAllocExtOp_owns:
+			args->count = args->ptr >= alctor->address_space && args->ptr < das_ptr_add(alctor->address_space, alctor->commited_size);
+			return das_true;
+	}
 
-	*bytes_written_out = bytes_written;
-	return DasError_success;
+	return das_false;
 }
 
-DasError das_file_write_exact(DasFileHandle handle, void* data, uintptr_t length, uintptr_t* bytes_written_out) {
-	uintptr_t og_length = length;
-	while (length) {
-		uintptr_t bytes_written;
-		DasError error = das_file_write(handle, data, length, &bytes_written);
-		if (error) return error;
+// ===========================================================================
+//
+//
+// Buddy Allocator
+//
+//
+// ===========================================================================
 
-		if (bytes_written == 0)
-			break;
+//
+// the internal metadata for a block that is stored outside of the block's memory.
+// there is one of these for every page, but only the one for the first page of a block is used.
+typedef struct _DasBuddyBlock _DasBuddyBlock;
+struct _DasBuddyBlock {
+	uint32_t prev_id;
+	uint32_t next_id;
+	uint8_t order;
+	uint8_t is_free;
+};
+
+static inline _DasBuddyBlock* _DasBuddyAlctor_block(DasBuddyAlctor* alctor, uint32_t block_id) {
+	uintptr_t pages_size = (uintptr_t)alctor->pages_count << alctor->page_size_log2;
+	return das_ptr_add(alctor->address_space, pages_size + (uintptr_t)(block_id - 1) * sizeof(_DasBuddyBlock));
+}
 
-		data = das_ptr_add(data, bytes_written);
-		length -= bytes_written;
+static inline void* _DasBuddyAlctor_block_memory(DasBuddyAlctor* alctor, uint32_t block_id) {
+	return das_ptr_add(alctor->address_space, (uintptr_t)(block_id - 1) << alctor->page_size_log2);
+}
+
+static inline uint32_t _DasBuddyAlctor_block_id(DasBuddyAlctor* alctor, void* ptr) {
+	return (das_ptr_diff(ptr, alctor->address_space) >> alctor->page_size_log2) + 1;
+}
+
+//
+// returns the smallest order where a block can hold @param(size) bytes.
+static inline uint32_t _DasBuddyAlctor_order(DasBuddyAlctor* alctor, uintptr_t size) {
+	uintptr_t pages_count = (size + alctor->page_size - 1) >> alctor->page_size_log2;
+	if (pages_count <= 1) return 0;
+	return das_most_set_bit_idx(pages_count - 1) + 1;
+}
+
+static void _DasBuddyAlctor_free_push(DasBuddyAlctor* alctor, uint32_t order, uint32_t block_id) {
+	_DasBuddyBlock* block = _DasBuddyAlctor_block(alctor, block_id);
+	uint32_t head_id = alctor->free_block_head_ids[order];
+	if (head_id) {
+		_DasBuddyAlctor_block(alctor, head_id)->prev_id = block_id;
 	}
+	block->prev_id = 0;
+	block->next_id = head_id;
+	block->order = order;
+	block->is_free = das_true;
+	alctor->free_block_head_ids[order] = block_id;
+}
 
-	*bytes_written_out = og_length - length;
-	return DasError_success;
+static void _DasBuddyAlctor_free_remove(DasBuddyAlctor* alctor, uint32_t block_id) {
+	_DasBuddyBlock* block = _DasBuddyAlctor_block(alctor, block_id);
+	if (block->prev_id) {
+		_DasBuddyAlctor_block(alctor, block->prev_id)->next_id = block->next_id;
+	} else {
+		alctor->free_block_head_ids[block->order] = block->next_id;
+	}
+
+	if (block->next_id) {
+		_DasBuddyAlctor_block(alctor, block->next_id)->prev_id = block->prev_id;
+	}
+	block->prev_id = 0;
+	block->next_id = 0;
+	block->is_free = das_false;
 }
 
-DasError das_file_seek(DasFileHandle handle, int64_t offset, DasFileSeekFrom from, uint64_t* cursor_offset_out) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	int whence = 0;
-	switch (from) {
-		case DasFileSeekFrom_start: whence = SEEK_SET; break;
-		case DasFileSeekFrom_current: whence = SEEK_CUR; break;
-		case DasFileSeekFrom_end: whence = SEEK_END; break;
+//
+// takes a free block of @param(order), splitting a larger block in half until there is one.
+// returns 0 if there is no free block big enough.
+static uint32_t _DasBuddyAlctor_take_free(DasBuddyAlctor* alctor, uint32_t order) {
+	uint32_t found_order = order;
+	while (!alctor->free_block_head_ids[found_order]) {
+		found_order += 1;
+		if (found_order > alctor->max_order)
+			return 0;
 	}
-	off_t cursor_offset = lseek(handle.raw, offset, whence);
-	if (cursor_offset == (off_t)-1)
-		return _das_get_last_error();
-	*cursor_offset_out = cursor_offset;
-#elif _WIN32
-	int move_method = 0;
-	switch (from) {
-		case DasFileSeekFrom_start: move_method = FILE_BEGIN; break;
-		case DasFileSeekFrom_current: move_method = FILE_CURRENT; break;
-		case DasFileSeekFrom_end: move_method = FILE_END; break;
+
+	uint32_t block_id = alctor->free_block_head_ids[found_order];
+	_DasBuddyAlctor_free_remove(alctor, block_id);
+
+	//
+	// split the block in half, and put the upper half in the free list,
+	// until the lower half is the order we want.
+	while (found_order > order) {
+		found_order -= 1;
+		_DasBuddyAlctor_free_push(alctor, found_order, block_id + (1u << found_order));
 	}
-	LARGE_INTEGER distance_to_move;
-	distance_to_move.QuadPart = offset;
-	LARGE_INTEGER new_offset = {0};
 
-	if (!SetFilePointerEx(handle.raw, distance_to_move, &new_offset, move_method))
-		return _das_get_last_error();
+	_DasBuddyAlctor_block(alctor, block_id)->order = order;
+	return block_id;
+}
+
+//
+// decommits the block and gives it back to the free lists,
+// merging it with it's buddy for as long as it's buddy is free.
+static void _DasBuddyAlctor_free_block(DasBuddyAlctor* alctor, uint32_t block_id, uint32_t order) {
+	DasError error = das_virt_mem_decommit(_DasBuddyAlctor_block_memory(alctor, block_id), alctor->page_size << order);
+	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+
+	while (order < alctor->max_order) {
+		uint32_t buddy_id = ((block_id - 1) ^ (1u << order)) + 1;
+		_DasBuddyBlock* buddy = _DasBuddyAlctor_block(alctor, buddy_id);
+		if (!buddy->is_free || buddy->order != order)
+			break;
+
+		_DasBuddyAlctor_free_remove(alctor, buddy_id);
+		block_id = das_min_u(block_id, buddy_id);
+		order += 1;
+	}
+
+	_DasBuddyAlctor_free_push(alctor, order, block_id);
+}
+
+//
+// commits the pages of a block that are needed to go from @param(old_size) to @param(size)
+static void _DasBuddyAlctor_commit_grow(DasBuddyAlctor* alctor, void* ptr, uintptr_t old_size, uintptr_t size) {
+	uintptr_t commited_size = das_round_up_nearest_multiple_u(old_size, alctor->page_size);
+	uintptr_t needed_size = das_round_up_nearest_multiple_u(size, alctor->page_size);
+	if (needed_size <= commited_size)
+		return;
+
+	DasError error = das_virt_mem_commit(das_ptr_add(ptr, commited_size), needed_size - commited_size, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+}
+
+static void _DasBuddyAlctor_reset_metadata(DasBuddyAlctor* alctor) {
+	das_zero_array(alctor->free_block_head_ids);
+	_DasBuddyAlctor_free_push(alctor, alctor->max_order, 1);
+}
+
+DasError DasBuddyAlctor_init(DasBuddyAlctor* alctor, uintptr_t reserved_size) {
+	das_zero_elmt(alctor);
+
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
+
+	//
+	// the whole address space is a single block at the start, so it must be a power of two.
+	uintptr_t pages_size = das_round_up_nearest_multiple_u(reserved_size, reserve_align);
+	uintptr_t pages_count = pages_size / page_size;
+	uint32_t max_order = pages_count <= 1 ? 0 : das_most_set_bit_idx(pages_count - 1) + 1;
+	das_assert(max_order < DasBuddyAlctor_orders_count, "reserved_size of %zu is too large for the buddy allocator", reserved_size);
+	pages_count = (uintptr_t)1 << max_order;
+	pages_size = pages_count * page_size;
+
+	//
+	// reserve the whole address space for the blocks and their metadata.
+	// the metadata is small compared to the blocks so it is all committed now.
+	uintptr_t metadata_size = das_round_up_nearest_multiple_u(pages_count * sizeof(_DasBuddyBlock), reserve_align);
+	error = das_virt_mem_reserve(NULL, pages_size + metadata_size, &alctor->address_space);
+	if (error) return error;
+
+	error = das_virt_mem_commit(das_ptr_add(alctor->address_space, pages_size), metadata_size, DasVirtMemProtection_read_write);
+	if (error) {
+		das_virt_mem_release(alctor->address_space, pages_size + metadata_size);
+		return error;
+	}
+
+	alctor->reserved_size = pages_size + metadata_size;
+	alctor->page_size = page_size;
+	alctor->page_size_log2 = das_most_set_bit_idx(page_size);
+	alctor->pages_count = pages_count;
+	alctor->max_order = max_order;
+	_DasBuddyAlctor_reset_metadata(alctor);
+	return DasError_success;
+}
+
+DasError DasBuddyAlctor_deinit(DasBuddyAlctor* alctor) {
+	DasError error = das_virt_mem_release(alctor->address_space, alctor->reserved_size);
+	if (error) return error;
+
+	das_zero_elmt(alctor);
+	return DasError_success;
+}
+
+void* DasBuddyAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasBuddyAlctor* alctor = (DasBuddyAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset by decommiting the memory back to the OS but retaining the reserved address space.
+		uintptr_t pages_size = (uintptr_t)alctor->pages_count << alctor->page_size_log2;
+		DasError error = das_virt_mem_decommit(alctor->address_space, pages_size);
+		das_assert(error == 0, "failed to decommit the blocks: 0x%x", error);
+
+		//
+		// decommit and commit the metadata again so the OS gives us back zeroed pages.
+		void* metadata = _DasBuddyAlctor_block(alctor, 1);
+		uintptr_t metadata_size = alctor->reserved_size - pages_size;
+		error = das_virt_mem_decommit(metadata, metadata_size);
+		das_assert(error == 0, "failed to decommit the block metadata: 0x%x", error);
+		error = das_virt_mem_commit(metadata, metadata_size, DasVirtMemProtection_read_write);
+		das_assert(error == 0, "failed to commit the block metadata: 0x%x", error);
+
+		_DasBuddyAlctor_reset_metadata(alctor);
+	} else if (!ptr) {
+		// allocate
+		if (align > alctor->page_size) return NULL;
+		uint32_t order = _DasBuddyAlctor_order(alctor, size);
+		if (order > alctor->max_order) return NULL;
+
+		uint32_t block_id = _DasBuddyAlctor_take_free(alctor, order);
+		if (!block_id) return NULL;
+
+		ptr = _DasBuddyAlctor_block_memory(alctor, block_id);
+		_DasBuddyAlctor_commit_grow(alctor, ptr, 0, size);
+		return ptr;
+	} else if (ptr && size > 0) {
+		// reallocate
+		uint32_t block_id = _DasBuddyAlctor_block_id(alctor, ptr);
+		_DasBuddyBlock* block = _DasBuddyAlctor_block(alctor, block_id);
+		uint32_t order = block->order;
+		uint32_t new_order = _DasBuddyAlctor_order(alctor, size);
+
+		if (new_order <= order) {
+			//
+			// split off the upper halves and give them back to the free lists.
+			// their buddy is the block we are keeping so they will not merge.
+			while (order > new_order) {
+				order -= 1;
+				_DasBuddyAlctor_free_block(alctor, block_id + (1u << order), order);
+			}
+			block->order = new_order;
 
-	*cursor_offset_out = new_offset.QuadPart;
-#else
-#error "unimplemented file API for this platform"
-#endif
-	return DasError_success;
+			_DasBuddyAlctor_commit_grow(alctor, ptr, old_size, size);
+			return ptr;
+		}
+
+		//
+		// we can grow in place if the block is the first block of the new order's block
+		// and every buddy that comes after the block up to the new order is free.
+		uint32_t block_idx = block_id - 1;
+		DasBool can_grow = new_order <= alctor->max_order && (block_idx & ((1u << new_order) - 1)) == 0;
+		for (uint32_t o = order; can_grow && o < new_order; o += 1) {
+			_DasBuddyBlock* buddy = _DasBuddyAlctor_block(alctor, block_id + (1u << o));
+			can_grow = buddy->is_free && buddy->order == o;
+		}
+
+		if (can_grow) {
+			for (uint32_t o = order; o < new_order; o += 1) {
+				_DasBuddyAlctor_free_remove(alctor, block_id + (1u << o));
+			}
+			block->order = new_order;
+
+			_DasBuddyAlctor_commit_grow(alctor, ptr, old_size, size);
+			return ptr;
+		}
+
+		// if we cannot extend in place, then just allocate a new block.
+		void* new_ptr = DasBuddyAlctor_alloc_fn(alctor, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		DasBuddyAlctor_alloc_fn(alctor, ptr, old_size, 0, align);
+		return new_ptr;
+	} else {
+		// deallocate
+		uint32_t block_id = _DasBuddyAlctor_block_id(alctor, ptr);
+		_DasBuddyBlock* block = _DasBuddyAlctor_block(alctor, block_id);
+		das_debug_assert(!block->is_free, "double free detected in the buddy allocator");
+		_DasBuddyAlctor_free_block(alctor, block_id, block->order);
+		return NULL;
+	}
+
+	return NULL;
 }
 
-DasError das_file_flush(DasFileHandle handle) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	if (fsync(handle.raw) != 0)
-		return _das_get_last_error();
-#elif _WIN32
-	if (FlushFileBuffers(handle.raw) == 0)
-		return _das_get_last_error();
-#else
-#error "unimplemented file API for this platform"
-#endif
-	return DasError_success;
+DasBool DasBuddyAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasBuddyAlctor* alctor = (DasBuddyAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			return das_false;
+		case DasAllocExtOp_usable_size:
+			args->size = das_round_up_nearest_multiple_u(args->old_size, alctor->page_size);
+			return das_true;
+		case DasAllocExtOp_owns:
+			args->count = args->ptr >= alctor->address_space && args->ptr < das_ptr_add(alctor->address_space, (uintptr_t)alctor->pages_count << alctor->page_size_log2);
+			return das_true;
+	}
+
+	return das_false;
 }
 
 // ===========================================================================
 //
 //
-// Virtual Memory Abstraction
+// Block Allocator
 //
 //
 // ===========================================================================
 
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-static int _das_virt_mem_prot_unix(DasVirtMemProtection prot) {
-	switch (prot) {
-		case DasVirtMemProtection_no_access: return 0;
-		case DasVirtMemProtection_read: return PROT_READ;
-		case DasVirtMemProtection_read_write: return PROT_READ | PROT_WRITE;
-		case DasVirtMemProtection_exec_read: return PROT_EXEC | PROT_READ;
-		case DasVirtMemProtection_exec_read_write: return PROT_READ | PROT_WRITE | PROT_EXEC;
-	}
-	return 0;
-}
-#elif _WIN32
-static DWORD _das_virt_mem_prot_windows(DasVirtMemProtection prot) {
-	switch (prot) {
-		case DasVirtMemProtection_no_access: return PAGE_NOACCESS;
-		case DasVirtMemProtection_read: return PAGE_READONLY;
-		case DasVirtMemProtection_read_write: return PAGE_READWRITE;
-		case DasVirtMemProtection_exec_read: return PAGE_EXECUTE_READ;
-		case DasVirtMemProtection_exec_read_write: return PAGE_EXECUTE_READWRITE;
-	}
-	return 0;
-}
-#else
-#error "unimplemented virtual memory API for this platform"
-#endif
+DasError DasBlockAlctor_init(DasBlockAlctor* alctor, uintptr_t block_size, uintptr_t block_align, uintptr_t reserved_cap, uintptr_t commit_grow_count) {
+	das_zero_elmt(alctor);
+	das_assert(das_is_power_of_two(block_align), "block_align must be a power of two but got %zu", block_align);
 
-DasError das_virt_mem_page_size(uintptr_t* page_size_out, uintptr_t* reserve_align_out) {
-#ifdef __linux__
-	long page_size = sysconf(_SC_PAGESIZE);
-	if (page_size ==  (long)-1)
-		return _das_get_last_error();
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	if (error) return error;
 
-	*page_size_out = page_size;
-	*reserve_align_out = page_size;
-#elif _WIN32
-	SYSTEM_INFO si;
-    GetNativeSystemInfo(&si);
-	*page_size_out = si.dwPageSize;
-	*reserve_align_out = si.dwAllocationGranularity;
-#else
-#error "unimplemented virtual memory API for this platform"
-#endif
+	//
+	// the free list pointer is stored in the block, so it needs to fit and be aligned.
+	block_align = das_max_u(block_align, alignof(void*));
+	block_size = das_round_up_nearest_multiple_u(das_max_u(block_size, sizeof(void*)), block_align);
+
+	//
+	// the address space is only aligned to the reserve alignment. so for larger block alignments,
+	// reserve the extra address space needed to align the first block and skip the unaligned start.
+	uintptr_t reserved_size = das_round_up_nearest_multiple_u(reserved_cap * block_size, reserve_align);
+	uintptr_t align_pad = block_align > reserve_align ? block_align - reserve_align : 0;
+	error = das_virt_mem_reserve(NULL, reserved_size + align_pad, &alctor->reserved_address_space);
+	if (error) return error;
 
+	alctor->address_space = das_ptr_round_up_align(alctor->reserved_address_space, block_align);
+	alctor->align_pad = align_pad;
+	alctor->block_size = block_size;
+	alctor->block_align = block_align;
+	alctor->commit_grow_size = das_round_up_nearest_multiple_u(das_max_u(commit_grow_count * block_size, 1), page_size);
+	alctor->reserved_size = reserved_size;
 	return DasError_success;
 }
 
-DasError das_virt_mem_reserve(void* requested_addr, uintptr_t size, void** addr_out) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	// memory is automatically commited on Unix based OSs,
-	// so we will restrict the memory from being accessed on reserved.
-	int prot = 0;
-
-	// MAP_ANON = means map physical memory and not a file. it also means the memory will be initialized to zero
-	// MAP_PRIVATE = keep memory private so child process cannot access them
-	// MAP_NORESERVE = do not reserve any swap space for this mapping
-	void* addr = mmap(requested_addr, size, prot, MAP_ANON | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
-	if (addr == MAP_FAILED)
-		return _das_get_last_error();
-#elif _WIN32
-	void* addr = VirtualAlloc(requested_addr, size, MEM_RESERVE, PAGE_NOACCESS);
-	if (addr == NULL)
-		return _das_get_last_error();
-#else
-#error "TODO implement virtual memory for this platform"
-#endif
+DasError DasBlockAlctor_deinit(DasBlockAlctor* alctor) {
+	DasError error = das_virt_mem_release(alctor->reserved_address_space, alctor->reserved_size + alctor->align_pad);
+	if (error) return error;
 
-	*addr_out = addr;
+	das_zero_elmt(alctor);
 	return DasError_success;
 }
 
-DasError das_virt_mem_commit(void* addr, uintptr_t size, DasVirtMemProtection protection) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	// memory is automatically commited on Unix based OSs,
-	// memory is restricted from being accessed in our das_virt_mem_reserve.
-	// so lets just apply the protection for the address space.
-	// and then advise the OS that these pages will be used soon.
-	int prot = _das_virt_mem_prot_unix(protection);
-	if (mprotect(addr, size, prot) != 0) return _das_get_last_error();
-	if (madvise(addr, size, MADV_WILLNEED) != 0) return _das_get_last_error();
-#elif _WIN32
-	DWORD prot = _das_virt_mem_prot_windows(protection);
-	if (VirtualAlloc(addr, size, MEM_COMMIT, prot) == NULL)
-		return _das_get_last_error();
-#else
-#error "TODO implement virtual memory for this platform"
-#endif
-	return DasError_success;
-}
+//
+// takes @param(count) blocks that have never been allocated, committing more memory if needed.
+// returns NULL if the reserved size has been exhausted.
+static void* _DasBlockAlctor_bump(DasBlockAlctor* alctor, uintptr_t count) {
+	uintptr_t next_pos = alctor->pos + count * alctor->block_size;
+	if (next_pos > alctor->reserved_size)
+		return NULL;
 
-DasError das_virt_mem_protection_set(void* addr, uintptr_t size, DasVirtMemProtection protection) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	int prot = _das_virt_mem_prot_unix(protection);
-	if (mprotect(addr, size, prot) != 0)
-		return _das_get_last_error();
-#elif _WIN32
-	DWORD prot = _das_virt_mem_prot_windows(protection);
-	DWORD old_prot; // unused
-	if (!VirtualProtect(addr, size, prot, &old_prot))
-		return _das_get_last_error();
-#else
-#error "TODO implement virtual memory for this platform"
-#endif
-	return DasError_success;
+	if (next_pos > alctor->commited_size) {
+		//
+		// commit the next chunks at the end of the currently commited blocks.
+		uintptr_t grow_size = das_round_up_nearest_multiple_u(next_pos - alctor->commited_size, alctor->commit_grow_size);
+		grow_size = das_min_u(grow_size, alctor->reserved_size - alctor->commited_size);
+		DasError error = das_virt_mem_commit(das_ptr_add(alctor->address_space, alctor->commited_size), grow_size, DasVirtMemProtection_read_write);
+		das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+		alctor->commited_size += grow_size;
+	}
+
+	void* ptr = das_ptr_add(alctor->address_space, alctor->pos);
+	alctor->pos = next_pos;
+	return ptr;
 }
 
-DasError das_virt_mem_decommit(void* addr, uintptr_t size) {
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+void* DasBlockAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasBlockAlctor* alctor = (DasBlockAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset by decommiting the memory back to the OS but retaining the reserved address space.
+		if (alctor->commited_size) {
+			DasError error = das_virt_mem_decommit(alctor->address_space, alctor->commited_size);
+			das_assert(error == 0, "failed to decommit the blocks: 0x%x", error);
+		}
 
-	//
-	// advise the OS that these pages will not be needed.
-	// the OS will zero fill these pages before you next access them.
-	if (madvise(addr, size, MADV_DONTNEED) != 0)
-		return _das_get_last_error();
+		alctor->free_list_head = NULL;
+		alctor->pos = 0;
+		alctor->commited_size = 0;
+	} else if (!ptr) {
+		// allocate
+		if (size > alctor->block_size || align > alctor->block_align)
+			return NULL;
 
-	// memory is automatically commited on Unix based OSs,
-	// so we will restrict the memory from being accessed when we "decommit.
-	int prot = 0;
-	if (mprotect(addr, size, prot) != 0)
-		return _das_get_last_error();
-#elif _WIN32
-	if (VirtualFree(addr, size, MEM_DECOMMIT) == 0)
-		return _das_get_last_error();
-#else
-#error "TODO implement virtual memory for this platform"
-#endif
-	return DasError_success;
+		ptr = alctor->free_list_head;
+		if (ptr) {
+			alctor->free_list_head = *(void**)ptr;
+			return ptr;
+		}
+
+		return _DasBlockAlctor_bump(alctor, 1);
+	} else if (ptr && size > 0) {
+		// reallocate
+		if (size > alctor->block_size || align > alctor->block_align)
+			return NULL;
+
+		return ptr;
+	} else {
+		// deallocate
+		das_debug_assert(alctor->address_space <= ptr && ptr < das_ptr_add(alctor->address_space, alctor->pos), "pointer was not allocated with this block allocator");
+		*(void**)ptr = alctor->free_list_head;
+		alctor->free_list_head = ptr;
+		return NULL;
+	}
+
+	return NULL;
 }
 
-DasError das_virt_mem_release(void* addr, uintptr_t size) {
-#ifdef __linux__
-	if (munmap(addr, size) != 0)
-		return _das_get_last_error();
-#elif _WIN32
-	//
-	// unfortunately on Windows all memory must be release at once
-	// that was reserved with VirtualAlloc.
-	if (!VirtualFree(addr, 0, MEM_RELEASE))
-		return _das_get_last_error();
-#else
-#error "TODO implement virtual memory for this platform"
-#endif
-	return DasError_success;
+DasBool DasBlockAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasBlockAlctor* alctor = (DasBlockAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			return args->size <= alctor->block_size;
+		case DasAllocExtOp_usable_size:
+			args->size = alctor->block_size;
+			return das_true;
+		case DasAllocExtOp_alloc_batch: {
+			if (args->size > alctor->block_size || args->align > alctor->block_align) {
+				args->count = 0;
+				return das_true;
+			}
+
+			uintptr_t i = 0;
+			for (; i < args->count && alctor->free_list_head; i += 1) {
+				void* ptr = alctor->free_list_head;
+				alctor->free_list_head = *(void**)ptr;
+				args->ptrs[i] = ptr;
+			}
+
+			if (i < args->count) {
+				void* ptr = _DasBlockAlctor_bump(alctor, args->count - i);
+				if (!ptr) {
+					//
+					// give back the blocks we took from the free list.
+					DasAllocExtArgs dealloc_args = { .ptrs = args->ptrs, .count = i };
+					DasBlockAlctor_alloc_ext_fn(alctor, DasAllocExtOp_dealloc_batch, &dealloc_args);
+					args->count = 0;
+					return das_true;
+				}
+
+				for (; i < args->count; i += 1) {
+					args->ptrs[i] = ptr;
+					ptr = das_ptr_add(ptr, alctor->block_size);
+				}
+			}
+			return das_true;
+		}
+		case DasAllocExtOp_dealloc_batch:
+			if (args->count == 0) return das_true;
+
+			for (uintptr_t i = 0; i + 1 < args->count; i += 1) {
+				*(void**)args->ptrs[i] = args->ptrs[i + 1];
+			}
+			*(void**)args->ptrs[args->count - 1] = alctor->free_list_head;
+			alctor->free_list_head = args->ptrs[0];
+			return das_true;
+		case DasAllocExtOp_alloc_zeroed:
+			//
+			// blocks from the free list have been used, so let the caller zero them.
+			if (alctor->free_list_head) return das_false;
+			args->ptr = DasBlockAlctor_alloc_fn(alctor, NULL, 0, args->size, args->align);
+			return das_true;
+		case DasAllocExtOp_owns:
+			args->count = args->ptr >= alctor->address_space && args->ptr < das_ptr_add(alctor->address_space, alctor->pos);
+			return das_true;
+	}
+
+	return das_false;
 }
 
-DasError das_virt_mem_map_file(void* requested_addr, DasFileHandle file_handle, DasVirtMemProtection protection, uint64_t offset, uintptr_t size, void** addr_out, DasMapFileHandle* map_file_handle_out) {
-	das_assert(protection != DasVirtMemProtection_no_access, "cannot map a file with no access");
+// ===========================================================================
+//
+//
+// Segregator Allocator
+//
+//
+// ===========================================================================
 
-	uintptr_t reserve_align;
-	uintptr_t page_size;
-	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
-	if (error) return error;
+void DasSegregatorAlctor_init(DasSegregatorAlctor* alctor, uintptr_t threshold, DasAlctor small, DasAlctor large) {
+	alctor->threshold = threshold;
+	alctor->small = small;
+	alctor->large = large;
+}
 
-	//
-	// round down the offset to the nearest multiple of reserve_align
-	//
-	uint64_t offset_diff = offset % reserve_align;
-	offset -= offset_diff;
+static inline DasAlctor* _DasSegregatorAlctor_for_size(DasSegregatorAlctor* alctor, uintptr_t size) {
+	return size <= alctor->threshold ? &alctor->small : &alctor->large;
+}
 
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	*map_file_handle_out = NULL;
-	int prot = _das_virt_mem_prot_unix(protection);
+void* DasSegregatorAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasSegregatorAlctor* alctor = (DasSegregatorAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset
+		alctor->small.fn(alctor->small.data, NULL, 0, 0, 0);
+		alctor->large.fn(alctor->large.data, NULL, 0, 0, 0);
+		return NULL;
+	} else if (!ptr) {
+		// allocate
+		DasAlctor* sub = _DasSegregatorAlctor_for_size(alctor, size);
+		return sub->fn(sub->data, NULL, 0, size, align);
+	} else if (ptr && size > 0) {
+		// reallocate
+		DasAlctor* old_sub = _DasSegregatorAlctor_for_size(alctor, old_size);
+		DasAlctor* sub = _DasSegregatorAlctor_for_size(alctor, size);
+		if (old_sub == sub) {
+			return sub->fn(sub->data, ptr, old_size, size, align);
+		}
 
-	size = das_round_up_nearest_multiple_u(size, page_size);
-	void* addr = mmap(requested_addr, size, prot, MAP_SHARED, file_handle.raw, offset);
-	if (addr == MAP_FAILED)
-		return _das_get_last_error();
-#elif _WIN32
+		//
+		// the allocation is moving to the other allocator.
+		void* new_ptr = sub->fn(sub->data, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
+
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		old_sub->fn(old_sub->data, ptr, old_size, 0, align);
+		return new_ptr;
+	} else {
+		// deallocate
+		DasAlctor* sub = _DasSegregatorAlctor_for_size(alctor, old_size);
+		return sub->fn(sub->data, ptr, old_size, 0, align);
+	}
 
-	DWORD prot = _das_virt_mem_prot_windows(protection);
+	return NULL;
+}
 
-	DWORD size_high = size >> 32;
-	DWORD size_low = size;
+DasBool DasSegregatorAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasSegregatorAlctor* alctor = (DasSegregatorAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+			if (_DasSegregatorAlctor_for_size(alctor, args->old_size) != _DasSegregatorAlctor_for_size(alctor, args->size))
+				return das_false;
+			return _DasAlctor_ext(*_DasSegregatorAlctor_for_size(alctor, args->size), op, args);
+		case DasAllocExtOp_usable_size:
+			if (!_DasAlctor_ext(*_DasSegregatorAlctor_for_size(alctor, args->old_size), op, args))
+				return das_false;
 
-	// create a file mapping object for the file
-	HANDLE map_file_handle = CreateFileMappingA(file_handle.raw, NULL, prot, 0, 0, NULL);
-	if (map_file_handle == NULL)
-		return _das_get_last_error();
-	*map_file_handle_out = map_file_handle;
+			//
+			// the usable size is passed back in as the old size, so it must not cross over to the large allocator.
+			if (args->old_size <= alctor->threshold) {
+				args->size = das_min_u(args->size, alctor->threshold);
+			}
+			return das_true;
+		case DasAllocExtOp_alloc_batch:
+		case DasAllocExtOp_alloc_zeroed:
+			return _DasAlctor_ext(*_DasSegregatorAlctor_for_size(alctor, args->size), op, args);
+		case DasAllocExtOp_dealloc_batch:
+			return _DasAlctor_ext(*_DasSegregatorAlctor_for_size(alctor, args->old_size), op, args);
+		case DasAllocExtOp_realloc_zeroed: {
+			DasAlctor* old_sub = _DasSegregatorAlctor_for_size(alctor, args->old_size);
+			DasAlctor* sub = _DasSegregatorAlctor_for_size(alctor, args->size);
+			if (old_sub == sub) {
+				return _DasAlctor_ext(*sub, op, args);
+			}
 
-	DWORD access = 0;
-	switch (protection) {
-		case DasVirtMemProtection_exec_read:
-		case DasVirtMemProtection_read:
-			access = FILE_MAP_READ;
-			break;
-		case DasVirtMemProtection_exec_read_write:
-		case DasVirtMemProtection_read_write:
-			access = FILE_MAP_ALL_ACCESS;
-			break;
+			void* new_ptr = das_alloc_zeroed(*sub, args->size, args->align);
+			if (new_ptr) {
+				memcpy(new_ptr, args->ptr, das_min_u(args->old_size, args->size));
+				old_sub->fn(old_sub->data, args->ptr, args->old_size, 0, args->align);
+			}
+			args->ptr = new_ptr;
+			return das_true;
+		}
+		case DasAllocExtOp_owns:
+			args->count = 0;
+			return _DasAlctor_owns_or(alctor->small, args->ptr, &args->count)
+				&& _DasAlctor_owns_or(alctor->large, args->ptr, &args->count);
 	}
 
-	DWORD offset_high = offset >> 32;
-	DWORD offset_low = offset;
+	return das_false;
+}
 
-	void* addr = MapViewOfFile(map_file_handle, access, offset_high, offset_low, size);
-	if (addr == NULL)
-		return _das_get_last_error();
-#else
-#error "TODO implement virtual memory for this platform"
-#endif
+// ===========================================================================
+//
+//
+// Fallback Allocator
+//
+//
+// ===========================================================================
 
-	//
-	// move the pointer to where the user's request offset into the file will be.
-	addr = das_ptr_add(addr, offset_diff);
-	*addr_out = addr;
+void DasFallbackAlctor_init(DasFallbackAlctor* alctor, DasAlctor primary, DasAlctor secondary) {
+	DasAllocExtArgs args = {0};
+	das_assert(_DasAlctor_ext(primary, DasAllocExtOp_owns, &args), "the primary allocator must support DasAllocExtOp_owns");
 
-	return DasError_success;
+	alctor->primary = primary;
+	alctor->secondary = secondary;
 }
 
-DasError das_virt_mem_unmap_file(void* addr, uintptr_t size, DasMapFileHandle map_file_handle) {
-	uintptr_t reserve_align;
-	uintptr_t page_size;
-	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
-	if (error) return error;
+void* DasFallbackAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasFallbackAlctor* alctor = (DasFallbackAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset
+		alctor->primary.fn(alctor->primary.data, NULL, 0, 0, 0);
+		alctor->secondary.fn(alctor->secondary.data, NULL, 0, 0, 0);
+		return NULL;
+	} else if (!ptr) {
+		// allocate
+		void* new_ptr = alctor->primary.fn(alctor->primary.data, NULL, 0, size, align);
+		if (new_ptr) return new_ptr;
 
-	//
-	// when mapping a file the user is given an offset from the start of the range pages that are mapped
-	// to match the file offset they requested.
-	// so round down to the address to the nearest reserve align.
-	addr = das_ptr_round_down_align(addr, reserve_align);
+		return alctor->secondary.fn(alctor->secondary.data, NULL, 0, size, align);
+	} else if (ptr && size > 0) {
+		// reallocate
+		if (!das_owns(alctor->primary, ptr)) {
+			return alctor->secondary.fn(alctor->secondary.data, ptr, old_size, size, align);
+		}
 
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-	size = das_round_up_nearest_multiple_u(size, page_size);
-	return das_virt_mem_release(addr, size);
-#elif _WIN32
+		void* new_ptr = alctor->primary.fn(alctor->primary.data, ptr, old_size, size, align);
+		if (new_ptr) return new_ptr;
 
-	if (!UnmapViewOfFile(addr))
-		return _das_get_last_error();
+		//
+		// the primary allocator is out of memory, so move the allocation over to the secondary allocator.
+		new_ptr = alctor->secondary.fn(alctor->secondary.data, NULL, 0, size, align);
+		if (new_ptr == NULL) { return NULL; }
 
-	if (!CloseHandle(map_file_handle))
-		return _das_get_last_error();
+		memcpy(new_ptr, ptr, das_min_u(old_size, size));
+		alctor->primary.fn(alctor->primary.data, ptr, old_size, 0, align);
+		return new_ptr;
+	} else {
+		// deallocate
+		DasAlctor* sub = das_owns(alctor->primary, ptr) ? &alctor->primary : &alctor->secondary;
+		return sub->fn(sub->data, ptr, old_size, 0, align);
+	}
 
-	return DasError_success;
-#else
-#error "TODO implement virtual memory for this platform"
-#endif
+	return NULL;
+}
+
+DasBool DasFallbackAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasFallbackAlctor* alctor = (DasFallbackAlctor*)alctor_data;
+	switch (op) {
+		case DasAllocExtOp_try_expand:
+		case DasAllocExtOp_usable_size: {
+			DasAlctor* sub = das_owns(alctor->primary, args->ptr) ? &alctor->primary : &alctor->secondary;
+			return _DasAlctor_ext(*sub, op, args);
+		}
+		case DasAllocExtOp_alloc_batch:
+			if (!das_alloc_batch(alctor->primary, args->size, args->align, args->ptrs, args->count)) {
+				if (!das_alloc_batch(alctor->secondary, args->size, args->align, args->ptrs, args->count)) {
+					args->count = 0;
+				}
+			}
+			return das_true;
+		case DasAllocExtOp_alloc_zeroed:
+			args->ptr = das_alloc_zeroed(alctor->primary, args->size, args->align);
+			if (!args->ptr) {
+				args->ptr = das_alloc_zeroed(alctor->secondary, args->size, args->align);
+			}
+			return das_true;
+		case DasAllocExtOp_realloc_zeroed: {
+			void* ptr = args->ptr;
+			if (!das_owns(alctor->primary, ptr)) {
+				args->ptr = das_realloc_zeroed(alctor->secondary, ptr, args->old_size, args->size, args->align);
+				return das_true;
+			}
+
+			args->ptr = das_realloc_zeroed(alctor->primary, ptr, args->old_size, args->size, args->align);
+			if (args->ptr) return das_true;
+
+			args->ptr = das_alloc_zeroed(alctor->secondary, args->size, args->align);
+			if (args->ptr) {
+				memcpy(args->ptr, ptr, das_min_u(args->old_size, args->size));
+				alctor->primary.fn(alctor->primary.data, ptr, args->old_size, 0, args->align);
+			}
+			return das_true;
+		}
+		case DasAllocExtOp_owns:
+			args->count = 0;
+			return _DasAlctor_owns_or(alctor->primary, args->ptr, &args->count)
+				&& _DasAlctor_owns_or(alctor->secondary, args->ptr, &args->count);
+	}
+
+	return das_false;
 }
 
 // ===========================================================================
 //
 //
-// Linear Allocator
+// Deferred Free Allocator
 //
 //
 // ===========================================================================
 
-DasError DasLinearAlctor_init(DasLinearAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size) {
-	uintptr_t reserve_align;
-	uintptr_t page_size;
-	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
-	if (error) return error;
+//
+// the list link that is stored at the start of the memory that is waiting to be deallocated.
+typedef struct _DasDeferredFree _DasDeferredFree;
+struct _DasDeferredFree {
+	_DasDeferredFree* next;
+	uintptr_t size;
+	uintptr_t align;
+};
+
+// the max number of allocations that are deallocated in a single das_dealloc_batch call when draining.
+#define _das_deferred_free_batch_cap 64
+
+void DasDeferredAlctor_init(DasDeferredAlctor* alctor, DasAlctor inner, uintptr_t min_size, uintptr_t drain_threshold) {
+	das_zero_elmt(alctor);
+	alctor->inner = inner;
+	alctor->min_size = das_max_u(min_size, sizeof(_DasDeferredFree));
+	alctor->drain_threshold = drain_threshold;
+}
 
-	// reserved_size must be a multiple of the reserve_align.
-	// commit_grow_size must be multiple of the page size.
-	commit_grow_size = das_round_up_nearest_multiple_u(commit_grow_size, page_size);
-	reserved_size = das_round_up_nearest_multiple_u(reserved_size, reserve_align);
-	reserved_size = das_round_up_nearest_multiple_u(reserved_size, commit_grow_size);
-	void* address_space;
-	error = das_virt_mem_reserve(NULL, reserved_size, &address_space);
-	if (error) return error;
+static void _DasDeferredAlctor_drain_job(void* data, uintptr_t arg) {
+	DasDeferredAlctor* alctor = (DasDeferredAlctor*)data;
+	DasDeferredAlctor_drain(alctor);
+	das_atomic_store_u(&alctor->drain_is_posted, 0);
+}
 
-	alctor->address_space = address_space;
-	alctor->pos = 0;
-	alctor->commited_size = 0;
-	alctor->commit_grow_size = commit_grow_size;
-	alctor->reserved_size = reserved_size;
-	return DasError_success;
+//
+// waits for the drain on the background worker thread to finish, if there is one.
+static void _DasDeferredAlctor_drain_finish(DasDeferredAlctor* alctor) {
+	while (das_atomic_load_u(&alctor->drain_is_posted)) {
+		das_cpu_relax();
+	}
 }
 
-DasError DasLinearAlctor_deinit(DasLinearAlctor* alctor) {
-	return das_virt_mem_release(alctor->address_space, alctor->reserved_size);
+void DasDeferredAlctor_deinit(DasDeferredAlctor* alctor) {
+	_DasDeferredAlctor_drain_finish(alctor);
+	DasDeferredAlctor_drain(alctor);
 }
 
-static DasBool _DasLinearAlctor_commit_next_chunk(DasLinearAlctor* alctor) {
-	if (alctor->commited_size == alctor->reserved_size) {
-		// linear alloctor reserved_size has been exhausted.
-		// there is no more memory to commit.
-		return das_false;
-	} else {
+void DasDeferredAlctor_drain(DasDeferredAlctor* alctor) {
+	//
+	// take the whole list in one go, so the threads that are deallocating can carry on pushing to an empty list.
+	_DasDeferredFree* node = das_atomic_exchange_ptr(&alctor->head, NULL);
+
+	void* ptrs[_das_deferred_free_batch_cap];
+	uintptr_t count = 0;
+	uintptr_t size = 0;
+	uintptr_t align = 0;
+	uintptr_t drained_size = 0;
+	while (node) {
 		//
-		// commit the next pages of memory using the grow size the linear allocator was initialized with.
-		void* next_pages_start = das_ptr_add(alctor->address_space, alctor->commited_size);
+		// read the link before the memory it is in gets deallocated.
+		_DasDeferredFree* next = node->next;
+		if (count == _das_deferred_free_batch_cap || (count && (node->size != size || node->align != align))) {
+			das_dealloc_batch(alctor->inner, ptrs, size, align, count);
+			count = 0;
+		}
 
-		//
-		// make sure the commit grow size does not go past the reserved address_space.
-		uintptr_t grow_size = das_min_u(alctor->commit_grow_size, alctor->reserved_size - alctor->commited_size);
+		size = node->size;
+		align = node->align;
+		drained_size += size;
+		ptrs[count] = node;
+		count += 1;
+		node = next;
+	}
 
-		DasError error = das_virt_mem_commit(next_pages_start, grow_size, DasVirtMemProtection_read_write);
-		das_assert(error == 0, "failed to commit memory next_pages_start(%p), grow_size(%zu), error_code(0x%x)",
-			next_pages_start, grow_size, error);
-		alctor->commited_size += grow_size;
-		return das_true;
+	if (count) {
+		das_dealloc_batch(alctor->inner, ptrs, size, align, count);
 	}
+	das_atomic_fetch_add_u(&alctor->pending_size, -drained_size);
 }
 
-void* DasLinearAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
-	DasLinearAlctor* alctor = (DasLinearAlctor*)alctor_data;
-	if (!ptr && size == 0) {
-		// reset by decommiting the memory back to the OS but retaining the reserved address space.
-		DasError error = das_virt_mem_decommit(alctor->address_space, alctor->commited_size);
-		das_assert(error == 0, "failed to decommit memory address_space(%p), commited_size(%zu)",
-			alctor->address_space, alctor->commited_size);
+static void _DasDeferredAlctor_dealloc(DasDeferredAlctor* alctor, void* ptr, uintptr_t old_size, uintptr_t align) {
+	if (old_size < alctor->min_size || (uintptr_t)ptr % alignof(_DasDeferredFree) != 0) {
+		alctor->inner.fn(alctor->inner.data, ptr, old_size, 0, align);
+		return;
+	}
 
-		alctor->pos = 0;
-		alctor->commited_size = 0;
-	} else if (!ptr) {
-		// allocate
-		while (1) {
-			//
-			// get the next pointer and align it
-			ptr = das_ptr_add(alctor->address_space, alctor->pos);
-			ptr = das_ptr_round_up_align(ptr, align);
-			uint32_t next_pos = das_ptr_diff(ptr, alctor->address_space) + size;
-			if (next_pos <= alctor->commited_size) {
-				//
-				// success, the requested size can fit in the linear block of memory.
-				alctor->pos = next_pos;
-				return ptr;
-			} else {
-				//
-				// failure, not enough room in the linear block of memory that is commited.
-				// so lets try to commit more memory.
-				if (!_DasLinearAlctor_commit_next_chunk(alctor))
-					return NULL;
-			}
-		}
-	} else if (ptr && size > 0) {
-		// reallocate
+	_DasDeferredFree* node = (_DasDeferredFree*)ptr;
+	node->size = old_size;
+	node->align = align;
+	void* head = das_atomic_load_ptr(&alctor->head);
+	while (1) {
+		node->next = head;
+		if (das_atomic_cas_ptr(&alctor->head, head, node))
+			break;
+		head = das_atomic_load_ptr(&alctor->head);
+	}
 
-		// check if the ptr is the last allocation to resize in place
-		if (das_ptr_add(alctor->address_space, alctor->pos - old_size) == ptr) {
-			while (1) {
-				uint32_t next_pos = das_ptr_diff(ptr, alctor->address_space) + size;
-				if (next_pos <= alctor->commited_size) {
-					alctor->pos = next_pos;
-					return ptr;
-				} else {
-					//
-					// failure, not enough room in the linear block of memory that is commited.
-					// so lets try to commit more memory.
-					if (!_DasLinearAlctor_commit_next_chunk(alctor))
-						return NULL;
-				}
-			}
-		}
+	uintptr_t pending_size = das_atomic_fetch_add_u(&alctor->pending_size, old_size) + old_size;
+	if (alctor->drain_threshold == 0 || pending_size < alctor->drain_threshold)
+		return;
 
-		// if we cannot extend in place, then just allocate a new block.
-		void* new_ptr = DasLinearAlctor_alloc_fn(alctor, NULL, 0, size, align);
-		if (new_ptr == NULL) { return NULL; }
+	//
+	// only one drain is posted at a time. if the job queue is full then drain on this thread instead.
+	if (das_atomic_cas_u(&alctor->drain_is_posted, 0, 1)) {
+		if (!_das_worker_post(_DasDeferredAlctor_drain_job, alctor, 0)) {
+			_DasDeferredAlctor_drain_job(alctor, 0);
+		}
+	}
+}
 
-		memcpy(new_ptr, ptr, size < old_size ? size : old_size);
-		return new_ptr;
+void* DasDeferredAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	DasDeferredAlctor* alctor = (DasDeferredAlctor*)alctor_data;
+	if (!ptr && size == 0) {
+		// reset
+		_DasDeferredAlctor_drain_finish(alctor);
+		DasDeferredAlctor_drain(alctor);
+		return alctor->inner.fn(alctor->inner.data, ptr, old_size, size, align);
+	} else if (!ptr || size > 0) {
+		// allocate or reallocate
+		return alctor->inner.fn(alctor->inner.data, ptr, old_size, size, align);
 	} else {
 		// deallocate
-		// do nothing
+		_DasDeferredAlctor_dealloc(alctor, ptr, old_size, align);
 		return NULL;
 	}
 
 	return NULL;
 }
 
+DasBool DasDeferredAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args) {
+	DasDeferredAlctor* alctor = (DasDeferredAlctor*)alctor_data;
+	if (op == DasAllocExtOp_dealloc_batch)
+		return das_false;
+
+	return _DasAlctor_ext(alctor->inner, op, args);
+}
+
 // ===========================================================================
 //
 //
@@ -1368,7 +5650,7 @@ static void _DasPool_assert_id(_DasPool* pool, DasPoolElmtId elmt_id, uintptr_t
 	das_assert(counter == record_counter, "use after free detected... the provided element identifier has a counter of '%u' but the internal one is '%u'", counter, record_counter);
 }
 
-DasError _DasPool_init(_DasPool* pool, uint32_t reserved_cap, uint32_t commit_grow_count, uintptr_t elmt_size) {
+DasError _DasPool_init(_DasPool* pool, uint32_t reserved_cap, uint32_t commit_grow_count, DasVirtMemFlags flags, uint32_t numa_node, uintptr_t elmt_size) {
 	das_zero_elmt(pool);
 
 	uintptr_t reserve_align;
@@ -1376,12 +5658,21 @@ DasError _DasPool_init(_DasPool* pool, uint32_t reserved_cap, uint32_t commit_gr
 	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
 	if (error) return error;
 
+	//
+	// with huge pages, we work in huge pages and not the normal page size.
+	if (flags) {
+		if (flags & DasVirtMemFlags_transparent_huge_pages) flags |= DasVirtMemFlags_huge_page_align;
+		error = das_virt_mem_huge_page_size_with_flags(flags, &page_size);
+		if (error) return error;
+		reserve_align = das_max_u(reserve_align, page_size);
+	}
+
 	//
 	// reserve the whole address space for the elements array and the records array.
 	uintptr_t elmts_size = das_round_up_nearest_multiple_u((uintptr_t)reserved_cap * elmt_size, reserve_align);
 	uintptr_t records_size = das_round_up_nearest_multiple_u((uintptr_t)reserved_cap * sizeof(_DasPoolRecord), reserve_align);
 	uintptr_t reserved_size = elmts_size + records_size;
-	error = das_virt_mem_reserve(NULL, reserved_size, &pool->address_space);
+	error = das_virt_mem_reserve_on_numa_node(NULL, reserved_size, flags, numa_node, &pool->address_space);
 	if (error) return error;
 
 	//
@@ -1400,12 +5691,108 @@ DasError _DasPool_init(_DasPool* pool, uint32_t reserved_cap, uint32_t commit_gr
 	return DasError_success;
 }
 
+//
+// the memory of the next chunk of elements and records at the end of the currently commited ones.
+typedef struct {
+	void* elmts;
+	uintptr_t elmts_size;
+	void* records;
+	uintptr_t records_size;
+	uint32_t commited_cap;
+} _DasPoolChunk;
+
+static _DasPoolChunk _DasPool_next_chunk(_DasPool* pool, uintptr_t elmt_size) {
+	uintptr_t grow_count = das_min_u(pool->commit_grow_count, pool->reserved_cap - pool->commited_cap);
+
+	uintptr_t elmts_size = das_round_up_nearest_multiple_u((uintptr_t)pool->commited_cap * elmt_size, pool->page_size);
+	uintptr_t records_size = das_round_up_nearest_multiple_u((uintptr_t)pool->commited_cap * sizeof(_DasPoolRecord), pool->page_size);
+
+	_DasPoolChunk chunk;
+	chunk.elmts = das_ptr_add(pool->address_space, elmts_size);
+	chunk.elmts_size = das_round_up_nearest_multiple_u((uintptr_t)grow_count * elmt_size, pool->page_size);
+	chunk.records = das_ptr_add(_DasPool_records(pool, elmt_size), records_size);
+	chunk.records_size = das_round_up_nearest_multiple_u((uintptr_t)grow_count * sizeof(_DasPoolRecord), pool->page_size);
+
+	//
+	// calculate commited_cap by using the new elements size in bytes and dividing to get an accurate number.
+	// adding the grow_count will lose precision if the elmt_size is not directly divisble by the page_size.
+	uintptr_t new_elmts_size = elmts_size + chunk.elmts_size;
+	chunk.commited_cap = new_elmts_size / elmt_size;
+	return chunk;
+}
+
+static void _DasPool_commit_chunk(_DasPoolChunk* chunk) {
+	DasError error = das_virt_mem_commit(chunk->elmts, chunk->elmts_size, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+
+	error = das_virt_mem_commit(chunk->records, chunk->records_size, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
+}
+
+static void _DasPool_commit_ahead_job(void* data, uintptr_t elmt_size) {
+	_DasPool* pool = (_DasPool*)data;
+	_DasPoolChunk chunk = _DasPool_next_chunk(pool, elmt_size);
+	_DasPool_commit_chunk(&chunk);
+	_das_virt_mem_prefault(chunk.elmts, chunk.elmts_size, pool->commit_ahead);
+	_das_virt_mem_prefault(chunk.records, chunk.records_size, pool->commit_ahead);
+
+	das_atomic_store_u(&pool->commit_ahead_state, _DasCommitAheadState_ready);
+}
+
+//
+// starts committing the next chunk on the background worker, if the capacity is within half a chunk of the commited capacity.
+static void _DasPool_commit_ahead(_DasPool* pool, uintptr_t elmt_size) {
+	if (pool->cap + pool->commit_grow_count / 2 < pool->commited_cap || pool->commited_cap == pool->reserved_cap)
+		return;
+	if (das_atomic_load_u(&pool->commit_ahead_state) != _DasCommitAheadState_idle)
+		return;
+
+	das_atomic_store_u(&pool->commit_ahead_state, _DasCommitAheadState_in_progress);
+	if (!_das_worker_post(_DasPool_commit_ahead_job, pool, elmt_size)) {
+		das_atomic_store_u(&pool->commit_ahead_state, _DasCommitAheadState_idle);
+	}
+}
+
+//
+// if a chunk is being committed ahead, wait for the background worker to finish it and add it to the commited capacity.
+// if the background worker has not started on it yet, then the job is cancelled so we do not wait behind the other jobs in the queue.
+// returns das_true if a chunk was added, otherwise the caller must commit the memory itself.
+static DasBool _DasPool_commit_ahead_finish(_DasPool* pool, uintptr_t elmt_size) {
+	if (das_atomic_load_u(&pool->commit_ahead_state) == _DasCommitAheadState_idle)
+		return das_false;
+
+	if (_das_worker_cancel(_DasPool_commit_ahead_job, pool)) {
+		das_atomic_store_u(&pool->commit_ahead_state, _DasCommitAheadState_idle);
+		return das_false;
+	}
+
+	while (das_atomic_load_u(&pool->commit_ahead_state) != _DasCommitAheadState_ready) {
+		das_cpu_relax();
+	}
+
+	pool->commited_cap = _DasPool_next_chunk(pool, elmt_size).commited_cap;
+	das_atomic_store_u(&pool->commit_ahead_state, _DasCommitAheadState_idle);
+	return das_true;
+}
+
+void _DasPool_commit_ahead_set(_DasPool* pool, DasCommitAhead commit_ahead, uintptr_t elmt_size) {
+	// the background worker reads the mode, so wait for it to finish first.
+	_DasPool_commit_ahead_finish(pool, elmt_size);
+	pool->commit_ahead = commit_ahead;
+}
+
 DasError _DasPool_deinit(_DasPool* pool, uintptr_t elmt_size) {
+	// make sure the background worker is not using the memory we are about to release.
+	_DasPool_commit_ahead_finish(pool, elmt_size);
+
 	uintptr_t reserve_align;
 	uintptr_t page_size;
 	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
 	if (error) return error;
 
+	// when the pool was initialized with huge pages, the page size is the huge page size.
+	reserve_align = das_max_u(reserve_align, pool->page_size);
+
 	//
 	// decommit and release the reserved address space
 	uintptr_t elmts_size = das_round_up_nearest_multiple_u((uintptr_t)pool->reserved_cap * elmt_size, reserve_align);
@@ -1419,6 +5806,7 @@ DasError _DasPool_deinit(_DasPool* pool, uintptr_t elmt_size) {
 }
 
 DasError _DasPool_reset(_DasPool* pool, uintptr_t elmt_size) {
+	_DasPool_commit_ahead_finish(pool, elmt_size);
 	if (pool->commited_cap == 0)
 		return DasError_success;
 
@@ -1427,6 +5815,12 @@ DasError _DasPool_reset(_DasPool* pool, uintptr_t elmt_size) {
 	void* elmts = pool->address_space;
 	_DasPoolRecord* records = _DasPool_records(pool, elmt_size);
 
+	if (pool->commit_ahead == DasCommitAhead_prefault_and_lock) {
+		// locked pages cannot be decommitted. ignore the errors as some of these pages may not have been locked.
+		das_virt_mem_unlock(elmts, elmts_size);
+		das_virt_mem_unlock(records, records_size);
+	}
+
 	//
 	// decommit all of the commited pages of memory for the elements
 	DasError error = das_virt_mem_decommit(elmts, elmts_size);
@@ -1451,31 +5845,14 @@ DasBool _DasPool_commit_next_chunk(_DasPool* pool, uintptr_t elmt_size) {
 	if (pool->commited_cap == pool->reserved_cap)
 		return das_false;
 
-	uintptr_t grow_count = das_min_u(pool->commit_grow_count, pool->reserved_cap - pool->commited_cap);
-
-	uintptr_t elmts_size = das_round_up_nearest_multiple_u((uintptr_t)pool->commited_cap * elmt_size, pool->page_size);
-	uintptr_t records_size = das_round_up_nearest_multiple_u((uintptr_t)pool->commited_cap * sizeof(_DasPoolRecord), pool->page_size);
-
-	//
-	// commit the next chunk of memory at the end of the currently commited elments
-	void* elmts_to_commit = das_ptr_add(pool->address_space, elmts_size);
-	uintptr_t elmts_grow_size = das_round_up_nearest_multiple_u((uintptr_t)grow_count * elmt_size, pool->page_size);
-	DasError error = das_virt_mem_commit(elmts_to_commit, elmts_grow_size, DasVirtMemProtection_read_write);
-	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
-
-	//
-	// commit the next chunk of memory at the end of the currently commited records
-	_DasPoolRecord* records_to_commit = das_ptr_add(_DasPool_records(pool, elmt_size), records_size);
-	uintptr_t records_grow_size = das_round_up_nearest_multiple_u((uintptr_t)grow_count * sizeof(_DasPoolRecord), pool->page_size);
-	error = das_virt_mem_commit(records_to_commit, records_grow_size, DasVirtMemProtection_read_write);
-	das_assert(error == 0, "unexpected error our parameters should be correct: 0x%x", error);
-
 	//
-	// calculate commited_cap by using the new elements size in bytes and dividing to get an accurate number.
-	// adding the grow_count will lose precision if the elmt_size is not directly divisble by the page_size.
-	uintptr_t new_elmts_size = elmts_size + elmts_grow_size;
-	pool->commited_cap = new_elmts_size / elmt_size;
+	// the background worker may have committed the next chunk for us.
+	if (_DasPool_commit_ahead_finish(pool, elmt_size))
+		return das_true;
 
+	_DasPoolChunk chunk = _DasPool_next_chunk(pool, elmt_size);
+	_DasPool_commit_chunk(&chunk);
+	pool->commited_cap = chunk.commited_cap;
 	return das_true;
 }
 
@@ -1524,6 +5901,7 @@ void* _DasPool_alloc(_DasPool* pool, DasPoolElmtId* id_out, uintptr_t elmt_size,
 
 		pool->cap += 1;
 		idx_id = pool->cap;
+		if (pool->commit_ahead) _DasPool_commit_ahead(pool, elmt_size);
 	} else {
 		idx_id = pool->free_list_head_id;
 	}
@@ -34,10 +34,97 @@
 #define DasDeque_min_cap 16
 #endif
 
+//
+// the allocator used by DasStk and DasDeque when they have not been given one.
+// for heavily multithreaded programs you can switch this to DasAlctor_tcache.
+//
 #ifndef DasAlctor_default
 #define DasAlctor_default DasAlctor_system
 #endif
 
+//
+// On Linux: allocations larger than this in das_system_alloc_fn get their own mapping
+// directly from mmap, so reallocating them moves the pages with mremap instead of copying the bytes.
+//
+#ifndef das_system_mmap_threshold
+#define das_system_mmap_threshold (1024 * 1024)
+#endif
+
+//
+// the largest size class of the thread caching allocator, must be a power of two.
+// allocations larger than this are passed on to das_system_alloc_fn.
+//
+#ifndef das_tcache_max_size
+#define das_tcache_max_size 32768
+#endif
+
+//
+// the number of blocks that move between a thread's cache and the central free list at once.
+//
+#ifndef das_tcache_batch_count
+#define das_tcache_batch_count 32
+#endif
+
+//
+// the number of scratch arenas each thread has, this is the most scratch arenas that
+// can be in use at once without one of them aliasing a conflict passed to das_scratch_begin.
+//
+#ifndef das_scratch_arenas_count
+#define das_scratch_arenas_count 2
+#endif
+
+//
+// the reserved and commit grow sizes of each thread's scratch arenas.
+//
+#ifndef das_scratch_reserved_size
+#define das_scratch_reserved_size (64 * 1024 * 1024)
+#endif
+
+#ifndef das_scratch_commit_grow_size
+#define das_scratch_commit_grow_size (64 * 1024)
+#endif
+
+//
+// the number of frames a DasFrameAlctor arena is used for, before the memory
+// past the highest position it reached in those frames is decommitted.
+//
+#ifndef das_frame_alctor_decommit_frames_count
+#define das_frame_alctor_decommit_frames_count 8
+#endif
+
+//
+// the maximum number of NUMA nodes that a DasNumaArenas has an arena for.
+// threads on a node past this share the arena of node (node % das_numa_nodes_max).
+//
+#ifndef das_numa_nodes_max
+#define das_numa_nodes_max 8
+#endif
+
+//
+// the maximum number of jobs that can be waiting for the background worker thread.
+// the background worker does the commit ahead work, see DasCommitAhead.
+//
+#ifndef das_worker_jobs_cap
+#define das_worker_jobs_cap 64
+#endif
+
+//
+// On Linux: the starting maximum number of bytes of address space that das_virt_mem_release keeps in a process wide cache
+// so das_virt_mem_reserve can hand it out again without the mmap and the munmap, see das_virt_mem_release.
+// the cached address space is decommitted, so this does not hold on to any physical memory.
+// the cache is opt in, so this is 0 to turn it off. it can be changed at runtime with das_virt_mem_cache_set_budget.
+//
+#ifndef das_virt_mem_cache_budget
+#define das_virt_mem_cache_budget 0
+#endif
+
+//
+// the maximum number of address ranges in each power of two size bucket of the reservation cache.
+//
+#ifndef das_virt_mem_cache_bucket_cap
+#define das_virt_mem_cache_bucket_cap 16
+#endif
+
 // ======================================================================
 //
 //
@@ -107,6 +194,10 @@ das_noreturn void _das_abort(const char* file, int line, const char* func, char*
 #define alignof _Alignof
 #endif
 
+#ifndef alignas
+#define alignas _Alignas
+#endif
+
 static inline uintptr_t das_min_u(uintptr_t a, uintptr_t b) { return a < b ? a : b; }
 static inline intptr_t das_min_s(intptr_t a, intptr_t b) { return a < b ? a : b; }
 static inline double das_min_f(double a, double b) { return a < b ? a : b; }
@@ -243,6 +334,146 @@ extern void* das_ptr_round_down_align(void* ptr, uintptr_t align);
 // for X86/64 and ARM. maybe be different for other architectures.
 #define das_cache_line_size 64
 
+// ======================================================================
+//
+//
+// Atomics & Threading Utilities
+//
+//
+// ======================================================================
+//
+// a minimal set of primitives that the thread safe allocators are built on.
+// all of the atomic operations are sequentially consistent.
+//
+
+#ifndef das_thread_local
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define das_thread_local _Thread_local
+#elif defined(__GNUC__)
+#define das_thread_local __thread
+#elif _WIN32
+#define das_thread_local __declspec(thread)
+#else
+#error "unhandled thread local storage for this platform"
+#endif
+#endif // das_thread_local
+
+static inline uintptr_t das_atomic_load_u(uintptr_t* ptr) {
+#if defined(__GNUC__)
+	return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+#elif defined(_WIN32)
+	uintptr_t v = *(volatile uintptr_t*)ptr;
+	MemoryBarrier();
+	return v;
+#else
+#error "unhandled atomics for this platform"
+#endif
+}
+
+static inline void das_atomic_store_u(uintptr_t* ptr, uintptr_t v) {
+#if defined(__GNUC__)
+	__atomic_store_n(ptr, v, __ATOMIC_SEQ_CST);
+#elif defined(_WIN32)
+	MemoryBarrier();
+	*(volatile uintptr_t*)ptr = v;
+	MemoryBarrier();
+#else
+#error "unhandled atomics for this platform"
+#endif
+}
+
+// adds @param(v) to the value at @param(ptr) and returns the value that was there before.
+static inline uintptr_t das_atomic_fetch_add_u(uintptr_t* ptr, uintptr_t v) {
+#if defined(__GNUC__)
+	return __atomic_fetch_add(ptr, v, __ATOMIC_SEQ_CST);
+#elif defined(_WIN64)
+	return (uintptr_t)InterlockedExchangeAdd64((LONG64 volatile*)ptr, (LONG64)v);
+#elif defined(_WIN32)
+	return (uintptr_t)InterlockedExchangeAdd((LONG volatile*)ptr, (LONG)v);
+#else
+#error "unhandled atomics for this platform"
+#endif
+}
+
+// stores @param(desired) at @param(ptr) only if it currently holds @param(expected).
+// returns das_true if the value was stored.
+static inline DasBool das_atomic_cas_u(uintptr_t* ptr, uintptr_t expected, uintptr_t desired) {
+#if defined(__GNUC__)
+	return __atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#elif defined(_WIN64)
+	return (uintptr_t)InterlockedCompareExchange64((LONG64 volatile*)ptr, (LONG64)desired, (LONG64)expected) == expected;
+#elif defined(_WIN32)
+	return (uintptr_t)InterlockedCompareExchange((LONG volatile*)ptr, (LONG)desired, (LONG)expected) == expected;
+#else
+#error "unhandled atomics for this platform"
+#endif
+}
+
+static inline void* das_atomic_load_ptr(void** ptr) {
+	return (void*)das_atomic_load_u((uintptr_t*)ptr);
+}
+
+static inline void das_atomic_store_ptr(void** ptr, void* v) {
+	das_atomic_store_u((uintptr_t*)ptr, (uintptr_t)v);
+}
+
+static inline DasBool das_atomic_cas_ptr(void** ptr, void* expected, void* desired) {
+	return das_atomic_cas_u((uintptr_t*)ptr, (uintptr_t)expected, (uintptr_t)desired);
+}
+
+// stores @param(v) at @param(ptr) and returns the value that was there before.
+static inline void* das_atomic_exchange_ptr(void** ptr, void* v) {
+#if defined(__GNUC__)
+	return __atomic_exchange_n(ptr, v, __ATOMIC_SEQ_CST);
+#elif defined(_WIN32)
+	return InterlockedExchangePointer((PVOID volatile*)ptr, v);
+#else
+#error "unhandled atomics for this platform"
+#endif
+}
+
+// hints to the CPU that we are in a spin loop waiting on another thread.
+static inline void das_cpu_relax(void) {
+#if defined(__GNUC__)
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__("yield");
+#endif
+#elif defined(_WIN32)
+	YieldProcessor();
+#endif
+}
+
+//
+// returns a small number that is unique to the calling thread, starting from 0 for the first thread that calls this.
+// this is used to spread threads across per thread slots without needing thread local data in a structure.
+//
+uint32_t das_thread_idx(void);
+
+//
+// a lock that busy waits. only use this to protect a few instructions.
+// zeroed data is initialization.
+//
+typedef uintptr_t DasSpinLock;
+
+static inline DasBool das_spin_try_lock(DasSpinLock* lock) {
+	return das_atomic_cas_u(lock, 0, 1);
+}
+
+static inline void das_spin_lock(DasSpinLock* lock) {
+	while (!das_spin_try_lock(lock)) {
+		// spin on a load so we are not hammering the cache line with writes.
+		while (das_atomic_load_u(lock)) {
+			das_cpu_relax();
+		}
+	}
+}
+
+static inline void das_spin_unlock(DasSpinLock* lock) {
+	das_atomic_store_u(lock, 0);
+}
+
 // ======================================================================
 //
 //
@@ -266,6 +497,66 @@ extern void* das_ptr_round_down_align(void* ptr, uintptr_t align);
 // returns NULL on allocation failure
 typedef void* (*DasAllocFn)(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
 
+//
+// the operations that an allocator can optionally support on top of the ones in DasAllocFn.
+typedef uint8_t DasAllocExtOp;
+enum {
+	//
+	// resize the allocation at args->ptr from args->old_size to args->size without moving it.
+	// on failure, the allocation is left as it was.
+	DasAllocExtOp_try_expand,
+
+	//
+	// get the number of bytes that can be used at args->ptr that was allocated with args->old_size bytes.
+	// on success, args->size is set to this and is atleast args->old_size.
+	// from now on, any size from args->old_size up to args->size is a valid old_size for this allocation.
+	DasAllocExtOp_usable_size,
+
+	//
+	// allocate args->count allocations of args->size bytes that are aligned to args->align and store them in args->ptrs.
+	// on failure, none of them are allocated and args->count is set to 0 while still returning das_true,
+	// so the caller knows not to try again one at a time.
+	DasAllocExtOp_alloc_batch,
+
+	//
+	// deallocate args->count allocations in args->ptrs that are args->old_size bytes and aligned to args->align.
+	DasAllocExtOp_dealloc_batch,
+
+	//
+	// allocate args->size bytes of zeroed memory that is aligned to args->align and store it in args->ptr.
+	// only support this if the allocator can give zeroed memory without zeroing all of it itself,
+	// for example with memory that comes straight from the OS, otherwise the caller only zeros what it needs to.
+	// on failure, args->ptr is set to NULL while still returning das_true.
+	DasAllocExtOp_alloc_zeroed,
+
+	//
+	// reallocate args->ptr from args->old_size to args->size bytes that are aligned to args->align and store it in args->ptr.
+	// the memory past args->old_size is zeroed. the same rules as DasAllocExtOp_alloc_zeroed apply.
+	// on failure, args->ptr is set to NULL while still returning das_true and the allocation is left as it was.
+	DasAllocExtOp_realloc_zeroed,
+
+	//
+	// check if args->ptr is in the memory of this allocator, so it knows how to deallocate it.
+	// args->count is set to 1 if it is, otherwise 0.
+	// allocators that hand out memory from the general purpose heap cannot know this and do not support it.
+	DasAllocExtOp_owns,
+};
+
+typedef struct {
+	void* ptr;
+	uintptr_t old_size;
+	uintptr_t size;
+	uintptr_t align;
+	// only used by the batch operations.
+	void** ptrs;
+	uintptr_t count;
+} DasAllocExtArgs;
+
+//
+// an optional function that handles the DasAllocExtOp operations for an allocator.
+// returns das_false if the operation is not supported or has failed.
+typedef DasBool (*DasAllocExtFn)(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
 //
 // DasAlctor is the custom allocator data structure.
 // is used to point to the implementation of a custom allocator.
@@ -293,10 +584,212 @@ typedef struct {
 	// it is passed into the DasAllocFn as the first argument.
 	// this field can be NULL if you are implementing a global allocator.
 	void* data;
+
+	// an optional function for the extended operations, see the notes above DasAllocExtFn.
+	// this field can be NULL if the allocator does not support any of them.
+	DasAllocExtFn ext_fn;
 } DasAlctor;
 
+//
+// the allocator that uses the C standard library, or the aligned versions of the OS.
+//
+// On Linux: allocations larger than das_system_mmap_threshold are mapped directly with mmap,
+//     and reallocated with mremap, so growing them is O(pages remapped) instead of O(bytes copied).
+//     so @param(old_size) must always be the size that the allocation was made with.
+//
 void* das_system_alloc_fn(void* alloc_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
-#define DasAlctor_system ((DasAlctor){ .fn = das_system_alloc_fn, .data = NULL })
+
+//
+// the extended operations of the system allocator.
+//
+// DasAllocExtOp_try_expand: succeeds when the C standard library gave us enough spare bytes (glibc only)
+//     or on Linux, when the pages of a mapped allocation can be extended in place with mremap.
+//
+// DasAllocExtOp_usable_size: malloc_usable_size (glibc only) or on Linux, the size rounded up to the page size
+//     for a mapped allocation.
+//
+// DasAllocExtOp_alloc_batch, DasAllocExtOp_dealloc_batch: calls the C standard library directly for each allocation.
+//
+// DasAllocExtOp_alloc_zeroed: calloc, or on Windows _aligned_recalloc, or on Linux a mapping for large allocations.
+//
+// DasAllocExtOp_realloc_zeroed: only on Linux, when the new size is a mapped allocation.
+//
+DasBool das_system_alloc_ext_fn(void* alloc_data, DasAllocExtOp op, DasAllocExtArgs* args);
+#define DasAlctor_system ((DasAlctor){ .fn = das_system_alloc_fn, .data = NULL, .ext_fn = das_system_alloc_ext_fn })
+
+// ======================================================================
+//
+//
+// Thread Caching Allocator
+//
+//
+// ======================================================================
+//
+// a global general purpose allocator for programs that have many threads allocating at once.
+//
+// allocations are rounded up to a power of two size class, starting at 16 bytes and ending at das_tcache_max_size.
+// each thread has it's own cache of free blocks for every size class, so most allocations and deallocations
+// never touch any shared state. when a thread's cache runs dry, it takes a batch of blocks from
+// the shared central free list of that size class. when a thread's cache gets too big, a batch is given back.
+// when a thread exits, every block in it's cache is given back to the central free lists.
+// the central free lists get their blocks by carving up chunks that come from das_system_alloc_fn.
+// these chunks are never given back to the system.
+//
+// every block is aligned to it's size class, so alignments up to das_tcache_max_size are supported.
+// allocations larger than das_tcache_max_size are passed straight to das_system_alloc_fn.
+//
+// to use this allocator for every DasStk and DasDeque that do not have an allocator,
+// define this before you include das.h:
+//     #define DasAlctor_default DasAlctor_tcache
+//
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: not supported so it does nothing
+//
+// alloc: pops a block from the calling thread's cache for the size class.
+//
+// realloc: returns the same pointer if the size class has not changed.
+//     if it has, then allocate a new block and copy the old allocation there.
+//
+// dealloc: pushes the block on to the calling thread's cache for the size class.
+//
+void* das_tcache_alloc_fn(void* alloc_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the thread caching allocator.
+//
+// DasAllocExtOp_usable_size: the size class, or the same as das_system_alloc_ext_fn for larger allocations.
+//
+DasBool das_tcache_alloc_ext_fn(void* alloc_data, DasAllocExtOp op, DasAllocExtArgs* args);
+#define DasAlctor_tcache ((DasAlctor){ .fn = das_tcache_alloc_fn, .data = NULL, .ext_fn = das_tcache_alloc_ext_fn })
+
+//
+// gives every block in the calling thread's cache back to the central free lists.
+// this is done automatically when a thread exits, so you only need to call this
+// to give the blocks back early, like before a thread goes idle for a long time.
+//
+void das_tcache_thread_flush(void);
+
+// ======================================================================
+//
+//
+// Statistics Allocator
+//
+//
+// ======================================================================
+//
+// an allocator that wraps another allocator and records how it is being used.
+// this lets you find out which allocators are hot without changing any of the code that uses them.
+//
+// the counters are spread across DasStatsAlctor_slots_count cache line aligned slots that are picked
+// using das_thread_idx. so threads do not fight over the same counters and they are merged when they are read.
+// the live and peak bytes are the only counters that are shared between all threads,
+// as the peak needs to know the live bytes across all threads at once. so the peak is exact,
+// even when memory is deallocated on a different thread than it was allocated on.
+// they are on their own cache line, so they do not share one with the slots.
+//
+// the DasStatsAlctor is aligned to das_cache_line_size, so use das_alloc_elmt if you allocate it yourself.
+//
+
+// the sizes are bucketed by the power of two below them. the last bucket holds everything larger.
+#define DasAllocStats_histogram_buckets_count 32
+
+#ifndef DasStatsAlctor_slots_count
+#define DasStatsAlctor_slots_count 16
+#endif
+
+typedef struct {
+	uintptr_t alloc_count;
+	uintptr_t realloc_count;
+	uintptr_t dealloc_count;
+	uintptr_t reset_count;
+	// the number of allocs and reallocs that returned NULL.
+	uintptr_t failed_count;
+	// the total number of bytes requested by allocs.
+	uintptr_t alloced_bytes;
+	// the number of reallocs that returned a different pointer, so the memory had to be moved.
+	uintptr_t realloc_moved_count;
+	// the total number of bytes moved by reallocs that returned a different pointer.
+	uintptr_t realloc_moved_bytes;
+	uintptr_t live_bytes;
+	uintptr_t peak_live_bytes;
+	// the number of allocs and reallocs by the requested size.
+	// bucket i holds sizes from 2^i up to 2^(i + 1) - 1, 0 is in bucket 0.
+	uintptr_t size_histogram[DasAllocStats_histogram_buckets_count];
+} DasAllocStats;
+
+typedef struct {
+	// the slot starts and ends on a cache line, so threads using the slots next to it do not share any cache lines.
+	// the live and peak bytes of the slot are not used, see DasStatsAlctor.
+	alignas(das_cache_line_size) DasAllocStats stats;
+} _DasStatsAlctorSlot;
+
+typedef struct {
+	DasAlctor inner;
+	// shared by all threads, see above.
+	alignas(das_cache_line_size) uintptr_t live_bytes;
+	uintptr_t peak_live_bytes;
+	_DasStatsAlctorSlot slots[DasStatsAlctor_slots_count];
+} DasStatsAlctor;
+
+//
+// initializes the statistics allocator with all of it's counters at zero.
+//
+// @param(alctor): a pointer the statistics allocator structure to initialize.
+//
+// @param(inner): the allocator that all of the allocations are passed on to.
+//
+void DasStatsAlctor_init(DasStatsAlctor* alctor, DasAlctor inner);
+
+//
+// merges the counters of every slot into a single set of statistics.
+// this can be called while other threads are using the allocator,
+// but the counters may not all be from the same moment in time.
+//
+// @param(alctor): a pointer the statistics allocator structure.
+//
+// @param(stats_out): a pointer to the statistics that are written to.
+//
+void DasStatsAlctor_get(DasStatsAlctor* alctor, DasAllocStats* stats_out);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+// every operation is passed on to the inner allocator and then recorded.
+//
+// reset: the live bytes are set back to 0.
+//
+// alloc: the size is added to the live bytes and the size histogram.
+//
+// realloc: the difference in size is added to the live bytes and the new size is added to the size histogram.
+//     if the pointer has changed then the smaller of the old and new size is counted as moved.
+//
+// dealloc: the old size is taken away from the live bytes.
+//
+void* DasStatsAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the statistics allocator.
+// every operation is passed on to the inner allocator, if it supports it, and then recorded as the DasAllocFn calls it replaces.
+// so wrapping an allocator to profile it, does not change how it is used.
+//
+// DasAllocExtOp_try_expand, DasAllocExtOp_realloc_zeroed: recorded as a realloc.
+//
+// DasAllocExtOp_usable_size: the extra bytes are added to the live bytes, as they can be deallocated later.
+//
+// DasAllocExtOp_alloc_batch, DasAllocExtOp_dealloc_batch: recorded as an alloc or a dealloc for each allocation.
+//
+// DasAllocExtOp_alloc_zeroed: recorded as an alloc.
+//
+// DasAllocExtOp_owns: not recorded.
+//
+DasBool DasStatsAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasStatsAlctor.
+#define DasStatsAlctor_as_das(stats_alctor_ptr) \
+	(DasAlctor){ .fn = DasStatsAlctor_alloc_fn, .data = stats_alctor_ptr, .ext_fn = DasStatsAlctor_alloc_ext_fn };
 
 // ======================================================================
 //
@@ -348,6 +841,51 @@ void* das_system_alloc_fn(void* alloc_data, void* ptr, uintptr_t old_size, uintp
 
 #define das_alloc_reset(alctor) alctor.fn(alctor.data, NULL, 0, 0, 0);
 
+// @return: the number of bytes that can be used at @param(ptr) that was allocated with @param(size) bytes.
+// allocators round up sizes, so this can be more than @param(size) and will be @param(size) if the allocator does not say.
+// from now on, any size from @param(size) up to the returned size can be passed in as the old_size for this allocation.
+static inline uintptr_t das_usable_size(DasAlctor alctor, void* ptr, uintptr_t size, uintptr_t align) {
+	if (!alctor.ext_fn) return size;
+	DasAllocExtArgs args = { .ptr = ptr, .old_size = size, .size = size, .align = align };
+	if (!alctor.ext_fn(alctor.data, DasAllocExtOp_usable_size, &args)) return size;
+	return args.size;
+}
+
+// allocates @param(count) allocations of @param(size) bytes of memory that are aligned to @param(align)
+// and stores them in @param(ptrs_out). allocators that support it will do this in one go,
+// otherwise each allocation is made on it's own.
+// @return: das_true on success, on failure none of them are allocated.
+DasBool das_alloc_batch(DasAlctor alctor, uintptr_t size, uintptr_t align, void** ptrs_out, uintptr_t count);
+
+// deallocates @param(count) allocations in @param(ptrs) that are @param(old_size) bytes of memory that are aligned to @param(align).
+void das_dealloc_batch(DasAlctor alctor, void** ptrs, uintptr_t old_size, uintptr_t align, uintptr_t count);
+
+// allocates @param(size) bytes of zeroed memory that is aligned to @param(align).
+// allocators that get zeroed memory from the OS will skip zeroing it, otherwise the memory is zeroed with memset.
+// @return: an appropriately aligned pointer to the zeroed memory or NULL on failure.
+void* das_alloc_zeroed(DasAlctor alctor, uintptr_t size, uintptr_t align);
+
+// the same as das_realloc but the memory past @param(old_size) is zeroed, see das_alloc_zeroed.
+// @return: the pointer to the reallocated memory or NULL on failure, where @param(ptr) is left as it was.
+void* das_realloc_zeroed(DasAlctor alctor, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+// @return: das_true if @param(ptr) is in the memory of the allocator.
+// this is das_false if the allocator does not support DasAllocExtOp_owns.
+static inline DasBool das_owns(DasAlctor alctor, void* ptr) {
+	if (!alctor.ext_fn) return das_false;
+	DasAllocExtArgs args = { .ptr = ptr };
+	if (!alctor.ext_fn(alctor.data, DasAllocExtOp_owns, &args)) return das_false;
+	return args.count != 0;
+}
+
+// tries to resize @param(old_size) to @param(size) bytes of memory without moving @param(ptr).
+// @return: das_true on success, otherwise the memory is untouched and you will need to das_realloc instead.
+static inline DasBool das_try_expand(DasAlctor alctor, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align) {
+	if (!alctor.ext_fn) return das_false;
+	DasAllocExtArgs args = { .ptr = ptr, .old_size = old_size, .size = size, .align = align };
+	return alctor.ext_fn(alctor.data, DasAllocExtOp_try_expand, &args);
+}
+
 // ======================================================================
 //
 //
@@ -481,6 +1019,7 @@ extern DasBool _DasStk_resize(_DasStkHeader** header_in_out, uintptr_t header_si
 
 // reallocates the capacity of the stack to have enough room for new_cap number of elements.
 // if new_cap is less than DasStk_count(stk_ptr) then new_cap is set to hold atleast DasStk_count(stk_ptr).
+// the capacity can end up larger than new_cap when the allocator has extra usable bytes, see das_usable_size.
 // returns das_false on allocation failure, otherwise das_true
 #define DasStk_resize_cap(stk_ptr, new_cap) \
 	_DasStk_resize_cap((_DasStkHeader**)stk_ptr, sizeof(**(stk_ptr)), new_cap, DasStk_elmt_size(stk_ptr))
@@ -673,6 +1212,7 @@ extern uintptr_t _DasDeque_assert_idx(_DasDequeHeader* header, uintptr_t idx, ui
 
 // reallocates the capacity of the data to have enough room for new_cap number of elements.
 // if new_cap is less than DasDeque_count(deque_ptr) then new_cap is set to DasDeque_count(deque_ptr).
+// the capacity can end up larger than new_cap when the allocator has extra usable bytes, see das_usable_size.
 // returns das_false on allocation failure, otherwise das_true
 #define DasDeque_resize_cap(deque_ptr, new_cap) \
 	_DasDeque_resize_cap((_DasDequeHeader**)deque_ptr, sizeof(**(deque_ptr)), new_cap, DasDeque_elmt_size(deque_ptr))
@@ -944,243 +1484,1826 @@ DasError das_file_flush(DasFileHandle handle);
 // ===========================================================================
 //
 //
-// Virtual Memory Abstraction
+// Trace Allocator
 //
 //
 // ===========================================================================
+//
+// an allocator that wraps another allocator and records every call to it in a binary log file.
+// so the allocation behaviour of a program can be looked at offline.
+//
+// the file starts with a DasTraceHeader and is followed by DasTraceEvent until the end of the file.
+// the events are written in the native byte order of the machine that made the trace.
+//
+// the events are put into DasTraceAlctor_slots_count buffers that are picked using das_thread_idx,
+// so threads do not fight over the same buffer. a buffer is written to the file once it is full,
+// so the events of different threads are not in order in the file. use the timestamp to put them back in order.
+//
+// each slot has two buffers. when one is full, the next event swaps it with the other and writes it to the file
+// after the slot is unlocked, so the other threads on the slot do not spin while the file is being written.
+// the file writes are done under a mutex, threads that find both buffers full wait on that mutex.
+//
 
-typedef uint8_t DasVirtMemProtection;
+#ifndef DasTraceAlctor_slots_count
+#define DasTraceAlctor_slots_count 16
+#endif
+
+#ifndef DasTraceAlctor_slot_events_cap
+#define DasTraceAlctor_slot_events_cap 256
+#endif
+
+#define DasTraceHeader_magic "DASTRACE"
+#define DasTraceHeader_version 1
+
+typedef struct {
+	// is DasTraceHeader_magic without the null terminator.
+	char magic[8];
+	uint32_t version;
+	// the size of each DasTraceEvent in the file.
+	uint32_t event_size;
+} DasTraceHeader;
+
+typedef uint8_t DasTraceOp;
 enum {
-	DasVirtMemProtection_no_access,
-	DasVirtMemProtection_read,
-	DasVirtMemProtection_read_write,
-	DasVirtMemProtection_exec_read,
-	DasVirtMemProtection_exec_read_write,
+	DasTraceOp_reset,
+	DasTraceOp_alloc,
+	DasTraceOp_realloc,
+	DasTraceOp_dealloc,
 };
 
+typedef struct {
+	// the time in nanoseconds from the OS's monotonic clock.
+	uint64_t timestamp_ns;
+	// the ptr argument passed into the DasAllocFn.
+	uint64_t ptr;
+	// the pointer that the DasAllocFn returned.
+	uint64_t new_ptr;
+	uint64_t old_size;
+	uint64_t size;
+	// the das_thread_idx of the thread that made the call.
+	uint32_t thread_idx;
+	DasTraceOp op;
+	// the align argument is always a power of two, so we just store the power.
+	uint8_t align_log2;
+	uint16_t _reserved;
+} DasTraceEvent;
+
+typedef struct {
+	DasSpinLock lock;
+	// the buffer that events are added to.
+	DasTraceEvent* events;
+	// the other buffer, this is NULL while it is being written to the file.
+	DasTraceEvent* spare_events;
+	uint32_t events_count;
+	char _pad[das_cache_line_size - sizeof(DasSpinLock) - 2 * sizeof(DasTraceEvent*) - sizeof(uint32_t)];
+} _DasTraceAlctorSlot;
+
+typedef struct {
+	DasAlctor inner;
+	DasFileHandle file_handle;
+	// the first error that happened when writing the events to the file in DasTraceAlctor_alloc_fn.
+	uintptr_t write_error;
+	DasTraceEvent* events;
+	_DasTraceAlctorSlot slots[DasTraceAlctor_slots_count];
+} DasTraceAlctor;
+
 //
-// @param(page_size_out):
-//     the page size of the OS.
-//     used to align the parameters of the virtual memory functions to a page.
+// initializes the trace allocator by creating the log file at @param(path) and writing the DasTraceHeader.
 //
-// @param(reserve_align_out):
-//     a pointer to recieve the alignment of the virtual memory reserve address.
-//     this is used as the alignment the requested_addr parameter of das_virt_mem_reserve.
-//     this is guaranteed to the be the same as page size or a multiple of it.
-//     On Unix: this is just the page_size
-//     On Windows: this is what known as the page granularity.
+// @param(alctor): a pointer the trace allocator structure to initialize.
+//
+// @param(inner): the allocator that all of the allocations are passed on to.
+//
+// @param(path): the path of the file to write the trace to, an existing file is truncated.
 //
 // @return: 0 on success, otherwise a error code to indicate the error.
 //
-DasError das_virt_mem_page_size(uintptr_t* page_size_out, uintptr_t* reserve_align_out);
+DasError DasTraceAlctor_init(DasTraceAlctor* alctor, DasAlctor inner, char* path);
 
 //
-// reserve a range of the virtual address space but does not commit any physical pages of memory.
-// none of this memory cannot be used until das_virt_mem_commit is called.
+// writes any buffered events to the file.
+// make sure that no other thread is using the allocator while this is called.
+//
+// @param(alctor): a pointer the trace allocator structure.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//     this includes any error that happened when writing events in DasTraceAlctor_alloc_fn.
+//
+DasError DasTraceAlctor_flush(DasTraceAlctor* alctor);
+
+//
+// writes any buffered events to the file and then closes it.
+// make sure that no other thread is using the allocator while this is called.
+//
+// @param(alctor): a pointer the trace allocator structure.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasTraceAlctor_deinit(DasTraceAlctor* alctor);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+// every operation is passed on to the inner allocator and then added to the calling thread's buffer.
+// if the buffer is full, it is written to the file.
+//
+void* DasTraceAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the trace allocator.
+// every operation is passed on to the inner allocator, if it supports it, and then added as events
+// for the DasAllocFn calls it replaces. so the trace is still made of the DasTraceOp's and can be replayed.
+//
+// DasAllocExtOp_try_expand, DasAllocExtOp_usable_size: a realloc that returns the same pointer, if the size has changed.
+//
+// DasAllocExtOp_alloc_batch, DasAllocExtOp_dealloc_batch: an alloc or a dealloc for each allocation.
+//
+// DasAllocExtOp_alloc_zeroed, DasAllocExtOp_realloc_zeroed: an alloc or a realloc.
+//
+// DasAllocExtOp_owns: no event.
+//
+DasBool DasTraceAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasTraceAlctor.
+#define DasTraceAlctor_as_das(trace_alctor_ptr) \
+	(DasAlctor){ .fn = DasTraceAlctor_alloc_fn, .data = trace_alctor_ptr, .ext_fn = DasTraceAlctor_alloc_ext_fn };
+
+// ===========================================================================
+//
+//
+// Guard Allocator
+//
+//
+// ===========================================================================
+//
+// an allocator that wraps another allocator and catches heap overflows and use after frees
+// in a small sample of the allocations. this is cheap enough to leave on in production.
+//
+// roughly 1 in every sample_rate allocations is put in a guarded slot instead of the inner allocator.
+// every slot is a single page that has a guard page on either side that is reserved but never committed.
+// the allocation is placed at the end of the slot's page, so writing past the end will touch the guard page
+// and the OS will fault. when a guarded allocation is deallocated, the slot's page is decommitted,
+// so using it after it is freed will fault too. the freed slots are reused in the order they are freed,
+// to keep a freed slot decommitted for as long as possible.
+//
+// when the fault happens, a report with the kind of error, the allocation and a stacktrace
+// using das_stacktrace is printed to stderr. the fault is then passed on to the handler that was there before.
+// faults outside of the guard allocators are passed straight on to that handler and ours stays installed
+// until the last guard allocator is deinitialized.
+// printing the report is not async signal safe, but the program is already about to crash.
+//
+// allocations that are larger than a page, or have an alignment larger than das_guard_alctor_min_align
+// are always passed on to the inner allocator. the sampling counter is shared by all guard allocators on the thread.
+//
+
+// guarded allocations are aligned to this much, so they are as close to the guard page as they can be.
+#define das_guard_alctor_min_align 16
+
+typedef struct DasGuardAlctor DasGuardAlctor;
+
+typedef struct {
+	void* ptr;
+	uintptr_t size;
+	// the identifier of the next slot in the free list, it is +1 an index so 0 can be used as null.
+	uint32_t next_free_id;
+	uint32_t thread_idx;
+	DasBool is_allocated;
+} _DasGuardSlot;
+
+struct DasGuardAlctor {
+	DasAlctor inner;
+	/*
+	// the data layout of the 'address_space' field, every element is a page.
+
+	guard, slot_0, guard, slot_1, guard, ... slot_n, guard
+	*/
+	void* address_space;
+	uintptr_t reserved_size;
+	uintptr_t page_size;
+	uint32_t slots_count;
+	uint32_t sample_rate;
+	DasSpinLock lock;
+	// a first in first out list of the slots that are free.
+	// the identifiers are +1 an index so 0 can be used as null.
+	uint32_t free_slot_head_id;
+	uint32_t free_slot_tail_id;
+	_DasGuardSlot* slots;
+	// the guard allocators are in a linked list so the fault handler can find the one that faulted.
+	DasGuardAlctor* next_registered;
+};
+
+//
+// initializes the guard allocator, reserves the slots and installs the fault handler.
+//
+// @param(alctor): a pointer the guard allocator structure to initialize.
+//
+// @param(inner): the allocator that all of the allocations that are not sampled are passed on to.
+//
+// @param(slots_count): the most guarded allocations that can be alive at once.
+//     when all of the slots are in use, allocations are passed on to the inner allocator.
+//
+// @param(sample_rate): put roughly 1 in every @param(sample_rate) allocations in a guarded slot.
+//     1 will put every allocation that fits in a guarded slot.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasGuardAlctor_init(DasGuardAlctor* alctor, DasAlctor inner, uint32_t slots_count, uint32_t sample_rate);
+
+//
+// deinitializes the guard allocator and release the address space back to the OS.
+// any guarded allocation that is still alive can no longer be used.
+// when this is the last guard allocator, the fault handler that was installed before ours is put back.
+//
+// @param(alctor): a pointer the guard allocator structure.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasGuardAlctor_deinit(DasGuardAlctor* alctor);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: passed on to the inner allocator, the guarded slots are left alone.
+//
+// alloc: if the allocation is sampled, then put it in a guarded slot.
+//     if not then pass it on to the inner allocator.
+//
+// realloc: if the allocation is guarded, then allocate new memory and copy the old allocation there.
+//     if not then pass it on to the inner allocator.
+//
+// dealloc: if the allocation is guarded, then decommit it's slot.
+//     if not then pass it on to the inner allocator.
+//
+void* DasGuardAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the guard allocator.
+// the operations on allocations that are not guarded are passed on to the inner allocator, if it supports it.
+//
+// DasAllocExtOp_try_expand, DasAllocExtOp_usable_size, DasAllocExtOp_realloc_zeroed:
+//     not supported for a guarded allocation, as it has to stay up against the guard page.
+//
+// DasAllocExtOp_alloc_batch, DasAllocExtOp_alloc_zeroed: not supported for allocations that could be sampled,
+//     so they are made one at a time with DasGuardAlctor_alloc_fn.
+//
+// DasAllocExtOp_dealloc_batch: not supported if any of the allocations are guarded.
+//
+// DasAllocExtOp_owns: checks the slots and the inner allocator.
+//     this is only supported when the inner allocator supports it.
+//
+DasBool DasGuardAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasGuardAlctor.
+#define DasGuardAlctor_as_das(guard_alctor_ptr) \
+	(DasAlctor){ .fn = DasGuardAlctor_alloc_fn, .data = guard_alctor_ptr, .ext_fn = DasGuardAlctor_alloc_ext_fn };
+
+// ===========================================================================
+//
+//
+// Virtual Memory Abstraction
+//
+//
+// ===========================================================================
+
+typedef uint8_t DasVirtMemProtection;
+enum {
+	DasVirtMemProtection_no_access,
+	DasVirtMemProtection_read,
+	DasVirtMemProtection_read_write,
+	DasVirtMemProtection_exec_read,
+	DasVirtMemProtection_exec_read_write,
+};
+
+typedef uint8_t DasVirtMemFlags;
+enum {
+	DasVirtMemFlags_none = 0x0,
+	// back the reserved memory with explicit huge pages.
+	// these are taken from the OS's pool of preallocated huge pages at reserve time,
+	// so reserving will fail if the pool does not have enough of them.
+	// the reserve size and the commit addresses and sizes must be multiples of the huge page size.
+	// On Linux: this uses MAP_HUGETLB with the default hugetlb page size, see das_virt_mem_huge_page_size_with_flags.
+	//     decommitting these needs Linux 5.18 or later.
+	// On Windows: this is ignored. large pages there need the SeLockMemoryPrivilege and have to be
+	//     committed when they are reserved, which does not fit reserving and committing separately.
+	// On other OSs: this is ignored.
+	DasVirtMemFlags_huge_pages = 0x1,
+	// advise the OS to back the reserved memory with transparent huge pages when it is committed.
+	// only whole huge pages that are aligned to the huge page size will be used, see huge_page_align.
+	// On Linux: this uses madvise(MADV_HUGEPAGE).
+	// On other OSs: this is ignored.
+	DasVirtMemFlags_transparent_huge_pages = 0x2,
+	// align the start of the reservation to the huge page size.
+	DasVirtMemFlags_huge_page_align = 0x4,
+};
+
+//
+// @param(page_size_out):
+//     the page size of the OS.
+//     used to align the parameters of the virtual memory functions to a page.
+//
+// @param(reserve_align_out):
+//     a pointer to recieve the alignment of the virtual memory reserve address.
+//     this is used as the alignment the requested_addr parameter of das_virt_mem_reserve.
+//     this is guaranteed to the be the same as page size or a multiple of it.
+//     On Unix: this is just the page_size
+//     On Windows: this is what known as the page granularity.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_page_size(uintptr_t* page_size_out, uintptr_t* reserve_align_out);
+
+//
+// @param(huge_page_size_out):
+//     the size of a transparent huge page, this is 2MBs on most systems.
+//     the reserve size and the commit grow size of memory reserved with
+//     DasVirtMemFlags_transparent_huge_pages or DasVirtMemFlags_huge_page_align should be a multiple of this.
+//     On Linux: this is read from /sys/kernel/mm/transparent_hugepage/hpage_pmd_size.
+//     On Windows: this is GetLargePageMinimum.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_huge_page_size(uintptr_t* huge_page_size_out);
+
+//
+// the same as das_virt_mem_huge_page_size, but gets the size of the huge pages used for memory reserved with @param(flags).
+//
+// @param(flags): when this has DasVirtMemFlags_huge_pages, then the huge page size is the one MAP_HUGETLB uses.
+//     On Linux: this is the default hugetlb page size, read from Hugepagesize in /proc/meminfo.
+//     this can be different to the transparent huge page size, like when the system is booted with default_hugepagesz=1G.
+//
+// @param(huge_page_size_out): the size of a huge page. the reserve size, commit addresses and commit sizes
+//     of memory reserved with @param(flags) should be a multiple of this.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_huge_page_size_with_flags(DasVirtMemFlags flags, uintptr_t* huge_page_size_out);
+
+//
+// reserve a range of the virtual address space but does not commit any physical pages of memory.
+// none of this memory cannot be used until das_virt_mem_commit is called.
 //
 // WARNING: on Windows, you cannot release sub sections of the address space.
 //          you can only release the full reserved address space that is issued by this function call.
 //          there are also restriction on protection, see das_virt_mem_protection_set.
 //
-// @param(requested_addr): the requested start address you wish to reserve.
-//     be a aligned to the reserve_align that is retrieved from das_virt_mem_page_size function.
-//     this is not guaranteed and is only used as hint.
-//     NULL will not be used as a hint, instead the OS will choose an address for you.
+// @param(requested_addr): the requested start address you wish to reserve.
+//     be a aligned to the reserve_align that is retrieved from das_virt_mem_page_size function.
+//     this is not guaranteed and is only used as hint.
+//     NULL will not be used as a hint, instead the OS will choose an address for you.
+//
+// @param(size): the size in bytes you wish to reserve from the @param(requested_addr)
+//     must be a multiple of the reserve_align that is retrieved from das_virt_mem_page_size function.
+//
+// @param(addr_out) a pointer to a value that is set to the start of the reserved block of memory
+//     when this function returns successfully.
+//
+// On Linux: when @param(requested_addr) is NULL, an address range of exactly @param(size) bytes
+//     is taken from the reservation cache if there is one, see das_virt_mem_release.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_reserve(void* requested_addr, uintptr_t size, void** addr_out);
+
+//
+// the same as das_virt_mem_reserve but with options for huge pages, see DasVirtMemFlags.
+// the flags stay with the reserved memory when it is committed and decommitted.
+//
+// @param(flags): the DasVirtMemFlags to reserve the memory with.
+//     when huge_pages or huge_page_align is set, @param(size) must be a multiple of the huge page size.
+//
+DasError das_virt_mem_reserve_with_flags(void* requested_addr, uintptr_t size, DasVirtMemFlags flags, void** addr_out);
+
+//
+// passed in as a NUMA node to let the OS choose the node like it normally does.
+#define das_numa_node_any UINT32_MAX
+
+//
+// @return: the number of NUMA nodes on the system. this is 1 on single node machines
+//     and on OSs where we do not support NUMA.
+//
+uint32_t das_numa_nodes_count(void);
+
+//
+// @return: the NUMA node of the CPU the calling thread is running on.
+//     the thread can be moved to another node by the OS at any time, so this is only a hint.
+//     this is 0 on single node machines and on OSs where we do not support NUMA.
+//
+uint32_t das_numa_node(void);
+
+//
+// the same as das_virt_mem_reserve_with_flags but the OS will prefer to take the physical pages
+// from @param(numa_node) when the memory is committed. if that node runs out of memory,
+// the pages will come from another node instead of failing.
+// nothing is done on single node machines, so the memory is reserved like das_virt_mem_reserve_with_flags.
+//
+// @param(numa_node): the NUMA node to take the pages from, see das_numa_node.
+//     das_numa_node_any lets the OS choose the node.
+//     On Linux: this uses mbind(MPOL_PREFERRED) on the reserved range. the policy is kept when the memory
+//         is committed and decommitted. this is just advice, so errors from mbind are ignored.
+//     On Windows: this uses VirtualAllocExNuma.
+//     On other OSs: this is ignored.
+//
+DasError das_virt_mem_reserve_on_numa_node(void* requested_addr, uintptr_t size, DasVirtMemFlags flags, uint32_t numa_node, void** addr_out);
+
+//
+// requests the OS to commit physical pages of memory to the the address space.
+// this address space must be a full or subsection of the reserved address space with das_virt_mem_reserve.
+// the memory in the commited address space will be zeroed after calling this function.
+//
+// @param(addr): the start address of the memory you wish to commit.
+//     must be a aligned to the page size das_virt_mem_page_size returns.
+//     this is not guaranteed and is only used as hint.
+//     NULL will not be used as a hint.
+//
+// @param(size): the size in bytes you wish to reserve from the @param(addr)
+//     must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @param(protection): what the memory is allowed to be used for
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_commit(void* addr, uintptr_t size, DasVirtMemProtection protection);
+
+//
+// change the protection of a range of memory.
+// this memory must have been reserved with das_virt_mem_reserve.
+//
+// WARNING: on Windows, you can change protection of any number pages
+//          but that they all must come from the same call they where reserved with.
+//
+// @param(addr): the start of the pages you wish to change the protection for.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @param(size): the size in bytes of the memory you wish to change protection for.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @param(protection): what the memory is allowed to be used for
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_protection_set(void* addr, uintptr_t size, DasVirtMemProtection protection);
+
+//
+// gives the memory back to the OS but will keep the address space reserved
+//
+// @param(addr): the start of the pages you wish to decommit.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @param(size): the size in bytes of the memory you wish to release.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_decommit(void* addr, uintptr_t size);
+
+//
+// locks the committed pages into physical memory so they are never paged out to disk.
+// the pages must be unlocked with das_virt_mem_unlock before they are decommitted.
+//
+// @param(addr): the start of the pages you wish to lock.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @param(size): the size in bytes of the memory you wish to lock.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//     this can fail if the process is not allowed to lock this much memory.
+//     On Linux: see RLIMIT_MEMLOCK.
+//     On Windows: see SetProcessWorkingSetSize.
+//
+DasError das_virt_mem_lock(void* addr, uintptr_t size);
+
+//
+// unlocks pages that were locked with das_virt_mem_lock so the OS can page them out again.
+//
+// @param(addr): the start of the pages you wish to unlock.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @param(size): the size in bytes of the memory you wish to unlock.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_unlock(void* addr, uintptr_t size);
+
+//
+// the opt in mode for the allocators that commit memory in chunks, to commit the next chunk ahead of time.
+// once the usage gets within half a chunk of the committed memory, the next chunk is committed
+// and has its pages faulted in on a background worker thread. so the allocating thread does not
+// pay for the commit and the page faults when it gets to the next chunk.
+// if the allocating thread gets there first and the background worker has not started on that chunk,
+// then the allocating thread commits it itself. if it has started, the allocating thread waits for it to finish.
+// the background worker thread is started the first time it is needed and is shared by all allocators.
+//
+typedef uint8_t DasCommitAhead;
+enum {
+	// the allocating thread commits the next chunk when it needs it.
+	DasCommitAhead_none,
+	// commit the next chunk and fault in it's pages on the background worker thread.
+	// On Linux: this uses madvise(MADV_POPULATE_WRITE) and falls back to touching each page.
+	DasCommitAhead_prefault,
+	// the same as prefault, but the pages are also locked into physical memory with das_virt_mem_lock.
+	// locking is just advice, so errors are ignored when the process is not allowed to lock any more memory.
+	DasCommitAhead_prefault_and_lock,
+};
+
+//
+// gives the reserved pages back to the OS. the address range must have be reserved with das_virt_mem_reserve.
+// all commit pages in the released address space are automatically decommit when you release.
+//
+// on non Windows systems only:
+//     you can target sub pages of the original allocation but just make sure the parameters are aligned.
+//
+// WARNING: on Windows, you cannot release sub sections of the address space.
+//          you can only release the full reserved address space that is issued by das_virt_mem_reserve.
+//          so @param(size) is ignored on Windows.
+//
+// @param(addr): the start of the pages you wish to release.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// @param(size): the size in bytes of the memory you wish to release.
+//             must be a aligned to the page size das_virt_mem_page_size returns.
+//
+// On Linux: when the reservation cache is turned on with das_virt_mem_cache_set_budget,
+//     the address range is decommitted and kept in a process wide reservation cache,
+//     so the next das_virt_mem_reserve of the same size does not need mmap. this saves the mmap and munmap
+//     system calls and the kernel setting up and tearing down the mapping. the decommit still makes
+//     the other cores flush their TLBs, just like the munmap would. address ranges are only cached while the cache
+//     is under the budget and the ranges reserved with flags or a NUMA node are never cached.
+//     WARNING: a cached address range is still mapped, so do not release memory that overlaps
+//     memory that has already been released. keep the budget at 0 if you need to do this.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_release(void* addr, uintptr_t size);
+
+//
+// On Linux: sets the maximum number of bytes of address space that are kept in the reservation cache, see das_virt_mem_release.
+// 0 turns off the cache. if the cache is over the new budget, then it is flushed.
+// this does nothing on other platforms.
+//
+// @param(budget): the maximum number of bytes of address space to keep in the cache.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_cache_set_budget(uintptr_t budget);
+
+//
+// gives all of the address ranges in the reservation cache back to the OS, see das_virt_mem_release.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_cache_flush(void);
+
+//
+// @return: the number of bytes of address space that are in the reservation cache, see das_virt_mem_release.
+//
+uintptr_t das_virt_mem_cache_size(void);
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+typedef void* DasMapFileHandle; // unused
+#elif _WIN32
+typedef HANDLE DasMapFileHandle;
+#endif
+
+//
+// maps a file to the virtual address space of the process.
+//
+// @param(requested_addr): see the same parameter in das_virt_mem_reserve for more info.
+//
+// @param(file_handle): the handle to the file opened with das_file_open
+//
+// @param(protection): what the memory is allowed to be used for.
+//     this must match with the file_handle's access rights
+//     see das_file_open and DasFileFlags.
+//
+// @param(offset): offset into the file in bytes this does not have to be aligned in anyway.
+//     internally it will round this down to the nearest reserve_align and map that.
+//
+// @param(size): size of the file in bytes starting from the offset that you wish to map into the address space.
+//     this does not have to be aligned in anyway but it will round this up to the page size internally and map that.
+//
+// @param(addr_out) a pointer to a value that is set to the address pointing to the offset into the file that was requested
+//     when this function returns successfully.
+//
+// @param(map_file_handle_out): a pointer that is set apon success to the handle of the map file.
+//     this is only used in Windows and must be passed into das_virt_mem_unmap_file to unmap correctly.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_map_file(void* requested_addr, DasFileHandle file_handle, DasVirtMemProtection protection, uint64_t offset, uintptr_t size, void** addr_out, DasMapFileHandle* map_file_handle_out);
+
+
+//
+// unmaps a file that was mapped into the virtual address space by das_virt_mem_map_file.
+//
+// @param(addr): the address that was returned when mapping the file.
+//
+// @param(size): the size that was used when mapping the file.
+//
+// @param(map_file_handle): the map file handle that was returned when mapping the file.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError das_virt_mem_unmap_file(void* addr, uintptr_t size, DasMapFileHandle map_file_handle);
+
+// ===========================================================================
+//
+//
+// Linear Allocator
+//
+//
+// ===========================================================================
+//
+// this linear allocator directly reserve address space and commits chunks
+// of memory as and when they are needed. so you can reserve 2GBs and no
+// memory is taken up on the system.
+// all allocated memory is zeroed by the OS when the commit new chunks.
+//
+// the position can be saved and restored with DasLinearAlctor_save and DasLinearAlctor_restore,
+// to free everything that was allocated in between in O(1). the committed memory is kept,
+// so memory that is allocated again after a restore is not zeroed.
+//
+// committed memory past the position can be given back to the OS with DasLinearAlctor_shrink.
+// by default a reset decommits everything, a retention policy can be set with DasLinearAlctor_retention_set
+// to keep the memory that is usually needed committed, so the next use does not page fault it all in again.
+//
+
+typedef struct {
+	void* address_space;
+	uintptr_t pos;
+	uintptr_t commited_size;
+	uintptr_t commit_grow_size;
+	uintptr_t reserved_size;
+	// the highest position since the last reset, this is updated when the position goes down in a restore.
+	uintptr_t peak_pos;
+	// the end of the memory that has been used since it was committed, this is updated when the position goes down in a restore.
+	// the commited memory past this and the position is still zeroed by the OS.
+	uintptr_t dirty_pos;
+	// the exponentially decayed average of the peak position at each reset.
+	uintptr_t retained_size;
+	// the weight of the newest peak position in retained_size is 1 / (1 << retention_shift).
+	// 0 means nothing is retained on reset.
+	uint8_t retention_shift;
+	// see DasLinearAlctor_commit_ahead_set.
+	DasCommitAhead commit_ahead;
+	// the state of the next chunk when it is being committed ahead on the background worker thread.
+	uintptr_t commit_ahead_state;
+	// only used by DasLinearAlctor_concurrent_alloc_fn so only one thread commits memory at a time.
+	DasSpinLock commit_lock;
+} DasLinearAlctor;
+
+//
+// initializes the linear allocator and reserves the address space
+// needed to store @param(reserved_size) in bytes.
+//
+// @param(alctor): a pointer the linear allocator structure to initialize.
+//
+// @param(reserved_size): the maximum size the linear allocator can expand to in bytes.
+//
+// @param(commit_grow_size): the amount of memory that is commit when the linear allocator needs to grow
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasLinearAlctor_init(DasLinearAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size);
+
+//
+// the same as DasLinearAlctor_init but reserves the address space with the DasVirtMemFlags.
+// if any of the flags are set, the reserved_size and commit_grow_size are rounded up to the huge page size.
+// transparent_huge_pages will also align the address space to the huge page size,
+// as only whole aligned huge pages are used by the OS.
+//
+// @param(flags): the DasVirtMemFlags to reserve the memory with.
+//
+DasError DasLinearAlctor_init_with_flags(DasLinearAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size, DasVirtMemFlags flags);
+
+//
+// the same as DasLinearAlctor_init_with_flags but the memory is committed on @param(numa_node).
+//
+// @param(numa_node): see das_virt_mem_reserve_on_numa_node.
+//
+DasError DasLinearAlctor_init_on_numa_node(DasLinearAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size, DasVirtMemFlags flags, uint32_t numa_node);
+
+//
+// deinitializes the linear allocator and release the address space back to the OS
+//
+// @param(alctor): a pointer the linear allocator structure.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasLinearAlctor_deinit(DasLinearAlctor* alctor);
+
+//
+// a saved position of a linear allocator that can be restored later on.
+typedef uintptr_t DasLinearAlctorMarker;
+
+//
+// saves the current position of the linear allocator.
+//
+// @param(alctor): a pointer the linear allocator structure.
+//
+// @return: the marker to pass into DasLinearAlctor_restore.
+//
+DasLinearAlctorMarker DasLinearAlctor_save(DasLinearAlctor* alctor);
+
+//
+// restores the position of the linear allocator back to a marker that was saved earlier.
+// all allocations made after the marker was saved are freed, but the memory stays committed.
+// markers can be nested, but restoring a marker makes any marker saved after it invalid.
+//
+// @param(alctor): a pointer the linear allocator structure.
+//
+// @param(marker): the marker returned from DasLinearAlctor_save.
+//
+void DasLinearAlctor_restore(DasLinearAlctor* alctor, DasLinearAlctorMarker marker);
+
+//
+// decommits the memory past the current position and @param(keep_size) back to the OS.
+// the memory is decommitted in multiples of the commit_grow_size.
+// this is NOT thread safe, make sure no other thread is using the allocator.
+//
+// @param(alctor): a pointer the linear allocator structure.
+//
+// @param(keep_size): the size in bytes from the start of the address space to keep committed
+//     even if the current position is below it. 0 will decommit everything past the current position.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasLinearAlctor_shrink(DasLinearAlctor* alctor, uintptr_t keep_size);
+
+//
+// sets how much memory is kept committed when the linear allocator is reset.
+// on each reset, the peak position since the last reset is added into an exponentially decayed average
+// and only the memory past that average is decommitted.
+// so memory stays committed for a steady workload and is slowly given back after a spike or when the usage drops.
+// the memory that is kept committed is not zeroed when it is allocated again.
+//
+// @param(alctor): a pointer the linear allocator structure.
+//
+// @param(retention_shift): the weight of the newest peak in the average is 1 / (1 << retention_shift).
+//     so a higher value remembers the peaks for more resets. 0 disables retention and resets decommit everything.
+//
+void DasLinearAlctor_retention_set(DasLinearAlctor* alctor, uint8_t retention_shift);
+
+//
+// sets the mode to commit the next chunk of memory ahead of time on the background worker thread.
+// this works with the single threaded and the concurrent alloc functions.
+// this is NOT thread safe, make sure no other thread is using the allocator.
+//
+// @param(alctor): a pointer the linear allocator structure.
+//
+// @param(commit_ahead): the DasCommitAhead mode.
+//
+void DasLinearAlctor_commit_ahead_set(DasLinearAlctor* alctor, DasCommitAhead commit_ahead);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: set the next allocation position back to 0 and decommit all existing memory back to the OS,
+//     except the memory kept by the retention policy, see DasLinearAlctor_retention_set.
+//
+// alloc: try to bump up the next allocation position if there is enough commited memory and return the pointer to the zeroed memory.
+//     if go past the commited memory then try to commit more if it has not reache the maximum reserved size already.
+//     if we have exhausted the reserve size, then the allocation fails.
+//
+// realloc: if this was the previous allocation then try to extend the allocation in place.
+//     if not then allocate new memory and copy the old allocation there.
+//
+// dealloc: do nothing
+//
+void* DasLinearAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the linear allocator.
+//
+// DasAllocExtOp_try_expand: succeeds if this was the previous allocation and the reserved size has not been exhausted.
+//
+// DasAllocExtOp_alloc_batch: the allocations are made with a single bump of the next allocation position.
+//
+// DasAllocExtOp_dealloc_batch: does nothing.
+//
+// DasAllocExtOp_owns: checks if the pointer is in the reserved address space.
+//
+// DasAllocExtOp_alloc_zeroed, DasAllocExtOp_realloc_zeroed: only supported when none of the memory past the position
+//     has been used since it was committed, as then it is zeroed by the OS.
+//
+DasBool DasLinearAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasLinearAlctor.
+#define DasLinearAlctor_as_das(linear_alctor_ptr) \
+	(DasAlctor){ .fn = DasLinearAlctor_alloc_fn, .data = linear_alctor_ptr, .ext_fn = DasLinearAlctor_alloc_ext_fn };
+
+//
+// this is a thread safe version of DasLinearAlctor_alloc_fn, so many threads can share a single linear allocator.
+// the next allocation position is bumped using an atomic compare and swap, so there are no locks on the fast path.
+// when the commited memory runs out, only a single thread will commit more memory while the others wait for it.
+//
+// reset: the same as DasLinearAlctor_alloc_fn and is NOT thread safe.
+//     make sure no other thread is using the allocator, this goes for DasLinearAlctor_restore too.
+//
+// alloc: the same as DasLinearAlctor_alloc_fn.
+//
+// realloc: if this was the previous allocation across all threads then try to extend the allocation in place.
+//     if not then allocate new memory and copy the old allocation there.
+//
+// dealloc: do nothing
+//
+void* DasLinearAlctor_concurrent_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the linear allocator that can be shared between threads.
+//
+// DasAllocExtOp_try_expand: succeeds if this was the previous allocation across all threads
+//     and the reserved size has not been exhausted.
+//
+// DasAllocExtOp_alloc_batch: the allocations are made with a single atomic bump of the next allocation position.
+//
+// DasAllocExtOp_dealloc_batch: does nothing.
+//
+// DasAllocExtOp_alloc_zeroed, DasAllocExtOp_realloc_zeroed, DasAllocExtOp_owns: the same as DasLinearAlctor_alloc_ext_fn.
+//
+DasBool DasLinearAlctor_concurrent_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasLinearAlctor that can be shared between threads.
+#define DasLinearAlctor_concurrent_as_das(linear_alctor_ptr) \
+	(DasAlctor){ .fn = DasLinearAlctor_concurrent_alloc_fn, .data = linear_alctor_ptr, .ext_fn = DasLinearAlctor_concurrent_alloc_ext_fn };
+
+// ===========================================================================
+//
+//
+// NUMA Arenas
+//
+//
+// ===========================================================================
+//
+// a set of thread safe linear allocators, one for each NUMA node.
+// a thread gets the arena of the node it is running on, so the memory it allocates
+// is committed on that node and is local to it and the other threads on that node.
+// on single node machines there is just a single arena that all threads share.
+//
+// DasNumaArenas example usage:
+//
+//     DasNumaArenas arenas;
+//     das_assert(!DasNumaArenas_init(&arenas, 1024 * 1024 * 1024, 64 * 1024, DasVirtMemFlags_none), "init failed");
+//
+//     // on each worker thread.
+//     DasAlctor alctor = DasNumaArenas_as_das(&arenas);
+//     float* data = das_alloc_array(float, alctor, 1024);
+//
+
+typedef struct {
+	DasLinearAlctor arenas[das_numa_nodes_max];
+	uint32_t arenas_count;
+} DasNumaArenas;
+
+//
+// initializes a linear allocator for each NUMA node, up to das_numa_nodes_max.
+//
+// @param(arenas): a pointer to the NUMA arenas structure to initialize.
+//
+// @param(reserved_size): the maximum size each arena can expand to in bytes.
+//
+// @param(commit_grow_size): the amount of memory that is commit when an arena needs to grow.
+//
+// @param(flags): the DasVirtMemFlags to reserve the memory of each arena with.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasNumaArenas_init(DasNumaArenas* arenas, uintptr_t reserved_size, uintptr_t commit_grow_size, DasVirtMemFlags flags);
+
+//
+// deinitializes all of the arenas and releases their address space back to the OS.
+//
+// @param(arenas): a pointer to the NUMA arenas structure.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasNumaArenas_deinit(DasNumaArenas* arenas);
+
+//
+// @param(arenas): a pointer to the NUMA arenas structure.
+//
+// @return: the arena for the NUMA node that the calling thread is running on, see das_numa_node.
+//
+DasLinearAlctor* DasNumaArenas_get(DasNumaArenas* arenas);
+
+//
+// creates an instance of the DasAlctor interface using the arena for the NUMA node that the calling thread is running on.
+// the arena is chosen when this is called, so keep hold of the DasAlctor for the duration of the work on this thread.
+#define DasNumaArenas_as_das(arenas_ptr) \
+	DasLinearAlctor_concurrent_as_das(DasNumaArenas_get(arenas_ptr))
+
+// ===========================================================================
+//
+//
+// Scratch Arenas
+//
+//
+// ===========================================================================
+//
+// every thread has das_scratch_arenas_count linear allocators that are used for temporary memory.
+// they are lazily initialized on the first das_scratch_begin for that thread.
+//
+// das_scratch_begin saves the position of a scratch arena and das_scratch_end restores it.
+// so everything allocated in between is freed in O(1) and the committed memory is kept for next time.
+//
+// a function that takes an allocator to return it's results in, can pass that allocator
+// as a conflict to das_scratch_begin. it will then get a different scratch arena for it's
+// temporary memory, so the results are not freed when the scratch ends.
+//
+// Scratch API example usage:
+//
+// DasStk(int) get_numbers(DasAlctor result_alctor) {
+//     DasScratch scratch = das_scratch_begin(&result_alctor, 1);
+//     // ... use scratch.alctor for temporary allocations
+//     // ... use result_alctor for the returned stack
+//     das_scratch_end(&scratch);
+// }
+//
+
+typedef struct {
+	DasAlctor alctor;
+	DasLinearAlctor* arena;
+	DasLinearAlctorMarker marker;
+} DasScratch;
+
+//
+// gets one of this thread's scratch arenas that is not in @param(conflicts)
+// and saves it's position so it can be restored by das_scratch_end.
+//
+// @param(conflicts): an array of allocators that the scratch arena must not be.
+//     this can be NULL if @param(conflicts_count) is 0
+//
+// @param(conflicts_count): the number of elements in @param(conflicts)
+//
+// @return: the scratch with the allocator to use for temporary memory.
+//     this will abort if every scratch arena is in @param(conflicts).
+//
+DasScratch das_scratch_begin(DasAlctor* conflicts, uint32_t conflicts_count);
+
+//
+// restores the scratch arena to where it was at das_scratch_begin
+// and frees everything that was allocated in between.
+//
+// @param(scratch): the scratch returned from das_scratch_begin.
+//
+void das_scratch_end(DasScratch* scratch);
+
+//
+// releases this thread's scratch arenas back to the OS.
+// call this before a thread exits if it has used the scratch arenas.
+//
+void das_scratch_thread_deinit(void);
+
+// ===========================================================================
+//
+//
+// Frame Allocator
+//
+//
+// ===========================================================================
+//
+// a double buffered allocator for work that is done every frame or tick.
+// it has two linear allocators and allocates from one of them for the whole frame.
+// DasFrameAlctor_next_frame swaps them, so the allocations from the previous frame are still valid
+// for the whole of the current frame, and the arena from the frame before that is reused.
+//
+// the arena is reset without decommitting it, so the memory allocated in a frame is not zeroed.
+// each arena keeps the highest position it reached over das_frame_alctor_decommit_frames_count frames
+// and after that many frames, the memory past it is decommitted. so a single big frame does not keep
+// it's memory committed forever, but frames that use the same amount never commit and decommit.
+//
+// Frame API example usage:
+//
+// DasFrameAlctor frame_alctor;
+// DasFrameAlctor_init(&frame_alctor, 64 * 1024 * 1024, 64 * 1024);
+// DasAlctor alctor = DasFrameAlctor_as_das(&frame_alctor);
+// while (running) {
+//     DasFrameAlctor_next_frame(&frame_alctor);
+//     // ... allocate with alctor, the allocations from last frame can still be read
+// }
+//
+
+typedef struct {
+	DasLinearAlctor arenas[2];
+	// the index into the arenas that the current frame allocates from.
+	uint32_t arena_idx;
+	// the number of frames each arena has been used for since it last decommitted.
+	uint32_t frames_count[2];
+	// the highest position each arena has reached since it last decommitted.
+	uintptr_t high_water_pos[2];
+} DasFrameAlctor;
+
+//
+// initializes the frame allocator and reserves the address space for both arenas.
+//
+// @param(alctor): a pointer the frame allocator structure to initialize.
+//
+// @param(reserved_size): the maximum size that each arena can expand to in bytes.
+//
+// @param(commit_grow_size): the amount of memory that is commit when an arena needs to grow
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasFrameAlctor_init(DasFrameAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size);
+
+//
+// releases the address space of both arenas back to the OS.
+//
+// @param(alctor): a pointer the frame allocator structure to deinitialize.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasFrameAlctor_deinit(DasFrameAlctor* alctor);
+
+//
+// starts the next frame by swapping the arenas. the allocations of the current frame stay valid,
+// but the allocations of the previous frame are freed as that arena is reset to be used for the next frame.
+//
+// @param(alctor): a pointer the frame allocator structure.
+//
+void DasFrameAlctor_next_frame(DasFrameAlctor* alctor);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: reset and decommit both of the arenas back to the OS.
+//
+// alloc: allocate from the current frame's arena, see DasLinearAlctor_alloc_fn
+//
+// realloc: if this was the previous allocation in the current frame's arena then try to extend the allocation in place.
+//     if not then allocate new memory in the current frame's arena and copy the old allocation there.
+//     so an allocation from the previous frame can be reallocated to carry it over to this frame.
+//
+// dealloc: do nothing
+//
+void* DasFrameAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the frame allocator, these are the same as DasLinearAlctor_alloc_ext_fn
+// on the current frame's arena.
+//
+// DasAllocExtOp_owns: checks if the pointer is in either of the arenas.
+//
+DasBool DasFrameAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasFrameAlctor.
+#define DasFrameAlctor_as_das(frame_alctor_ptr) \
+	(DasAlctor){ .fn = DasFrameAlctor_alloc_fn, .data = frame_alctor_ptr, .ext_fn = DasFrameAlctor_alloc_ext_fn };
+
+// ===========================================================================
+//
+//
+// Ring Allocator
+//
+//
+// ===========================================================================
+//
+// a circular allocator for short lived allocations that are deallocated in roughly the order they were allocated.
+// allocations are made at the head of the ring and wrap around to the start when they reach the end.
+// every allocation has a small header, deallocating marks the header as freed and the tail moves forward
+// past all of the freed allocations at the tail. so an allocation that is deallocated out of order
+// will hold up the tail until all the allocations before it have been deallocated too.
+//
+// when the ring is full, or the allocation cannot fit in it, then the fallback allocator is used instead.
+// the memory is reserved up front and committed as the head first moves through it.
+// this allocator is not thread safe.
+//
+
+typedef struct {
+	DasAlctor fallback;
+	void* address_space;
+	uintptr_t size;
+	uintptr_t commited_size;
+	uintptr_t page_size;
+	// these only ever increase, their offset in the ring is them modulo the size.
+	// the ring is empty when they are equal.
+	uint64_t head_pos;
+	uint64_t tail_pos;
+} DasRingAlctor;
+
+//
+// initializes the ring allocator and reserves the address space for the ring.
+//
+// @param(alctor): a pointer the ring allocator structure to initialize.
+//
+// @param(size): the size of the ring in bytes, this is rounded up to the reserve alignment.
+//
+// @param(fallback): the allocator that is used when an allocation does not fit in the ring.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasRingAlctor_init(DasRingAlctor* alctor, uintptr_t size, DasAlctor fallback);
+
+//
+// releases the ring back to the OS, this does not deallocate anything from the fallback allocator.
+//
+// @param(alctor): a pointer the ring allocator structure to deinitialize.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasRingAlctor_deinit(DasRingAlctor* alctor);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: empty the ring without decommitting it and pass the reset on to the fallback allocator.
+//
+// alloc: allocate at the head of the ring, wrapping around to the start if it does not fit before the end.
+//     if the ring is full then allocate from the fallback allocator.
+//
+// realloc: if this is the allocation at the head of the ring then try to extend the allocation in place.
+//     if not then allocate new memory and copy the old allocation there.
+//     allocations from the fallback allocator are passed on to it.
+//
+// dealloc: mark the allocation as freed and move the tail past all of the freed allocations.
+//     allocations from the fallback allocator are passed on to it.
+//
+void* DasRingAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the ring allocator.
+//
+// DasAllocExtOp_owns: checks if the pointer is in the ring, otherwise it is passed on to the fallback allocator.
+//     this is only supported when the fallback allocator supports it too.
+//
+DasBool DasRingAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasRingAlctor.
+#define DasRingAlctor_as_das(ring_alctor_ptr) \
+	(DasAlctor){ .fn = DasRingAlctor_alloc_fn, .data = ring_alctor_ptr, .ext_fn = DasRingAlctor_alloc_ext_fn };
+
+// ===========================================================================
+//
+//
+// Slab Allocator
+//
+//
+// ===========================================================================
+//
+// an allocator for lots of small allocations. a single reservation of address space
+// is carved up into page sized slabs, and each slab only holds blocks of a single size class.
+// the size classes are the powers of two from 16 bytes up to DasSlabAlctor_max_size.
+//
+// every slab has a bitmap of it's allocated blocks that is stored separately from the slab memory.
+// so blocks are packed tightly together, and deallocation is O(1) since the slab of
+// a block is found directly from it's address.
+//
+// slabs are committed as and when they are needed, and when a slab becomes empty
+// it's memory is decommitted and given back to the OS.
+// one empty slab per size class is kept around, so allocating and deallocating
+// a single block over and over does not keep going to the OS.
+//
+// this allocator requires a page size of atleast 4KBs.
+//
+
+#define DasSlabAlctor_min_size 16
+#define DasSlabAlctor_max_size 2048
+#define DasSlabAlctor_classes_count 8
+
+typedef struct {
+	/*
+	// the data layout of the 'address_space' field
+
+	uint8_t slabs[slabs_cap][slab_size]
+	_DasSlab slab_metadata[slabs_cap] // each is 'slab_metadata_size' in bytes
+	*/
+	void* address_space;
+	uintptr_t reserved_size;
+	uintptr_t slab_metadata_commited_size;
+	uint32_t slab_size;
+	uint32_t slab_metadata_size;
+	uint32_t slabs_cap;
+	// the number of slabs that have ever been used, slabs after this have never been touched.
+	uint32_t slabs_count;
+	// the head of the linked list of empty slabs that have been decommitted.
+	uint32_t free_slab_head_id;
+	// the head of the linked list of slabs that have free blocks for each size class.
+	uint32_t partial_slab_head_ids[DasSlabAlctor_classes_count];
+} DasSlabAlctor;
+
+//
+// initializes the slab allocator and reserves the address space
+// needed to store @param(reserved_size) in bytes worth of slabs.
+//
+// @param(alctor): a pointer the slab allocator structure to initialize.
+//
+// @param(reserved_size): the maximum size in bytes of all the slabs put together.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasSlabAlctor_init(DasSlabAlctor* alctor, uintptr_t reserved_size);
+
+//
+// deinitializes the slab allocator and release the address space back to the OS
+//
+// @param(alctor): a pointer the slab allocator structure.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasSlabAlctor_deinit(DasSlabAlctor* alctor);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: decommit all of the slabs back to the OS and start again.
+//
+// alloc: take the first free block in a slab of the size class.
+//     if there is no slabs with free blocks, then a new slab is committed for the size class.
+//     the allocation fails if the size or alignment is larger than DasSlabAlctor_max_size
+//     or if there is no more slabs left in the reserved address space.
+//
+// realloc: if the size class has not changed then return the same pointer.
+//     if not then allocate new memory and copy the old allocation there.
+//
+// dealloc: mark the block as free in the slab's bitmap.
+//     if the slab becomes empty then it is decommitted.
+//
+void* DasSlabAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the slab allocator.
+//
+// DasAllocExtOp_usable_size: the size class of the slab the allocation is in.
+//
+// DasAllocExtOp_owns: checks if the pointer is in one of the slabs that have been used.
+//
+DasBool DasSlabAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasSlabAlctor.
+#define DasSlabAlctor_as_das(slab_alctor_ptr) \
+	(DasAlctor){ .fn = DasSlabAlctor_alloc_fn, .data = slab_alctor_ptr, .ext_fn = DasSlabAlctor_alloc_ext_fn };
+
+// ===========================================================================
+//
+//
+// TLSF Allocator
+//
+//
+// ===========================================================================
+//
+// a two level segregated fit allocator for when you need a general purpose allocator
+// that has a bounded worst case time for every operation.
+//
+// free blocks are kept in segregated lists, a first level for the power of two size range
+// and a second level that splits that range into DasTlsfAlctor_sl_count linear parts.
+// a bitmap for each level is used to find a free block that is big enough using a couple of
+// bit scan instructions. so alloc, dealloc and realloc are O(1), there is no searching through lists.
+// neighbouring free blocks are always merged on dealloc.
+//
+// the memory comes from a reservation of address space that is committed in chunks
+// of commit_grow_size from the start to the end. committing is the only operation that is not O(1)
+// since it calls into the OS, you can avoid it by committing everything up front with a
+// commit_grow_size that is the same as the reserved_size.
+//
+// every block is aligned to 16 bytes and has a 16 byte header.
+// realloc will grow in place if the next block is free, and will commit more memory in place
+// if the allocation is at the end of the committed memory.
+//
+
+#define DasTlsfAlctor_sl_count_log2 4
+#define DasTlsfAlctor_sl_count (1 << DasTlsfAlctor_sl_count_log2)
+// the first level goes up to blocks of 256GBs
+#define DasTlsfAlctor_fl_count 31
+
+typedef struct _DasTlsfBlock _DasTlsfBlock;
+
+typedef struct {
+	void* address_space;
+	uintptr_t commited_size;
+	uintptr_t commit_grow_size;
+	uintptr_t reserved_size;
+	// a set bit means there is a free block in the first level's size range.
+	uint32_t fl_bitmap;
+	// a set bit means there is a free block in the first level's second level size range.
+	uint32_t sl_bitmaps[DasTlsfAlctor_fl_count];
+	_DasTlsfBlock* free_list_heads[DasTlsfAlctor_fl_count][DasTlsfAlctor_sl_count];
+} DasTlsfAlctor;
+
+//
+// initializes the TLSF allocator and reserves the address space
+// needed to store @param(reserved_size) in bytes.
+//
+// @param(alctor): a pointer the TLSF allocator structure to initialize.
+//
+// @param(reserved_size): the maximum size the TLSF allocator can expand to in bytes.
+//
+// @param(commit_grow_size): the amount of memory that is commit when the TLSF allocator needs to grow
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasTlsfAlctor_init(DasTlsfAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size);
+
+//
+// deinitializes the TLSF allocator and release the address space back to the OS
+//
+// @param(alctor): a pointer the TLSF allocator structure.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasTlsfAlctor_deinit(DasTlsfAlctor* alctor);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: decommit all of the memory back to the OS and start again.
+//
+// alloc: take a free block from the first non empty list that holds blocks that are big enough.
+//     the rest of the block is split off into a new free block.
+//     if there is no free block big enough, then commit more memory.
+//     if we have exhausted the reserve size, then the allocation fails.
+//
+// realloc: if the new size fits in the block, then split off the rest of the block.
+//     if the next block is free and is big enough, then merge with it in place.
+//     if not then allocate new memory and copy the old allocation there.
+//
+// dealloc: merge the block with the previous and next blocks if they are free,
+//     and put it in the free list for it's size.
+//
+void* DasTlsfAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the TLSF allocator.
+//
+// DasAllocExtOp_usable_size: the size of the block's payload, as blocks that are too small to split off are kept.
+//
+// DasAllocExtOp_owns: checks if the pointer is in the committed memory.
+//
+DasBool DasTlsfAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasTlsfAlctor.
+#define DasTlsfAlctor_as_das(tlsf_alctor_ptr) \
+	(DasAlctor){ .fn = DasTlsfAlctor_alloc_fn, .data = tlsf_alctor_ptr, .ext_fn = DasTlsfAlctor_alloc_ext_fn };
+
+// ===========================================================================
 //
-// @param(size): the size in bytes you wish to reserve from the @param(requested_addr)
-//     must be a multiple of the reserve_align that is retrieved from das_virt_mem_page_size function.
 //
-// @param(addr_out) a pointer to a value that is set to the start of the reserved block of memory
-//     when this function returns successfully.
+// Buddy Allocator
 //
-// @return: 0 on success, otherwise a error code to indicate the error.
 //
-DasError das_virt_mem_reserve(void* requested_addr, uintptr_t size, void** addr_out);
+// ===========================================================================
+//
+// an allocator for medium to large allocations that hands out blocks that are
+// a power of two number of pages. a block of a size is split in half until
+// it is the smallest power of two that can hold the allocation. the two halves of
+// a split block are buddies, and when both of them are free they are merged back together.
+// since the buddy of a block is found directly from it's address, merging is cheap.
+//
+// the memory comes from a single reservation of address space. the pages of a block are
+// only committed when they are used by an allocation, and are decommitted as soon as
+// the block is deallocated. the block metadata is stored separately from the block memory.
+//
+// realloc grows in place by merging with the free buddies that come after the block.
+// so a doubling growth strategy like a DasStk uses will often not copy anything,
+// as the buddy of the block is free when the block is the last allocation in it's area.
+//
+// the allocation alignment can be no larger than the page size.
+//
+
+// blocks can be a maximum of 2^(DasBuddyAlctor_orders_count - 1) pages
+#define DasBuddyAlctor_orders_count 32
+
+typedef struct {
+	/*
+	// the data layout of the 'address_space' field
+
+	uint8_t pages[pages_count][page_size]
+	_DasBuddyBlock block_metadata[pages_count]
+	*/
+	void* address_space;
+	uintptr_t reserved_size;
+	uintptr_t page_size;
+	uint32_t page_size_log2;
+	uint32_t pages_count;
+	// the order of the single block that covers all of the pages.
+	uint32_t max_order;
+	// the head of the linked list of free blocks for each order.
+	// the identifiers are +1 the index of the block's first page so 0 can be used as null.
+	uint32_t free_block_head_ids[DasBuddyAlctor_orders_count];
+} DasBuddyAlctor;
 
 //
-// requests the OS to commit physical pages of memory to the the address space.
-// this address space must be a full or subsection of the reserved address space with das_virt_mem_reserve.
-// the memory in the commited address space will be zeroed after calling this function.
+// initializes the buddy allocator and reserves the address space
+// needed to store @param(reserved_size) in bytes worth of blocks and their metadata.
 //
-// @param(addr): the start address of the memory you wish to commit.
-//     must be a aligned to the page size das_virt_mem_page_size returns.
-//     this is not guaranteed and is only used as hint.
-//     NULL will not be used as a hint.
+// @param(alctor): a pointer the buddy allocator structure to initialize.
 //
-// @param(size): the size in bytes you wish to reserve from the @param(addr)
-//     must be a aligned to the page size das_virt_mem_page_size returns.
+// @param(reserved_size): the maximum size in bytes of all the blocks put together.
+//     this will be rounded up to the next power of two.
 //
-// @param(protection): what the memory is allowed to be used for
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasBuddyAlctor_init(DasBuddyAlctor* alctor, uintptr_t reserved_size);
+
+//
+// deinitializes the buddy allocator and release the address space back to the OS
+//
+// @param(alctor): a pointer the buddy allocator structure.
 //
 // @return: 0 on success, otherwise a error code to indicate the error.
 //
-DasError das_virt_mem_commit(void* addr, uintptr_t size, DasVirtMemProtection protection);
+DasError DasBuddyAlctor_deinit(DasBuddyAlctor* alctor);
 
 //
-// change the protection of a range of memory.
-// this memory must have been reserved with das_virt_mem_reserve.
+// this is the allocator alloc function used in the DasAlctor interface.
 //
-// WARNING: on Windows, you can change protection of any number pages
-//          but that they all must come from the same call they where reserved with.
+// reset: decommit all of the blocks back to the OS and start again.
 //
-// @param(addr): the start of the pages you wish to change the protection for.
-//             must be a aligned to the page size das_virt_mem_page_size returns.
+// alloc: take a free block of the smallest order that fits the size,
+//     splitting larger free blocks in half until there is one.
+//     only the pages that the size covers are committed.
+//     the allocation fails if the alignment is larger than the page size
+//     or if there is no free block big enough.
 //
-// @param(size): the size in bytes of the memory you wish to change protection for.
-//             must be a aligned to the page size das_virt_mem_page_size returns.
+// realloc: if the order is the same then commit any extra pages and return the same pointer.
+//     if the order is smaller, then the upper halves are split off and freed.
+//     if the order is larger, then try to merge with the free buddies after the block in place.
+//     if not then allocate new memory and copy the old allocation there.
 //
-// @param(protection): what the memory is allowed to be used for
+// dealloc: decommit the block and merge it with it's buddy for as long as it's buddy is free.
 //
-// @return: 0 on success, otherwise a error code to indicate the error.
+void* DasBuddyAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
 //
-DasError das_virt_mem_protection_set(void* addr, uintptr_t size, DasVirtMemProtection protection);
+// the extended operations of the buddy allocator.
+//
+// DasAllocExtOp_usable_size: the size rounded up to the page size, as that is what has been committed.
+//
+// DasAllocExtOp_owns: checks if the pointer is in the pages.
+//
+DasBool DasBuddyAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
 
 //
-// gives the memory back to the OS but will keep the address space reserved
+// creates an instance of the DasAlctor interface using a DasBuddyAlctor.
+#define DasBuddyAlctor_as_das(buddy_alctor_ptr) \
+	(DasAlctor){ .fn = DasBuddyAlctor_alloc_fn, .data = buddy_alctor_ptr, .ext_fn = DasBuddyAlctor_alloc_ext_fn };
+
+// ===========================================================================
 //
-// @param(addr): the start of the pages you wish to decommit.
-//             must be a aligned to the page size das_virt_mem_page_size returns.
 //
-// @param(size): the size in bytes of the memory you wish to release.
-//             must be a aligned to the page size das_virt_mem_page_size returns.
+// Block Allocator
 //
-// @return: 0 on success, otherwise a error code to indicate the error.
 //
-DasError das_virt_mem_decommit(void* addr, uintptr_t size);
+// ===========================================================================
+//
+// a fixed size block allocator that uses the DasAlctor interface, so it can be used for anything
+// that allocates the same size over and over again, like das_alloc_elmt or a DasStk with a known max size.
+// it has the speed of the DasPool, but without the identifiers and the records.
+//
+// the blocks are in a reserved address space and are committed in chunks as they are needed.
+// the free blocks are kept in a free list that is stored inside of the blocks themselves.
+// blocks that come from a newly committed chunk are zeroed, but blocks that have been reused are not.
+// this allocator is not thread safe.
+//
+
+typedef struct {
+	// the start of the blocks, this is aligned to block_align.
+	void* address_space;
+	// the start of the reserved address space, this is before address_space when block_align is larger than the reserve alignment.
+	void* reserved_address_space;
+	// the extra bytes that were reserved to align address_space.
+	uintptr_t align_pad;
+	// the next pointer of a free block is stored in the first bytes of the block.
+	void* free_list_head;
+	uintptr_t block_size;
+	uintptr_t block_align;
+	// the position after the last block that has ever been allocated.
+	uintptr_t pos;
+	uintptr_t commited_size;
+	uintptr_t commit_grow_size;
+	uintptr_t reserved_size;
+} DasBlockAlctor;
 
 //
-// gives the reserved pages back to the OS. the address range must have be reserved with das_virt_mem_reserve.
-// all commit pages in the released address space are automatically decommit when you release.
+// initializes the block allocator and reserves the address space for the blocks.
 //
-// on non Windows systems only:
-//     you can target sub pages of the original allocation but just make sure the parameters are aligned.
+// @param(alctor): a pointer the block allocator structure to initialize.
 //
-// WARNING: on Windows, you cannot release sub sections of the address space.
-//          you can only release the full reserved address space that is issued by das_virt_mem_reserve.
-//          so @param(size) is ignored on Windows.
+// @param(block_size): the size of every block in bytes.
+//     this is rounded up to be a multiple of @param(block_align) and be big enough to store a pointer.
 //
-// @param(addr): the start of the pages you wish to release.
-//             must be a aligned to the page size das_virt_mem_page_size returns.
+// @param(block_align): the alignment of every block, this must be a power of two.
+//     this can be larger than the page size, then a little more address space is reserved to align the first block.
 //
-// @param(size): the size in bytes of the memory you wish to release.
-//             must be a aligned to the page size das_virt_mem_page_size returns.
+// @param(reserved_cap): the maximum number of blocks the allocator can expand to.
+//     this is rounded up to fill the reserve alignment.
+//
+// @param(commit_grow_count): the number of blocks to commit when the allocator needs to grow.
+//     this is rounded up to fill the page size.
 //
 // @return: 0 on success, otherwise a error code to indicate the error.
 //
-DasError das_virt_mem_release(void* addr, uintptr_t size);
+DasError DasBlockAlctor_init(DasBlockAlctor* alctor, uintptr_t block_size, uintptr_t block_align, uintptr_t reserved_cap, uintptr_t commit_grow_count);
 
-#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
-typedef void* DasMapFileHandle; // unused
-#elif _WIN32
-typedef HANDLE DasMapFileHandle;
-#endif
+//
+// releases the address space of the block allocator back to the OS.
+//
+// @param(alctor): a pointer the block allocator structure to deinitialize.
+//
+// @return: 0 on success, otherwise a error code to indicate the error.
+//
+DasError DasBlockAlctor_deinit(DasBlockAlctor* alctor);
 
 //
-// maps a file to the virtual address space of the process.
+// this is the allocator alloc function used in the DasAlctor interface.
 //
-// @param(requested_addr): see the same parameter in das_virt_mem_reserve for more info.
+// reset: decommit all of the blocks back to the OS and start again.
 //
-// @param(file_handle): the handle to the file opened with das_file_open
+// alloc: pop a block off of the free list. if it is empty then take the next block that has never been allocated,
+//     committing the next chunk if needed.
+//     the allocation fails if the size or alignment is larger than the block's or the reserved size has been exhausted.
 //
-// @param(protection): what the memory is allowed to be used for.
-//     this must match with the file_handle's access rights
-//     see das_file_open and DasFileFlags.
+// realloc: returns the same pointer if the new size fits in the block, otherwise the reallocation fails.
 //
-// @param(offset): offset into the file in bytes this does not have to be aligned in anyway.
-//     internally it will round this down to the nearest reserve_align and map that.
+// dealloc: push the block on to the free list.
 //
-// @param(size): size of the file in bytes starting from the offset that you wish to map into the address space.
-//     this does not have to be aligned in anyway but it will round this up to the page size internally and map that.
+void* DasBlockAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
 //
-// @param(addr_out) a pointer to a value that is set to the address pointing to the offset into the file that was requested
-//     when this function returns successfully.
+// the extended operations of the block allocator.
 //
-// @param(map_file_handle_out): a pointer that is set apon success to the handle of the map file.
-//     this is only used in Windows and must be passed into das_virt_mem_unmap_file to unmap correctly.
+// DasAllocExtOp_try_expand: succeeds if the new size fits in the block.
 //
-// @return: 0 on success, otherwise a error code to indicate the error.
+// DasAllocExtOp_usable_size: the block size.
 //
-DasError das_virt_mem_map_file(void* requested_addr, DasFileHandle file_handle, DasVirtMemProtection protection, uint64_t offset, uintptr_t size, void** addr_out, DasMapFileHandle* map_file_handle_out);
+// DasAllocExtOp_alloc_batch: pops the blocks off of the free list and then bumps the position for the rest in one go.
+//
+// DasAllocExtOp_dealloc_batch: links the blocks together and pushes them on to the free list in one go.
+//
+// DasAllocExtOp_alloc_zeroed: only supported when the free list is empty, as new blocks are zeroed by the OS.
+//
+// DasAllocExtOp_owns: checks if the pointer is in one of the blocks that have been allocated.
+//
+DasBool DasBlockAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
 
+//
+// creates an instance of the DasAlctor interface using a DasBlockAlctor.
+#define DasBlockAlctor_as_das(block_alctor_ptr) \
+	(DasAlctor){ .fn = DasBlockAlctor_alloc_fn, .data = block_alctor_ptr, .ext_fn = DasBlockAlctor_alloc_ext_fn };
 
+// ===========================================================================
 //
-// unmaps a file that was mapped into the virtual address space by das_virt_mem_map_file.
 //
-// @param(addr): the address that was returned when mapping the file.
+// Segregator Allocator
 //
-// @param(size): the size that was used when mapping the file.
 //
-// @param(map_file_handle): the map file handle that was returned when mapping the file.
+// ===========================================================================
 //
-// @return: 0 on success, otherwise a error code to indicate the error.
+// an allocator that sends allocations up to a size threshold to one allocator and larger allocations to another.
+// this lets you put the small allocations in a slab or block allocator and send the rest to the system allocator,
+// without having to write an alloc function that does this yourself.
 //
-DasError das_virt_mem_unmap_file(void* addr, uintptr_t size, DasMapFileHandle map_file_handle);
+// the old_size that is passed in to realloc and dealloc is used to find the allocator that owns the memory,
+// so it must be on the same side of the threshold as the size the memory was allocated with.
+// segregators can be nested to split the sizes into more than two ranges.
+// this allocator is thread safe if both of the allocators it uses are.
+//
+// Segregator API example usage:
+//
+// DasSegregatorAlctor segregator;
+// DasSegregatorAlctor_init(&segregator, 256, DasBlockAlctor_as_das(&block_alctor), DasAlctor_system);
+// DasAlctor alctor = DasSegregatorAlctor_as_das(&segregator);
+//
+
+typedef struct {
+	// allocations of this size or smaller go to the small allocator.
+	uintptr_t threshold;
+	DasAlctor small;
+	DasAlctor large;
+} DasSegregatorAlctor;
+
+//
+// initializes the segregator allocator, nothing is allocated.
+//
+// @param(alctor): a pointer the segregator allocator structure to initialize.
+//
+// @param(threshold): allocations of this size or smaller go to @param(small), the rest go to @param(large).
+//
+// @param(small): the allocator for the allocations up to and including @param(threshold).
+//
+// @param(large): the allocator for the allocations larger than @param(threshold).
+//
+void DasSegregatorAlctor_init(DasSegregatorAlctor* alctor, uintptr_t threshold, DasAlctor small, DasAlctor large);
+
+//
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: reset both of the allocators.
+//
+// alloc: allocate from the allocator for the size.
+//
+// realloc: if the old and new size use the same allocator then it is passed on to it.
+//     if not then allocate new memory from the other allocator, copy the old allocation there and deallocate it.
+//
+// dealloc: deallocate from the allocator for the old size.
+//
+void* DasSegregatorAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+
+//
+// the extended operations of the segregator allocator.
+// each operation is passed on to the allocator for the size, if it supports it.
+//
+// DasAllocExtOp_try_expand: fails if the new size needs the other allocator.
+//
+// DasAllocExtOp_usable_size: the usable size from the small allocator is capped to the threshold,
+//     so it can be passed back in as the old size.
+//
+// DasAllocExtOp_realloc_zeroed: when the new size needs the other allocator then the new allocation is made
+//     with das_alloc_zeroed and the old allocation is copied there.
+//
+// DasAllocExtOp_owns: checks if either of the allocators owns the pointer.
+//     this is only supported when both of the allocators support it.
+//
+DasBool DasSegregatorAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasSegregatorAlctor.
+#define DasSegregatorAlctor_as_das(segregator_alctor_ptr) \
+	(DasAlctor){ .fn = DasSegregatorAlctor_alloc_fn, .data = segregator_alctor_ptr, .ext_fn = DasSegregatorAlctor_alloc_ext_fn };
 
 // ===========================================================================
 //
 //
-// Linear Allocator
+// Fallback Allocator
 //
 //
 // ===========================================================================
 //
-// this linear allocator directly reserve address space and commits chunks
-// of memory as and when they are needed. so you can reserve 2GBs and no
-// memory is taken up on the system.
-// all allocated memory is zeroed by the OS when the commit new chunks.
+// an allocator that allocates from a primary allocator and uses a secondary allocator when the primary fails.
+// for example, when a DasLinearAlctor has exhausted it's reserved address space.
+//
+// the primary allocator must support DasAllocExtOp_owns so the fallback allocator
+// knows which allocator to send a realloc and dealloc to.
+// all of the allocators that reserve their own address space support this.
+// allocators made of other allocators, like the segregator, only support it when all of the allocators inside do.
+// this allocator is thread safe if both of the allocators it uses are.
+//
+// Fallback API example usage:
+//
+// DasFallbackAlctor fallback;
+// DasFallbackAlctor_init(&fallback, DasLinearAlctor_as_das(&linear_alctor), DasAlctor_system);
+// DasAlctor alctor = DasFallbackAlctor_as_das(&fallback);
 //
 
 typedef struct {
-	void* address_space;
-	uintptr_t pos;
-	uintptr_t commited_size;
-	uintptr_t commit_grow_size;
-	uintptr_t reserved_size;
-} DasLinearAlctor;
+	DasAlctor primary;
+	DasAlctor secondary;
+} DasFallbackAlctor;
 
 //
-// initializes the linear allocator and reserves the address space
-// needed to store @param(reserved_size) in bytes.
+// initializes the fallback allocator, nothing is allocated.
 //
-// @param(alctor): a pointer the linear allocator structure to initialize.
+// @param(alctor): a pointer the fallback allocator structure to initialize.
 //
-// @param(reserved_size): the maximum size the linear allocator can expand to in bytes.
+// @param(primary): the allocator that is tried first, this must support DasAllocExtOp_owns.
 //
-// @param(commit_grow_size): the amount of memory that is commit when the linear allocator needs to grow
+// @param(secondary): the allocator that is used when @param(primary) fails.
 //
-// @return: 0 on success, otherwise a error code to indicate the error.
+void DasFallbackAlctor_init(DasFallbackAlctor* alctor, DasAlctor primary, DasAlctor secondary);
+
 //
-DasError DasLinearAlctor_init(DasLinearAlctor* alctor, uintptr_t reserved_size, uintptr_t commit_grow_size);
+// this is the allocator alloc function used in the DasAlctor interface.
+//
+// reset: reset both of the allocators.
+//
+// alloc: allocate from the primary allocator and if that fails then the secondary allocator.
+//
+// realloc: if the primary allocator owns the memory then it tries to reallocate it,
+//     if that fails then allocate new memory from the secondary allocator, copy the old allocation there and deallocate it.
+//     otherwise it is passed on to the secondary allocator.
+//
+// dealloc: deallocate from the allocator that owns the memory.
+//
+void* DasFallbackAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
 
 //
-// deinitializes the linear allocator and release the address space back to the OS
+// the extended operations of the fallback allocator.
+// the operations on an existing allocation are passed on to the allocator that owns it, if it supports it.
 //
-// @param(alctor): a pointer the linear allocator structure.
+// DasAllocExtOp_alloc_batch: try the batch with the primary allocator and then the secondary allocator.
 //
-// @return: 0 on success, otherwise a error code to indicate the error.
+// DasAllocExtOp_alloc_zeroed: try the primary allocator and then the secondary allocator.
 //
-DasError DasLinearAlctor_deinit(DasLinearAlctor* alctor);
+// DasAllocExtOp_realloc_zeroed: when the primary allocator fails then the new allocation is made
+//     in the secondary allocator with das_alloc_zeroed and the old allocation is copied there.
+//
+// DasAllocExtOp_owns: checks if either of the allocators owns the pointer.
+//     this is only supported when both of the allocators support it.
+//
+DasBool DasFallbackAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasFallbackAlctor.
+#define DasFallbackAlctor_as_das(fallback_alctor_ptr) \
+	(DasAlctor){ .fn = DasFallbackAlctor_alloc_fn, .data = fallback_alctor_ptr, .ext_fn = DasFallbackAlctor_alloc_ext_fn };
+
+// ===========================================================================
+//
+//
+// Deferred Free Allocator
+//
+//
+// ===========================================================================
+//
+// an allocator that wraps another allocator and defers the deallocations, so the cost of free or munmap
+// for large allocations does not land on a latency critical thread.
+// the deallocated memory is pushed on to a lock free list that is stored inside of the memory itself,
+// then later it is all deallocated to the inner allocator in batches by DasDeferredAlctor_drain.
+// the drain can be called explicitly or it can happen on the background worker thread
+// once the deallocated memory waiting on the list reaches a threshold.
+//
+// allocations, reallocations and deallocations of memory smaller than the min size are passed straight on.
+// the inner allocator must be thread safe if the drain happens on the background worker thread
+// or the allocator is used on multiple threads.
+//
+// Deferred API example usage:
+//
+// DasDeferredAlctor deferred;
+// DasDeferredAlctor_init(&deferred, DasAlctor_system, 64 * 1024, 16 * 1024 * 1024);
+// DasAlctor alctor = DasDeferredAlctor_as_das(&deferred);
+// ...
+// das_dealloc(alctor, big_buffer, big_buffer_size, 16); // returns straight away
+//
+
+typedef struct {
+	DasAlctor inner;
+	// the head of the lock free list of memory that is waiting to be deallocated.
+	void* head;
+	// the number of bytes that are waiting to be deallocated.
+	uintptr_t pending_size;
+	// deallocations smaller than this are passed straight on to the inner allocator.
+	uintptr_t min_size;
+	// when pending_size reaches this, the drain is posted to the background worker thread. 0 means never.
+	uintptr_t drain_threshold;
+	// non zero when a drain has been posted to the background worker thread and has not finished yet.
+	uintptr_t drain_is_posted;
+} DasDeferredAlctor;
+
+//
+// initializes the deferred free allocator, nothing is allocated.
+//
+// @param(alctor): a pointer the deferred free allocator structure to initialize.
+//
+// @param(inner): the allocator that all of the allocations are passed on to.
+//
+// @param(min_size): deallocations smaller than this are passed straight on to @param(inner).
+//     this is raised so the list link fits in the memory.
+//
+// @param(drain_threshold): when this many bytes are waiting to be deallocated, then they are all deallocated
+//     on the background worker thread. 0 means they are only deallocated when DasDeferredAlctor_drain is called.
+//
+void DasDeferredAlctor_init(DasDeferredAlctor* alctor, DasAlctor inner, uintptr_t min_size, uintptr_t drain_threshold);
+
+//
+// waits for a drain on the background worker thread to finish and then drains the rest.
+// this does not deinitialize the inner allocator.
+//
+// @param(alctor): a pointer the deferred free allocator structure to deinitialize.
+//
+void DasDeferredAlctor_deinit(DasDeferredAlctor* alctor);
+
+//
+// deallocates all of the memory that is waiting on the list to the inner allocator,
+// allocations of the same size and alignment are deallocated with das_dealloc_batch.
+// this can be called from any thread at the same time as the allocator is being used.
+//
+// @param(alctor): a pointer the deferred free allocator structure.
+//
+void DasDeferredAlctor_drain(DasDeferredAlctor* alctor);
 
 //
 // this is the allocator alloc function used in the DasAlctor interface.
 //
-// reset: set the next allocation position back to 0 and decommit all existing memory back to the OS
+// reset: drain the list and then reset the inner allocator.
 //
-// alloc: try to bump up the next allocation position if there is enough commited memory and return the pointer to the zeroed memory.
-//     if go past the commited memory then try to commit more if it has not reache the maximum reserved size already.
-//     if we have exhausted the reserve size, then the allocation fails.
+// alloc: passed on to the inner allocator.
 //
-// realloc: if this was the previous allocation then try to extend the allocation in place.
-//     if not then allocate new memory and copy the old allocation there.
+// realloc: passed on to the inner allocator.
 //
-// dealloc: do nothing
+// dealloc: push the memory on to the list if it is at least the min size and aligned for the link,
+//     otherwise it is passed on to the inner allocator.
+//     if this takes the waiting bytes over the drain threshold then a drain is posted to the background worker thread.
 //
-void* DasLinearAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
+void* DasDeferredAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size, uintptr_t size, uintptr_t align);
 
 //
-// creates an instance of the DasAlctor interface using a DasLinearAlctor.
-#define DasLinearAlctor_as_das(linear_alctor_ptr) \
-	(DasAlctor){ .fn = DasLinearAlctor_alloc_fn, .data = linear_alctor_ptr };
+// the extended operations of the deferred free allocator.
+// all of the operations except DasAllocExtOp_dealloc_batch are passed on to the inner allocator, if it supports it.
+// das_dealloc_batch pushes them on to the list one at a time.
+//
+DasBool DasDeferredAlctor_alloc_ext_fn(void* alctor_data, DasAllocExtOp op, DasAllocExtArgs* args);
+
+//
+// creates an instance of the DasAlctor interface using a DasDeferredAlctor.
+#define DasDeferredAlctor_as_das(deferred_alctor_ptr) \
+	(DasAlctor){ .fn = DasDeferredAlctor_alloc_fn, .data = deferred_alctor_ptr, .ext_fn = DasDeferredAlctor_alloc_ext_fn };
 
 // ===========================================================================
 //
@@ -1196,6 +3319,7 @@ void* DasLinearAlctor_alloc_fn(void* alctor_data, void* ptr, uintptr_t old_size,
 // it doesn't make sense making this allocator use the DasAlctor interface.
 // it is very limited only being able to allocate elements of the same type.
 // and the validated identifier should be the main way the elements are accessed.
+// if you want fixed size allocations through the DasAlctor interface then use DasBlockAlctor.
 //
 
 //
@@ -1272,6 +3396,8 @@ struct _DasPool {
 	uint32_t alloced_list_head_id;
 	uint32_t alloced_list_tail_id: 31;
 	uint32_t order_free_list_on_dealloc: 1;
+	DasCommitAhead commit_ahead;
+	uintptr_t commit_ahead_state;
 };
 
 //
@@ -1304,6 +3430,8 @@ typedef struct { \
 	uint32_t alloced_list_head_id; \
 	uint32_t alloced_list_tail_id: 31; \
 	uint32_t order_free_list_on_dealloc: 1; \
+	DasCommitAhead commit_ahead; \
+	uintptr_t commit_ahead_state; \
 } DasPool_##IdType##_##T
 
 //
@@ -1326,8 +3454,28 @@ typedef struct { \
 // @return: 0 on success, otherwise a error code to indicate the error.
 //
 #define DasPool_init(IdType, pool, reserved_cap, commit_grow_count) \
-	_DasPool_init((_DasPool*)pool, reserved_cap, commit_grow_count, sizeof(*(pool)->IdType##_address_space))
-DasError _DasPool_init(_DasPool* pool, uint32_t reserved_cap, uint32_t commit_grow_count, uintptr_t elmt_size);
+	_DasPool_init((_DasPool*)pool, reserved_cap, commit_grow_count, DasVirtMemFlags_none, das_numa_node_any, sizeof(*(pool)->IdType##_address_space))
+
+//
+// the same as DasPool_init but reserves the address space with the DasVirtMemFlags.
+// if any of the flags are set, the page size of the pool is the huge page size.
+// so the reserved memory and the commit grow size are rounded up to the huge page size.
+// transparent_huge_pages will also align the address space to the huge page size,
+// as only whole aligned huge pages are used by the OS.
+//
+// @param(flags): the DasVirtMemFlags to reserve the memory with.
+//
+#define DasPool_init_with_flags(IdType, pool, reserved_cap, commit_grow_count, flags) \
+	_DasPool_init((_DasPool*)pool, reserved_cap, commit_grow_count, flags, das_numa_node_any, sizeof(*(pool)->IdType##_address_space))
+
+//
+// the same as DasPool_init_with_flags but the elements are committed on @param(numa_node).
+//
+// @param(numa_node): see das_virt_mem_reserve_on_numa_node.
+//
+#define DasPool_init_on_numa_node(IdType, pool, reserved_cap, commit_grow_count, flags, numa_node) \
+	_DasPool_init((_DasPool*)pool, reserved_cap, commit_grow_count, flags, numa_node, sizeof(*(pool)->IdType##_address_space))
+DasError _DasPool_init(_DasPool* pool, uint32_t reserved_cap, uint32_t commit_grow_count, DasVirtMemFlags flags, uint32_t numa_node, uintptr_t elmt_size);
 
 //
 // deinitializes the pool by releasing the address space back to the OS and zeroing the pool structure
@@ -1356,6 +3504,19 @@ DasError _DasPool_deinit(_DasPool* pool, uintptr_t elmt_size);
 	_DasPool_reset((_DasPool*)pool, sizeof(*(pool)->IdType##_address_space))
 DasError _DasPool_reset(_DasPool* pool, uintptr_t elmt_size);
 
+//
+// sets the mode to commit the next chunk of elements ahead of time on the background worker thread.
+//
+// @param(IdType): the name of the element identifier made with typedef_DasPoolElmtId
+//
+// @param(pool): a pointer to the pool structure
+//
+// @param(commit_ahead): the DasCommitAhead mode.
+//
+#define DasPool_commit_ahead_set(IdType, pool, commit_ahead) \
+	_DasPool_commit_ahead_set((_DasPool*)pool, commit_ahead, sizeof(*(pool)->IdType##_address_space))
+void _DasPool_commit_ahead_set(_DasPool* pool, DasCommitAhead commit_ahead, uintptr_t elmt_size);
+
 //
 // does a DasPool_reset and then initializes the pool with an array of elements.
 //
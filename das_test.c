@@ -1,6 +1,42 @@
 #include "das.h"
 #include "das.c"
 
+#ifdef _WIN32
+typedef HANDLE TestThread;
+#define TEST_THREAD_FN(name) DWORD WINAPI name(void* arg)
+#define TEST_THREAD_FN_RETURN return 0
+
+static TestThread test_thread_spawn(LPTHREAD_START_ROUTINE fn, void* arg) {
+	TestThread thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+	das_assert(thread != NULL, "failed to create thread");
+	return thread;
+}
+
+static void test_thread_join(TestThread thread) {
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+#else
+#include <pthread.h>
+#include <setjmp.h>
+#include <signal.h>
+typedef pthread_t TestThread;
+#define TEST_THREAD_FN(name) void* name(void* arg)
+#define TEST_THREAD_FN_RETURN return NULL
+
+static TestThread test_thread_spawn(void* (*fn)(void*), void* arg) {
+	TestThread thread;
+	das_assert(pthread_create(&thread, NULL, fn, arg) == 0, "failed to create thread");
+	return thread;
+}
+
+static void test_thread_join(TestThread thread) {
+	pthread_join(thread, NULL);
+}
+#endif
+
+#define TEST_THREADS_COUNT 4
+
 void stk_test() {
 	DasStk(int) stk = NULL;
 
@@ -307,6 +343,23 @@ void virt_mem_tests() {
 		);
 	}
 
+	//
+	// restoring a saved marker rolls back the position but keeps the memory committed.
+	DasLinearAlctorMarker outer_marker = DasLinearAlctor_save(&la_alctor);
+	void* outer_ptr = das_alloc(alctor, 100, 1);
+	DasLinearAlctorMarker inner_marker = DasLinearAlctor_save(&la_alctor);
+	ptr = das_alloc(alctor, commit_grow_size * 3, 1);
+	memset(ptr, 0xac, commit_grow_size * 3);
+	uintptr_t commited_size = la_alctor.commited_size;
+	DasLinearAlctor_restore(&la_alctor, inner_marker);
+	das_assert(la_alctor.commited_size == commited_size, "restore should not decommit any memory");
+	void* inner_ptr = das_alloc(alctor, 16, 1);
+	das_assert(inner_ptr == ptr, "restore should make the allocator reuse the memory after the marker");
+	DasLinearAlctor_restore(&la_alctor, outer_marker);
+	ptr = das_alloc(alctor, 100, 1);
+	das_assert(ptr == outer_ptr, "restore should make the allocator reuse the memory after the outer marker");
+	DasLinearAlctor_restore(&la_alctor, outer_marker);
+
 	//
 	// committing 3 pages and marking the middle as read only
 	reserved_size = das_round_up_nearest_multiple_u(page_size * 3, reserve_align);
@@ -470,12 +523,2137 @@ void pool_tests() {
 	}
 }
 
+void system_large_alloc_test() {
+	DasAlctor alctor = DasAlctor_system;
+
+	//
+	// large allocations are grown and shrunk with the contents kept,
+	// for normal and over aligned allocations.
+	for (uintptr_t align = 16; align <= 2 * 1024 * 1024; align *= 256) {
+		uintptr_t size = das_system_mmap_threshold * 2;
+		uint8_t* ptr = das_alloc(alctor, size, align);
+		das_assert(ptr && (uintptr_t)ptr % align == 0, "test failed: large system allocation is not aligned to %zu", align);
+		memset(ptr, 0xac, size);
+
+		uintptr_t new_size = das_system_mmap_threshold * 8;
+		ptr = das_realloc(alctor, ptr, size, new_size, align);
+		das_assert(ptr && (uintptr_t)ptr % align == 0, "test failed: large system reallocation is not aligned to %zu", align);
+		for (uintptr_t i = 0; i < size; i += 1) {
+			das_assert(ptr[i] == 0xac, "test failed: large system reallocation has not preserved the memory");
+		}
+		memset(ptr, 0xbd, new_size);
+
+		//
+		// shrink to below the threshold and then grow past it again
+		ptr = das_realloc(alctor, ptr, new_size, 100, align);
+		das_assert(ptr && (uintptr_t)ptr % align == 0, "test failed: system reallocation is not aligned to %zu", align);
+		ptr = das_realloc(alctor, ptr, 100, size, align);
+		das_assert(ptr && (uintptr_t)ptr % align == 0, "test failed: large system reallocation is not aligned to %zu", align);
+		for (uintptr_t i = 0; i < 100; i += 1) {
+			das_assert(ptr[i] == 0xbd, "test failed: system reallocation across the threshold has not preserved the memory");
+		}
+		das_dealloc(alctor, ptr, size, align);
+	}
+
+	//
+	// a large stack that keeps doubling.
+	DasStk(int) stk = NULL;
+	DasStk_init_with_alctor(&stk, 0, alctor);
+	for (int i = 0; i < 4 * 1024 * 1024; i += 1) {
+		DasStk_push(&stk, &i);
+	}
+	for (int i = 0; i < 4 * 1024 * 1024; i += 1) {
+		das_assert(*DasStk_get(&stk, i) == i, "test failed: large system stack has been corrupted");
+	}
+	DasStk_deinit(&stk);
+}
+
+void try_expand_test() {
+	DasLinearAlctor la_alctor = {0};
+	DasError error = DasLinearAlctor_init(&la_alctor, 64 * 1024 * 1024, 4096);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor alctor = DasLinearAlctor_as_das(&la_alctor);
+
+	//
+	// only the last allocation can be expanded in place
+	void* a = das_alloc(alctor, 64, 16);
+	void* b = das_alloc(alctor, 64, 16);
+	das_assert(!das_try_expand(alctor, a, 64, 128, 16), "test failed: linear try expand should fail when it is not the last allocation");
+	das_assert(das_try_expand(alctor, b, 64, 128 * 1024, 16), "test failed: linear try expand should extend the last allocation");
+	das_assert(la_alctor.pos == das_ptr_diff(b, la_alctor.address_space) + 128 * 1024, "test failed: linear try expand has not moved the position");
+	das_assert(!das_try_expand(alctor, b, 128 * 1024, la_alctor.reserved_size, 16), "test failed: linear try expand should fail past the reserved size");
+
+	//
+	// a wrapped around deque that is grown in place, only has to move the wrapped elements
+	das_alloc_reset(alctor);
+	DasDeque(int) deque = NULL;
+	DasDeque_init_with_alctor(&deque, 16, alctor);
+	for (int i = 0; i < 16; i += 1) {
+		DasDeque_push_back(&deque, &i);
+	}
+	DasDeque_pop_front_many(&deque, 10);
+	for (int i = 16; i < 26; i += 1) {
+		DasDeque_push_back(&deque, &i);
+	}
+	void* deque_header = deque;
+	for (int i = 26; i < 64; i += 1) {
+		DasDeque_push_back(&deque, &i);
+	}
+	das_assert((void*)deque == deque_header, "test failed: deque should have grown in place");
+	for (int i = 0; i < 54; i += 1) {
+		das_assert(*DasDeque_get(&deque, i) == i + 10, "test failed: deque was corrupted when grown in place");
+	}
+
+	//
+	// and one that cannot grow in place is copied to a new block without wrapping
+	a = das_alloc(alctor, 16, 16);
+	for (int i = 64; i < 256; i += 1) {
+		DasDeque_pop_front(&deque);
+		DasDeque_push_back(&deque, &i);
+		DasDeque_push_back(&deque, &i);
+	}
+	//
+	// 192 were popped, the first 54 were the elements from before and the rest are the pairs pushed from 64.
+	for (uintptr_t i = 0; i < DasDeque_count(&deque); i += 1) {
+		int expected = 64 + (int)(i + 192 - 54) / 2;
+		das_assert(*DasDeque_get(&deque, i) == expected, "test failed: deque was corrupted when moved to a new block");
+	}
+
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+#ifdef __linux__
+	//
+	// large system allocations try to extend their mapping in place
+	alctor = DasAlctor_system;
+	uintptr_t size = das_system_mmap_threshold * 2;
+	uint8_t* ptr = das_alloc(alctor, size, 16);
+	memset(ptr, 0xac, size);
+	if (das_try_expand(alctor, ptr, size, size * 2, 16)) {
+		memset(ptr + size, 0xbd, size);
+		size *= 2;
+	}
+	das_assert(!das_try_expand(alctor, ptr, size, 100, 16), "test failed: system try expand cannot move an allocation out of a mapping");
+	das_dealloc(alctor, ptr, size, 16);
+#endif
+}
+
+void usable_size_test() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	//
+	// size classes report the whole class as usable
+	DasSlabAlctor slab_alctor;
+	error = DasSlabAlctor_init(&slab_alctor, page_size * 64);
+	das_assert(error == 0, "failed to initialize the slab allocator: 0x%x", error);
+	DasAlctor alctor = DasSlabAlctor_as_das(&slab_alctor);
+
+	void* ptr = das_alloc(alctor, 20, 4);
+	das_assert(das_usable_size(alctor, ptr, 20, 4) == 32, "test failed: slab usable size should be the size class");
+	das_dealloc(alctor, ptr, 32, 4);
+
+	//
+	// a stack uses the whole size class for it's capacity.
+	// 64 bytes of elements and the header go in the 128 byte size class.
+	DasStk(uint8_t) stk = NULL;
+	DasStk_init_with_alctor(&stk, 64, alctor);
+	das_assert(DasStk_cap(&stk) == 128 - sizeof(*stk), "test failed: stack should use the usable size for it's capacity but got %zu", DasStk_cap(&stk));
+	void* stk_data = DasStk_data(&stk);
+	for (uint8_t i = 0; i < 128 - sizeof(*stk); i += 1) {
+		DasStk_push(&stk, &i);
+	}
+	das_assert(DasStk_data(&stk) == stk_data, "test failed: stack should not have been reallocated");
+	DasStk_deinit(&stk);
+
+	error = DasSlabAlctor_deinit(&slab_alctor);
+	das_assert(error == 0, "failed to deinitialize the slab allocator: 0x%x", error);
+
+	alctor = DasAlctor_tcache;
+	ptr = das_alloc(alctor, 100, 8);
+	das_assert(das_usable_size(alctor, ptr, 100, 8) == 128, "test failed: tcache usable size should be the size class");
+	das_dealloc(alctor, ptr, 128, 8);
+
+	//
+	// the buddy allocator commits whole pages
+	DasBuddyAlctor buddy_alctor;
+	error = DasBuddyAlctor_init(&buddy_alctor, page_size * 64);
+	das_assert(error == 0, "failed to initialize the buddy allocator: 0x%x", error);
+	alctor = DasBuddyAlctor_as_das(&buddy_alctor);
+
+	ptr = das_alloc(alctor, 100, 8);
+	uintptr_t usable_size = das_usable_size(alctor, ptr, 100, 8);
+	das_assert(usable_size == page_size, "test failed: buddy usable size should be the commited pages");
+	memset(ptr, 0xac, usable_size);
+	das_dealloc(alctor, ptr, usable_size, 8);
+
+	error = DasBuddyAlctor_deinit(&buddy_alctor);
+	das_assert(error == 0, "failed to deinitialize the buddy allocator: 0x%x", error);
+
+	//
+	// the system allocator is atleast the size asked for
+	alctor = DasAlctor_system;
+	for (uintptr_t size = 1; size <= das_system_mmap_threshold * 4; size *= 3) {
+		ptr = das_alloc(alctor, size, 16);
+		usable_size = das_usable_size(alctor, ptr, size, 16);
+		das_assert(usable_size >= size, "test failed: system usable size is smaller than the allocation");
+		memset(ptr, 0xac, usable_size);
+		ptr = das_realloc(alctor, ptr, usable_size, size * 2, 16);
+		das_dealloc(alctor, ptr, size * 2, 16);
+	}
+
+	//
+	// allocators that do not say, use the size asked for
+	DasLinearAlctor la_alctor = {0};
+	error = DasLinearAlctor_init(&la_alctor, page_size * 64, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	alctor = DasLinearAlctor_as_das(&la_alctor);
+	ptr = das_alloc(alctor, 100, 8);
+	das_assert(das_usable_size(alctor, ptr, 100, 8) == 100, "test failed: linear usable size should be the size asked for");
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+}
+
+void batch_alloc_test() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	void* ptrs[1024];
+
+	//
+	// the linear allocator bumps once for the whole batch
+	DasLinearAlctor la_alctor = {0};
+	error = DasLinearAlctor_init(&la_alctor, page_size * 64, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor alctor = DasLinearAlctor_as_das(&la_alctor);
+
+	das_alloc(alctor, 1, 1);
+	das_assert(das_alloc_batch(alctor, 24, 16, ptrs, 100), "test failed: linear batch allocation failed");
+	for (uintptr_t i = 0; i < 100; i += 1) {
+		das_assert((uintptr_t)ptrs[i] % 16 == 0, "test failed: linear batch allocation is not aligned");
+		das_assert(ptrs[i] == das_ptr_add(ptrs[0], i * 32), "test failed: linear batch allocations should be tightly packed");
+	}
+	das_assert(la_alctor.pos == das_ptr_diff(ptrs[99], la_alctor.address_space) + 24, "test failed: linear batch allocation did not bump the position");
+
+	uintptr_t pos = la_alctor.pos;
+	das_assert(!das_alloc_batch(alctor, page_size, 16, ptrs, 1024), "test failed: linear batch allocation past the reserved size should fail");
+	das_assert(la_alctor.pos == pos, "test failed: a failed linear batch allocation should not move the position");
+	das_dealloc_batch(alctor, ptrs, 24, 16, 100);
+
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+	//
+	// the system allocator
+	alctor = DasAlctor_system;
+	das_assert(das_alloc_batch(alctor, 48, 64, ptrs, 1024), "test failed: system batch allocation failed");
+	for (uintptr_t i = 0; i < 1024; i += 1) {
+		das_assert((uintptr_t)ptrs[i] % 64 == 0, "test failed: system batch allocation is not aligned");
+		memset(ptrs[i], 0xac, 48);
+	}
+	das_dealloc_batch(alctor, ptrs, 48, 64, 1024);
+
+	//
+	// allocators that do not support batches, fallback to one at a time
+	// and give back the ones they have allocated if it fails.
+	DasSlabAlctor slab_alctor;
+	error = DasSlabAlctor_init(&slab_alctor, page_size * 2);
+	das_assert(error == 0, "failed to initialize the slab allocator: 0x%x", error);
+	alctor = DasSlabAlctor_as_das(&slab_alctor);
+
+	uintptr_t blocks_count = slab_alctor.slabs_cap * (page_size / 64);
+	das_assert(blocks_count < 1024, "page size is too big for this test");
+	das_assert(!das_alloc_batch(alctor, 64, 8, ptrs, blocks_count + 1), "test failed: slab batch allocation should fail when it runs out of slabs");
+	das_assert(das_alloc_batch(alctor, 64, 8, ptrs, blocks_count), "test failed: slab batch allocation should fit after the failed one was given back");
+	das_dealloc_batch(alctor, ptrs, 64, 8, blocks_count);
+
+	error = DasSlabAlctor_deinit(&slab_alctor);
+	das_assert(error == 0, "failed to deinitialize the slab allocator: 0x%x", error);
+}
+
+static void zeroed_alloc_test_check(uint8_t* ptr, uintptr_t size, char* what) {
+	das_assert(ptr, "test failed: %s allocation failed", what);
+	for (uintptr_t i = 0; i < size; i += 1) {
+		das_assert(ptr[i] == 0, "test failed: %s memory is not zeroed at byte %zu", what, i);
+	}
+}
+
+void zeroed_alloc_test() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	//
+	// the linear allocator only zeros for free when the memory past the position has not been used since it was committed.
+	DasLinearAlctor la_alctor = {0};
+	error = DasLinearAlctor_init(&la_alctor, page_size * 64, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor alctor = DasLinearAlctor_as_das(&la_alctor);
+
+	uint8_t* ptr = das_alloc(alctor, page_size * 2, 1);
+	memset(ptr, 0xac, page_size * 2);
+	DasLinearAlctor_restore(&la_alctor, 0);
+	ptr = das_alloc_zeroed(alctor, page_size, 1);
+	zeroed_alloc_test_check(ptr, page_size, "linear");
+	ptr = das_realloc_zeroed(alctor, ptr, page_size, page_size * 3, 1);
+	zeroed_alloc_test_check(ptr, page_size * 3, "linear realloc");
+
+	//
+	// shrinking the last allocation in place marks the memory past it as used.
+	memset(ptr, 0xac, page_size * 3);
+	ptr = das_realloc(alctor, ptr, page_size * 3, 16, 1);
+	ptr = das_alloc_zeroed(alctor, page_size * 2, 1);
+	zeroed_alloc_test_check(ptr, page_size * 2, "linear after an in place shrink");
+
+	//
+	// a zeroed stack, on dirty memory and on memory that is still zeroed by the OS.
+	das_alloc_reset(alctor);
+	ptr = das_alloc(alctor, page_size * 4, 1);
+	memset(ptr, 0xac, page_size * 4);
+	DasLinearAlctor_restore(&la_alctor, 0);
+	DasStk(uint32_t) stk;
+	das_assert(DasStk_init_with_alctor(&stk, 16, alctor), "test failed: failed to initialize the stack");
+	memset(DasStk_data(&stk), 0xac, DasStk_cap(&stk) * sizeof(uint32_t));
+	das_assert(DasStk_resize(&stk, 4096, das_true), "test failed: failed to resize the stack");
+	zeroed_alloc_test_check((uint8_t*)DasStk_data(&stk), 4096 * sizeof(uint32_t), "zeroed stack resize");
+	das_assert(DasStk_resize(&stk, 2, das_false), "test failed: failed to resize the stack");
+	memset(DasStk_data(&stk), 0xac, DasStk_cap(&stk) * sizeof(uint32_t));
+	das_assert(DasStk_resize(&stk, 8192, das_true), "test failed: failed to resize the stack");
+	das_assert(*DasStk_get(&stk, 1) == 0xacacacac, "test failed: zeroed stack resize should not zero the existing elements");
+	zeroed_alloc_test_check((uint8_t*)DasStk_get(&stk, 2), 8190 * sizeof(uint32_t), "zeroed stack resize past the old capacity");
+	DasStk_deinit(&stk);
+
+	//
+	// on dirty memory, the zeroed operations are not supported so growing a stack by one element
+	// only zeros that element and not all of the new capacity.
+	das_alloc_reset(alctor);
+	ptr = das_alloc(alctor, page_size * 4, 1);
+	memset(ptr, 0xac, page_size * 4);
+	DasLinearAlctor_restore(&la_alctor, 0);
+	DasAllocExtArgs args = { .size = 64, .align = 1 };
+	das_assert(!alctor.ext_fn(alctor.data, DasAllocExtOp_alloc_zeroed, &args) && la_alctor.pos == 0, "test failed: the linear zeroed alloc should not be supported on dirty memory");
+	das_assert(DasStk_init_with_alctor(&stk, 16, alctor), "test failed: failed to initialize the stack");
+	uintptr_t old_cap = DasStk_cap(&stk);
+	das_assert(DasStk_resize(&stk, old_cap, das_false), "test failed: failed to resize the stack");
+	das_assert(DasStk_resize(&stk, old_cap + 1, das_true), "test failed: failed to resize the stack");
+	das_assert(*DasStk_get(&stk, old_cap) == 0, "test failed: zeroed stack resize did not zero the new element");
+	das_assert(DasStk_cap(&stk) > old_cap + 1 && ((uint32_t*)DasStk_data(&stk))[old_cap + 1] == 0xacacacac, "test failed: zeroed stack resize should only zero the new elements");
+	DasStk_deinit(&stk);
+
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+	//
+	// the system allocator, including a mapping that was used before it was shrunk and grown again.
+	alctor = DasAlctor_system;
+	uintptr_t sizes[] = { 24, 4096, das_system_mmap_threshold * 2 };
+	for (uint32_t i = 0; i < 3; i += 1) {
+		ptr = das_alloc_zeroed(alctor, sizes[i], 16);
+		zeroed_alloc_test_check(ptr, sizes[i], "system");
+		das_dealloc(alctor, ptr, sizes[i], 16);
+	}
+
+	uintptr_t size = das_system_mmap_threshold * 2;
+	ptr = das_alloc(alctor, size, 16);
+	memset(ptr, 0xac, size);
+	ptr = das_realloc(alctor, ptr, size, size / 2 + 1, 16);
+	ptr = das_realloc_zeroed(alctor, ptr, size / 2 + 1, size * 2, 16);
+	zeroed_alloc_test_check(ptr + size / 2 + 1, size * 2 - (size / 2 + 1), "system mapping realloc");
+	das_assert(ptr[size / 2] == 0xac, "test failed: system zeroed realloc should keep the old memory");
+	das_dealloc(alctor, ptr, size * 2, 16);
+
+	//
+	// the block allocator only zeros the blocks it has used before.
+	DasBlockAlctor block_alctor;
+	error = DasBlockAlctor_init(&block_alctor, 64, 16, 256, 64);
+	das_assert(error == 0, "failed to initialize the block allocator: 0x%x", error);
+	alctor = DasBlockAlctor_as_das(&block_alctor);
+	ptr = das_alloc_zeroed(alctor, 64, 16);
+	zeroed_alloc_test_check(ptr, 64, "new block");
+	memset(ptr, 0xac, 64);
+	das_dealloc(alctor, ptr, 64, 16);
+	ptr = das_alloc_zeroed(alctor, 64, 16);
+	zeroed_alloc_test_check(ptr, 64, "reused block");
+	error = DasBlockAlctor_deinit(&block_alctor);
+	das_assert(error == 0, "failed to deinitialize the block allocator: 0x%x", error);
+
+	//
+	// allocators that do not support it, are zeroed with memset.
+	DasSlabAlctor slab_alctor;
+	error = DasSlabAlctor_init(&slab_alctor, page_size * 2);
+	das_assert(error == 0, "failed to initialize the slab allocator: 0x%x", error);
+	alctor = DasSlabAlctor_as_das(&slab_alctor);
+	ptr = das_alloc(alctor, 64, 8);
+	memset(ptr, 0xac, 64);
+	das_dealloc(alctor, ptr, 64, 8);
+	ptr = das_alloc_zeroed(alctor, 64, 8);
+	zeroed_alloc_test_check(ptr, 64, "slab");
+	ptr = das_realloc_zeroed(alctor, ptr, 64, 128, 8);
+	zeroed_alloc_test_check(ptr, 128, "slab realloc");
+	error = DasSlabAlctor_deinit(&slab_alctor);
+	das_assert(error == 0, "failed to deinitialize the slab allocator: 0x%x", error);
+}
+
+void combinator_alloc_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	//
+	// small allocations go to the block allocator and the rest go to the system allocator.
+	DasBlockAlctor block_alctor;
+	error = DasBlockAlctor_init(&block_alctor, 64, 16, 1024, 64);
+	das_assert(error == 0, "failed to initialize the block allocator: 0x%x", error);
+	DasAlctor small = DasBlockAlctor_as_das(&block_alctor);
+
+	DasSegregatorAlctor segregator;
+	DasSegregatorAlctor_init(&segregator, 48, small, DasAlctor_system);
+	DasAlctor alctor = DasSegregatorAlctor_as_das(&segregator);
+
+	uint8_t* small_ptr = das_alloc(alctor, 32, 16);
+	uint8_t* large_ptr = das_alloc(alctor, 128, 16);
+	das_assert(das_owns(small, small_ptr), "test failed: small allocation did not go to the small allocator");
+	das_assert(!das_owns(small, large_ptr), "test failed: large allocation went to the small allocator");
+	das_assert(!das_owns(alctor, small_ptr), "test failed: a segregator with the system allocator cannot know if it owns an allocation");
+	das_assert(das_usable_size(alctor, small_ptr, 32, 16) == 48, "test failed: usable size of a small allocation should be capped to the threshold");
+
+	for (uint32_t i = 0; i < 32; i += 1) small_ptr[i] = i;
+	uint8_t* ptr = das_realloc(alctor, small_ptr, 32, 256, 16);
+	das_assert(!das_owns(small, ptr), "test failed: growing past the threshold should move to the large allocator");
+	for (uint32_t i = 0; i < 32; i += 1) {
+		das_assert(ptr[i] == i, "test failed: segregator realloc did not copy the allocation");
+	}
+	ptr = das_realloc(alctor, ptr, 256, 16, 16);
+	das_assert(das_owns(small, ptr), "test failed: shrinking to the threshold should move to the small allocator");
+	das_assert(ptr[15] == 15, "test failed: segregator realloc did not copy the allocation");
+	das_assert(!das_try_expand(alctor, ptr, 16, 128, 16), "test failed: try expand should not cross the threshold");
+	das_dealloc(alctor, ptr, 16, 16);
+	das_dealloc(alctor, large_ptr, 128, 16);
+
+	ptr = das_alloc(small, 64, 16);
+	das_assert(ptr == small_ptr, "test failed: segregator dealloc did not go back to the small allocator");
+	das_dealloc(small, ptr, 64, 16);
+
+	//
+	// the system allocator cannot say if it owns memory, so a segregator that uses it cannot either.
+	// otherwise it would say no for it's own large allocations and a fallback allocator would send them to the secondary.
+	DasAllocExtArgs owns_args = { .ptr = small_ptr };
+	das_assert(!DasSegregatorAlctor_alloc_ext_fn(&segregator, DasAllocExtOp_owns, &owns_args),
+		"test failed: a segregator with the system allocator should not support owns");
+
+	//
+	// a segregator made of allocators that all support owns, can be the primary of a fallback allocator.
+	DasLinearAlctor large_linear_alctor;
+	error = DasLinearAlctor_init(&large_linear_alctor, page_size * 16, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor large = DasLinearAlctor_as_das(&large_linear_alctor);
+	DasSegregatorAlctor_init(&segregator, 48, small, large);
+	DasAlctor segregator_alctor = DasSegregatorAlctor_as_das(&segregator);
+	owns_args.ptr = small_ptr;
+	das_assert(DasSegregatorAlctor_alloc_ext_fn(&segregator, DasAllocExtOp_owns, &owns_args) && owns_args.count,
+		"test failed: a segregator with allocators that support owns should support owns");
+
+	DasFallbackAlctor segregator_fallback;
+	DasFallbackAlctor_init(&segregator_fallback, segregator_alctor, DasAlctor_system);
+	alctor = DasFallbackAlctor_as_das(&segregator_fallback);
+	large_ptr = das_alloc(alctor, 256, 16);
+	das_assert(das_owns(segregator_alctor, large_ptr), "test failed: the large allocation should come from the primary");
+	memset(large_ptr, 0xac, 256);
+	ptr = das_realloc(alctor, large_ptr, 256, 512, 16);
+	das_assert(ptr == large_ptr, "test failed: the realloc should have extended the primary's linear allocation in place");
+	das_dealloc(alctor, ptr, 512, 16);
+	error = DasLinearAlctor_deinit(&large_linear_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+	error = DasBlockAlctor_deinit(&block_alctor);
+	das_assert(error == 0, "failed to deinitialize the block allocator: 0x%x", error);
+
+	//
+	// the linear allocator is used until it is exhausted, then the system allocator takes over.
+	DasLinearAlctor la_alctor;
+	error = DasLinearAlctor_init(&la_alctor, page_size, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor primary = DasLinearAlctor_as_das(&la_alctor);
+
+	DasFallbackAlctor fallback;
+	DasFallbackAlctor_init(&fallback, primary, DasAlctor_system);
+	alctor = DasFallbackAlctor_as_das(&fallback);
+
+	uintptr_t alloc_size = 256;
+	uintptr_t allocs_count = la_alctor.reserved_size / alloc_size + 4;
+	uint8_t** ptrs = das_alloc_array(uint8_t*, DasAlctor_system, allocs_count);
+	for (uintptr_t i = 0; i < allocs_count; i += 1) {
+		ptrs[i] = das_alloc(alctor, alloc_size, 16);
+		das_assert(ptrs[i], "test failed: fallback allocation failed");
+		memset(ptrs[i], (int)i, alloc_size);
+		das_assert(das_owns(primary, ptrs[i]) == (i < allocs_count - 4), "test failed: fallback allocation %zu went to the wrong allocator", i);
+	}
+
+	//
+	// growing a linear allocation that does not fit anymore moves it to the secondary allocator.
+	uintptr_t idx = allocs_count - 5;
+	ptr = das_realloc(alctor, ptrs[idx], alloc_size, alloc_size * 2, 16);
+	das_assert(ptr && !das_owns(primary, ptr), "test failed: fallback realloc should move to the secondary allocator");
+	das_assert(ptr[alloc_size - 1] == (uint8_t)idx, "test failed: fallback realloc did not copy the allocation");
+	ptrs[idx] = ptr;
+
+	for (uintptr_t i = 0; i < allocs_count; i += 1) {
+		das_dealloc(alctor, ptrs[i], i == idx ? alloc_size * 2 : alloc_size, 16);
+	}
+	das_dealloc_array(uint8_t*, DasAlctor_system, ptrs, allocs_count);
+
+	das_alloc_reset(alctor);
+	das_assert(la_alctor.pos == 0, "test failed: fallback reset should reset the primary allocator");
+
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+}
+
+DasDeferredAlctor deferred_test_alctor;
+
+TEST_THREAD_FN(deferred_free_test_thread) {
+	DasAlctor alctor = DasDeferredAlctor_as_das(&deferred_test_alctor);
+	for (int i = 0; i < 256; i += 1) {
+		uintptr_t size = 4096 + (i % 8) * 1024;
+		void* ptr = das_alloc(alctor, size, 16);
+		memset(ptr, i, size);
+		das_dealloc(alctor, ptr, size, 16);
+	}
+	TEST_THREAD_FN_RETURN;
+}
+
+void deferred_free_tests() {
+	DasStatsAlctor stats_alctor;
+	DasStatsAlctor_init(&stats_alctor, DasAlctor_system);
+	DasAlctor inner = DasStatsAlctor_as_das(&stats_alctor);
+	DasAllocStats stats;
+
+	//
+	// with no drain threshold, nothing is deallocated until the drain.
+	DasDeferredAlctor_init(&deferred_test_alctor, inner, 1024, 0);
+	DasAlctor alctor = DasDeferredAlctor_as_das(&deferred_test_alctor);
+
+	void* ptrs[100];
+	for (int i = 0; i < 100; i += 1) {
+		ptrs[i] = das_alloc(alctor, i < 80 ? 4096 : 8192, 16);
+	}
+	void* small_ptr = das_alloc(alctor, 64, 16);
+	for (int i = 0; i < 100; i += 1) {
+		das_dealloc(alctor, ptrs[i], i < 80 ? 4096 : 8192, 16);
+	}
+	das_dealloc(alctor, small_ptr, 64, 16);
+
+	DasStatsAlctor_get(&stats_alctor, &stats);
+	das_assert(stats.dealloc_count == 1, "test failed: only the small deallocation should be passed straight on");
+	das_assert(deferred_test_alctor.pending_size == 80 * 4096 + 20 * 8192, "test failed: the deferred deallocations are not pending");
+
+	DasDeferredAlctor_drain(&deferred_test_alctor);
+	DasStatsAlctor_get(&stats_alctor, &stats);
+	das_assert(stats.dealloc_count == 101, "test failed: the drain has not deallocated everything");
+	das_assert(stats.live_bytes == 0, "test failed: the drain has left %zu live bytes", stats.live_bytes);
+	das_assert(deferred_test_alctor.pending_size == 0 && deferred_test_alctor.head == NULL, "test failed: the drain has not emptied the list");
+	DasDeferredAlctor_deinit(&deferred_test_alctor);
+
+	//
+	// many threads deallocating while the background worker drains.
+	DasDeferredAlctor_init(&deferred_test_alctor, inner, 1024, 64 * 1024);
+	TestThread threads[TEST_THREADS_COUNT];
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		threads[i] = test_thread_spawn(deferred_free_test_thread, NULL);
+	}
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		test_thread_join(threads[i]);
+	}
+
+	DasDeferredAlctor_deinit(&deferred_test_alctor);
+	DasStatsAlctor_get(&stats_alctor, &stats);
+	das_assert(stats.live_bytes == 0, "test failed: the deferred allocator has leaked %zu bytes", stats.live_bytes);
+	das_assert(deferred_test_alctor.pending_size == 0, "test failed: the deferred allocator still has pending bytes");
+}
+
+void huge_page_tests() {
+	uintptr_t huge_page_size;
+	DasError error = das_virt_mem_huge_page_size(&huge_page_size);
+	das_assert(error == 0, "failed to get the huge page size: 0x%x", error);
+	das_assert(das_is_power_of_two(huge_page_size), "test failed: the huge page size should be a power of two");
+
+	//
+	// explicit huge pages use the hugetlb page size, that can be different to the transparent huge page size.
+	uintptr_t hugetlb_page_size;
+	error = das_virt_mem_huge_page_size_with_flags(DasVirtMemFlags_huge_pages, &hugetlb_page_size);
+	das_assert(error == 0, "failed to get the huge page size: 0x%x", error);
+	das_assert(das_is_power_of_two(hugetlb_page_size), "test failed: the hugetlb page size should be a power of two");
+	uintptr_t thp_page_size;
+	error = das_virt_mem_huge_page_size_with_flags(DasVirtMemFlags_transparent_huge_pages, &thp_page_size);
+	das_assert(error == 0 && thp_page_size == huge_page_size, "test failed: transparent huge pages should use das_virt_mem_huge_page_size");
+#ifdef __linux__
+	FILE* meminfo = fopen("/proc/meminfo", "r");
+	if (meminfo) {
+		char line[256];
+		while (fgets(line, sizeof(line), meminfo)) {
+			uintptr_t size_kb;
+			if (sscanf(line, "Hugepagesize: %zu kB", &size_kb) == 1) {
+				das_assert(hugetlb_page_size == size_kb * 1024, "test failed: the hugetlb page size should come from /proc/meminfo");
+			}
+		}
+		fclose(meminfo);
+	}
+#endif
+
+	//
+	// transparent huge pages should align the address space and round up the sizes to the huge page size.
+	DasLinearAlctor la_alctor = {0};
+	error = DasLinearAlctor_init_with_flags(&la_alctor, huge_page_size * 3 + 1, 4096, DasVirtMemFlags_transparent_huge_pages);
+	das_assert(error == 0, "failed to initialize the linear allocator with huge pages: 0x%x", error);
+	das_assert((uintptr_t)la_alctor.address_space % huge_page_size == 0, "test failed: huge page address space is not aligned");
+	das_assert(la_alctor.commit_grow_size == huge_page_size, "test failed: commit grow size should be rounded to the huge page size");
+	das_assert(la_alctor.reserved_size == huge_page_size * 4, "test failed: reserved size should be rounded to the huge page size");
+
+	DasAlctor alctor = DasLinearAlctor_as_das(&la_alctor);
+	void* ptr = das_alloc(alctor, huge_page_size + 1, 1);
+	memset(ptr, 0xac, huge_page_size + 1);
+	das_assert(la_alctor.commited_size == huge_page_size * 2, "test failed: should commit a huge page at a time");
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+	//
+	// explicit huge pages need the OS to have some set aside, so this is allowed to fail.
+	error = DasLinearAlctor_init_with_flags(&la_alctor, hugetlb_page_size, hugetlb_page_size, DasVirtMemFlags_huge_pages);
+	if (error == 0) {
+		das_assert(la_alctor.commit_grow_size == hugetlb_page_size, "test failed: commit grow size should be rounded to the hugetlb page size");
+		alctor = DasLinearAlctor_as_das(&la_alctor);
+		ptr = das_alloc(alctor, 64, 1);
+		memset(ptr, 0xac, 64);
+		error = DasLinearAlctor_deinit(&la_alctor);
+		das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+	}
+
+	//
+	// the pool uses the huge page size as it's page size.
+	DasPool(EntityId, Entity) pool;
+	error = DasPool_init_with_flags(EntityId, &pool, 100000, 16, DasVirtMemFlags_transparent_huge_pages);
+	das_assert(error == 0, "failed to initialize the pool with huge pages: 0x%x", error);
+	das_assert((uintptr_t)pool.EntityId_address_space % huge_page_size == 0, "test failed: huge page pool is not aligned");
+	das_assert(pool.page_size == huge_page_size, "test failed: the pool should use the huge page size");
+	das_assert(pool.commit_grow_count == huge_page_size / sizeof(Entity), "test failed: the commit grow count should be rounded to the huge page size");
+	for (uint32_t i = 0; i < 1000; i += 1) {
+		EntityId id;
+		Entity* e = DasPool_alloc(EntityId, &pool, &id);
+		das_assert(e, "test failed: huge page pool allocation should not fail");
+		memset(e, 0xac, sizeof(Entity));
+	}
+	error = DasPool_deinit(EntityId, &pool);
+	das_assert(error == 0, "failed to deinitialize the pool: 0x%x", error);
+}
+
+void slab_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	DasSlabAlctor slab_alctor;
+	error = DasSlabAlctor_init(&slab_alctor, page_size * 64);
+	das_assert(error == 0, "failed to initialize the slab allocator: 0x%x", error);
+	DasAlctor alctor = DasSlabAlctor_as_das(&slab_alctor);
+
+	//
+	// fill up more than a single slab of 16 byte blocks and make sure they are tightly packed.
+	uintptr_t blocks_per_slab = page_size / 16;
+	void* ptrs[1024];
+	das_assert(blocks_per_slab * 2 <= 1024, "page size is too big for this test");
+	for (uintptr_t i = 0; i < blocks_per_slab * 2; i += 1) {
+		ptrs[i] = das_alloc(alctor, 12, 4);
+		das_assert(ptrs[i], "test failed: slab allocation should not fail");
+		das_assert((uintptr_t)ptrs[i] % 16 == 0, "test failed: slab blocks should be aligned to their size class");
+		memset(ptrs[i], 0xac, 12);
+		if (i % blocks_per_slab) {
+			das_assert(ptrs[i] == das_ptr_add(ptrs[i - 1], 16), "test failed: slab blocks should be tightly packed");
+		}
+	}
+	das_assert(slab_alctor.slabs_count == 2, "test failed: expected 2 slabs but got %u", slab_alctor.slabs_count);
+
+	//
+	// a freed block should be the next one to be allocated
+	das_dealloc(alctor, ptrs[5], 12, 4);
+	void* ptr = das_alloc(alctor, 16, 16);
+	das_assert(ptr == ptrs[5], "test failed: slab should reuse the freed block");
+
+	//
+	// freeing every block in the first slab gives it back to the OS.
+	// as long as it is not the only slab of that size class with free blocks.
+	das_dealloc(alctor, ptrs[blocks_per_slab], 12, 4);
+	for (uintptr_t i = 0; i < blocks_per_slab; i += 1) {
+		das_dealloc(alctor, ptrs[i], 12, 4);
+	}
+	das_assert(slab_alctor.free_slab_head_id == 1, "test failed: the empty slab should have been decommitted");
+
+	//
+	// different size classes live in different slabs and realloc moves between them.
+	uint8_t* bytes = das_alloc(alctor, 100, 1);
+	memset(bytes, 0xef, 100);
+	bytes = das_realloc(alctor, bytes, 100, 120, 1);
+	das_assert(bytes[99] == 0xef, "test failed: slab realloc in the same size class has lost the memory");
+	bytes = das_realloc(alctor, bytes, 120, 1000, 1);
+	for (int i = 0; i < 100; i += 1) {
+		das_assert(bytes[i] == 0xef, "test failed: slab realloc has not preserved the memory");
+	}
+
+	ptr = das_alloc(alctor, DasSlabAlctor_max_size + 1, 1);
+	das_assert(ptr == NULL, "test failed: slab allocations over the max size should fail");
+
+	das_alloc_reset(alctor);
+	das_assert(slab_alctor.slabs_count == 0, "test failed: slab reset should forget all of the slabs");
+	error = DasSlabAlctor_deinit(&slab_alctor);
+	das_assert(error == 0, "failed to deinitialize the slab allocator: 0x%x", error);
+}
+
+void tlsf_tests() {
+	DasTlsfAlctor tlsf_alctor;
+	DasError error = DasTlsfAlctor_init(&tlsf_alctor, 16 * 1024 * 1024, 64 * 1024);
+	das_assert(error == 0, "failed to initialize the TLSF allocator: 0x%x", error);
+	DasAlctor alctor = DasTlsfAlctor_as_das(&tlsf_alctor);
+
+	//
+	// randomly allocate and deallocate blocks of different sizes and make sure none of them overlap.
+	typedef struct { uint8_t* ptr; uintptr_t size; } TestBlock;
+	TestBlock blocks[256] = {0};
+	srand(0x7157);
+	for (uint32_t iter = 0; iter < 4096; iter += 1) {
+		TestBlock* b = &blocks[rand() % 256];
+		if (b->ptr) {
+			for (uintptr_t i = 0; i < b->size; i += 1) {
+				das_assert(b->ptr[i] == (uint8_t)(uintptr_t)b, "test failed: TLSF block has been overwritten");
+			}
+			das_dealloc(alctor, b->ptr, b->size, 16);
+			b->ptr = NULL;
+		} else {
+			b->size = 1 + rand() % (rand() % 8 == 0 ? 20000 : 300);
+			b->ptr = das_alloc(alctor, b->size, 16);
+			das_assert(b->ptr, "test failed: TLSF allocation should not fail");
+			das_assert((uintptr_t)b->ptr % 16 == 0, "test failed: TLSF allocations should be aligned to 16 bytes");
+			memset(b->ptr, (uint8_t)(uintptr_t)b, b->size);
+		}
+	}
+	for (uint32_t i = 0; i < 256; i += 1) {
+		if (blocks[i].ptr) das_dealloc(alctor, blocks[i].ptr, blocks[i].size, 16);
+	}
+
+	//
+	// with everything freed, the memory should have merged back into a single free block
+	void* ptr = das_alloc(alctor, 32, 16);
+	das_assert(ptr == das_ptr_add(tlsf_alctor.address_space, 16), "test failed: TLSF free blocks have not been merged");
+	das_dealloc(alctor, ptr, 32, 16);
+
+	//
+	// over aligned allocations
+	for (uintptr_t align = 32; align <= 4096; align *= 2) {
+		ptr = das_alloc(alctor, 100, align);
+		das_assert(ptr && (uintptr_t)ptr % align == 0, "test failed: TLSF allocation is not aligned to %zu", align);
+		memset(ptr, 0xaa, 100);
+		blocks[das_least_set_bit_idx(align)].ptr = ptr;
+	}
+	for (uintptr_t align = 32; align <= 4096; align *= 2) {
+		das_dealloc(alctor, blocks[das_least_set_bit_idx(align)].ptr, 100, align);
+	}
+
+	//
+	// realloc grows in place when the next block is free and when it is at the end of the commited memory.
+	uint8_t* a = das_alloc(alctor, 64, 16);
+	uint8_t* b = das_alloc(alctor, 64, 16);
+	memset(b, 0xbb, 64);
+	das_dealloc(alctor, a, 64, 16);
+	a = das_alloc(alctor, 16, 16);
+	uint8_t* new_a = das_realloc(alctor, a, 16, 64, 16);
+	das_assert(new_a == a, "test failed: TLSF realloc should grow in place into the free next block");
+	uint8_t* new_b = das_realloc(alctor, b, 64, 4 * 1024 * 1024, 16);
+	das_assert(new_b == b, "test failed: TLSF realloc should grow in place at the end of the commited memory");
+	for (int i = 0; i < 64; i += 1) {
+		das_assert(new_b[i] == 0xbb, "test failed: TLSF realloc has not preserved the memory");
+	}
+
+	ptr = das_alloc(alctor, 32 * 1024 * 1024, 16);
+	das_assert(ptr == NULL, "test failed: TLSF allocations bigger than the reserve should fail");
+
+	das_alloc_reset(alctor);
+	das_assert(tlsf_alctor.commited_size == 0, "test failed: TLSF reset should decommit the memory");
+	ptr = das_alloc(alctor, 32, 16);
+	das_assert(ptr == das_ptr_add(tlsf_alctor.address_space, 16), "test failed: TLSF should start again from the beginning after a reset");
+
+	//
+	// growing the last block a little at a time only commits more memory when the free block after it is too small.
+	uintptr_t commited_size = tlsf_alctor.commited_size;
+	for (uintptr_t size = 32; size < 3216; size += 16) {
+		ptr = das_realloc(alctor, ptr, size, size + 16, 16);
+		das_assert(ptr, "test failed: TLSF realloc should not fail");
+	}
+	das_assert(tlsf_alctor.commited_size == commited_size, "test failed: TLSF realloc has commited %zu bytes when it did not need to",
+		tlsf_alctor.commited_size - commited_size);
+
+	error = DasTlsfAlctor_deinit(&tlsf_alctor);
+	das_assert(error == 0, "failed to deinitialize the TLSF allocator: 0x%x", error);
+}
+
+void buddy_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	DasBuddyAlctor buddy_alctor;
+	error = DasBuddyAlctor_init(&buddy_alctor, page_size * 60);
+	das_assert(error == 0, "failed to initialize the buddy allocator: 0x%x", error);
+	das_assert(buddy_alctor.pages_count == 64, "test failed: the buddy allocator should round up to a power of two pages");
+	DasAlctor alctor = DasBuddyAlctor_as_das(&buddy_alctor);
+
+	//
+	// blocks are a power of two pages and are split from the start of the address space
+	uint8_t* a = das_alloc(alctor, page_size * 3, 16);
+	das_assert(a == buddy_alctor.address_space, "test failed: the first buddy block should be at the start");
+	memset(a, 0xaa, page_size * 3);
+	uint8_t* b = das_alloc(alctor, 10, 16);
+	das_assert(b == das_ptr_add(a, page_size * 4), "test failed: a 3 page allocation should take a 4 page block");
+	void* ptr = das_alloc(alctor, 10, page_size * 2);
+	das_assert(ptr == NULL, "test failed: buddy allocations aligned to more than a page should fail");
+
+	//
+	// growing in place by merging with the free buddies after the block
+	uint8_t* new_b = das_realloc(alctor, b, 10, page_size * 4, 16);
+	das_assert(new_b == b, "test failed: buddy realloc should grow in place when the buddy is free");
+	memset(b, 0xbb, page_size * 4);
+
+	//
+	// when the buddy is in use the block has to move
+	uint8_t* new_a = das_realloc(alctor, a, page_size * 3, page_size * 5, 16);
+	das_assert(new_a != a, "test failed: buddy realloc should move when the buddy is allocated");
+	for (uintptr_t i = 0; i < page_size * 3; i += 1) {
+		das_assert(new_a[i] == 0xaa, "test failed: buddy realloc has not preserved the memory");
+	}
+
+	//
+	// shrinking gives the upper halves back, so they can be allocated again
+	new_b = das_realloc(alctor, b, page_size * 4, page_size, 16);
+	das_assert(new_b == b, "test failed: buddy realloc should shrink in place");
+	ptr = das_alloc(alctor, page_size * 2, 16);
+	das_assert(ptr == das_ptr_add(b, page_size * 2), "test failed: buddy realloc shrink should free the upper halves");
+	das_dealloc(alctor, ptr, page_size * 2, 16);
+	das_dealloc(alctor, b, page_size, 16);
+	das_dealloc(alctor, new_a, page_size * 5, 16);
+
+	//
+	// with everything freed, the blocks should have merged back into one.
+	ptr = das_alloc(alctor, page_size * 64, 16);
+	das_assert(ptr == buddy_alctor.address_space, "test failed: buddy blocks have not been merged back together");
+	das_dealloc(alctor, ptr, page_size * 64, 16);
+
+	//
+	// a doubling stack should not have to move
+	DasStk(int) stk = NULL;
+	das_assert(DasStk_init_with_alctor(&stk, 16, alctor), "test failed: failed to initialize the stack");
+	void* stk_start = stk;
+	for (int i = 0; i < 32 * 1024; i += 1) {
+		DasStk_push(&stk, &i);
+	}
+	das_assert((void*)stk == stk_start, "test failed: a doubling stack should grow in place with the buddy allocator");
+	for (int i = 0; i < 32 * 1024; i += 1) {
+		das_assert(DasStk_data(&stk)[i] == i, "test failed: stack has been corrupted");
+	}
+
+	das_alloc_reset(alctor);
+	das_assert(buddy_alctor.free_block_head_ids[buddy_alctor.max_order] == 1, "test failed: buddy reset should leave a single free block");
+	error = DasBuddyAlctor_deinit(&buddy_alctor);
+	das_assert(error == 0, "failed to deinitialize the buddy allocator: 0x%x", error);
+}
+
+TEST_THREAD_FN(tcache_test_thread) {
+	uintptr_t seed = (uintptr_t)arg;
+	DasStk(int) stk = NULL;
+	DasStk_init_with_alctor(&stk, 0, DasAlctor_tcache);
+
+	void* ptrs[64];
+	for (int round = 0; round < 100; round += 1) {
+		for (int i = 0; i < 64; i += 1) {
+			uintptr_t size = ((seed + i * 37 + round) % 2048) + 1;
+			ptrs[i] = das_alloc(DasAlctor_tcache, size, 8);
+			memset(ptrs[i], (int)seed, size);
+		}
+		for (int i = 0; i < 64; i += 1) {
+			uintptr_t size = ((seed + i * 37 + round) % 2048) + 1;
+			das_assert(*(uint8_t*)ptrs[i] == (uint8_t)seed, "test failed: tcache block was shared between threads");
+			das_dealloc(DasAlctor_tcache, ptrs[i], size, 8);
+		}
+
+		int v = round;
+		DasStk_push(&stk, &v);
+	}
+
+	for (int i = 0; i < 100; i += 1) {
+		das_assert(*DasStk_get(&stk, i) == i, "test failed: tcache DasStk lost it's elements");
+	}
+
+	DasStk_deinit(&stk);
+	das_tcache_thread_flush();
+	TEST_THREAD_FN_RETURN;
+}
+
+TEST_THREAD_FN(tcache_test_exit_thread) {
+	void* ptr = das_alloc(DasAlctor_tcache, 3000, 8);
+	das_dealloc(DasAlctor_tcache, ptr, 3000, 8);
+	*(void**)arg = ptr;
+	TEST_THREAD_FN_RETURN;
+}
+
+void tcache_test() {
+	DasAlctor alctor = DasAlctor_tcache;
+
+	for (uintptr_t align = 1; align <= 4096; align *= 2) {
+		void* ptr = das_alloc(alctor, 24, align);
+		das_assert((uintptr_t)ptr % align == 0, "test failed: tcache allocation is not aligned to %zu", align);
+		das_dealloc(alctor, ptr, 24, align);
+	}
+
+	//
+	// the same size class should give us back the block we just freed.
+	void* a = das_alloc(alctor, 100, 8);
+	das_dealloc(alctor, a, 100, 8);
+	void* b = das_alloc(alctor, 120, 8);
+	das_assert(a == b, "test failed: tcache should reuse the most recently freed block of the same size class");
+
+	//
+	// realloc within the size class stays in place, outside of it the data moves.
+	b = das_realloc(alctor, b, 120, 128, 8);
+	das_assert(a == b, "test failed: tcache realloc in the same size class should not move");
+	memset(b, 0xac, 128);
+	b = das_realloc(alctor, b, 128, das_tcache_max_size * 2, 8);
+	for (int i = 0; i < 128; i += 1) {
+		das_assert(((uint8_t*)b)[i] == 0xac, "test failed: tcache realloc has not preserved the memory");
+	}
+	das_dealloc(alctor, b, das_tcache_max_size * 2, 8);
+
+	TestThread threads[TEST_THREADS_COUNT];
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		threads[i] = test_thread_spawn(tcache_test_thread, (void*)(i + 1));
+	}
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		test_thread_join(threads[i]);
+	}
+
+	das_tcache_thread_flush();
+
+	//
+	// a thread that exits without flushing should still give it's blocks back to the central free lists.
+	void* exit_ptr = NULL;
+	test_thread_join(test_thread_spawn(tcache_test_exit_thread, &exit_ptr));
+	_DasTCacheCentralList* central = &_das_tcache_central_lists[_das_tcache_class_idx(_das_tcache_class_size(3000, 8))];
+	DasBool found = das_false;
+	das_spin_lock(&central->lock);
+	for (void* block = central->head; block; block = *(void**)block) {
+		if (block == exit_ptr) { found = das_true; break; }
+	}
+	das_spin_unlock(&central->lock);
+	das_assert(found, "test failed: tcache blocks cached by a thread were not given back when it exited");
+}
+
+DasStk(int) scratch_test_squares(DasAlctor result_alctor, int count) {
+	DasScratch scratch = das_scratch_begin(&result_alctor, 1);
+	das_assert(scratch.alctor.data != result_alctor.data, "test failed: scratch arena aliases a conflict");
+
+	int* tmp = das_alloc(scratch.alctor, sizeof(int) * count, alignof(int));
+	for (int i = 0; i < count; i += 1) {
+		tmp[i] = i * i;
+	}
+
+	DasStk(int) result = NULL;
+	DasStk_init_with_alctor(&result, count, result_alctor);
+	DasStk_push_many(&result, tmp, count);
+
+	das_scratch_end(&scratch);
+	return result;
+}
+
+void scratch_tests() {
+	DasScratch scratch = das_scratch_begin(NULL, 0);
+	DasLinearAlctorMarker marker = scratch.marker;
+	void* ptr = das_alloc(scratch.alctor, 1024, 16);
+	das_assert(ptr, "test failed: scratch allocation failed");
+
+	//
+	// nested scratches without a conflict use the same arena.
+	DasScratch inner_scratch = das_scratch_begin(NULL, 0);
+	das_assert(inner_scratch.arena == scratch.arena, "test failed: nested scratch should reuse the first arena");
+	void* inner_ptr = das_alloc(inner_scratch.alctor, 1024, 16);
+	das_scratch_end(&inner_scratch);
+	void* next_ptr = das_alloc(scratch.alctor, 1024, 16);
+	das_assert(next_ptr == inner_ptr, "test failed: das_scratch_end should free the nested scratch allocations");
+
+	//
+	// the results are put in the outer scratch and survive the inner function's scratch ending.
+	DasStk(int) squares = scratch_test_squares(scratch.alctor, 100);
+	DasScratch other_scratch = das_scratch_begin(NULL, 0);
+	int* clobber = das_alloc(other_scratch.alctor, sizeof(int) * 100, alignof(int));
+	memset(clobber, 0xff, sizeof(int) * 100);
+	for (int i = 0; i < 100; i += 1) {
+		das_assert(*DasStk_get(&squares, i) == i * i, "test failed: scratch conflicts did not protect the results");
+	}
+	das_scratch_end(&other_scratch);
+
+	das_scratch_end(&scratch);
+	das_assert(scratch.arena->pos == marker, "test failed: das_scratch_end should restore the arena");
+	das_scratch_thread_deinit();
+}
+
+void frame_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	DasFrameAlctor frame_alctor;
+	error = DasFrameAlctor_init(&frame_alctor, page_size * 256, page_size);
+	das_assert(error == 0, "failed to initialize the frame allocator: 0x%x", error);
+	DasAlctor alctor = DasFrameAlctor_as_das(&frame_alctor);
+
+	//
+	// the previous frame's allocations stay valid for the whole of the current frame
+	DasFrameAlctor_next_frame(&frame_alctor);
+	int* a = das_alloc(alctor, sizeof(int) * 64, alignof(int));
+	for (int i = 0; i < 64; i += 1) a[i] = i;
+
+	DasFrameAlctor_next_frame(&frame_alctor);
+	int* b = das_alloc(alctor, sizeof(int) * 64, alignof(int));
+	for (int i = 0; i < 64; i += 1) b[i] = -i;
+	for (int i = 0; i < 64; i += 1) {
+		das_assert(a[i] == i, "test failed: the previous frame's allocation has been overwritten");
+	}
+
+	//
+	// an allocation can be carried over to the current frame by reallocating it
+	int* carried = das_realloc(alctor, a, sizeof(int) * 64, sizeof(int) * 128, alignof(int));
+	das_assert(carried != a, "test failed: a realloc of the previous frame's allocation should copy it to the current frame");
+	for (int i = 0; i < 64; i += 1) {
+		das_assert(carried[i] == i, "test failed: the carried over allocation lost it's data");
+	}
+
+	//
+	// the frame before the previous one is reused
+	DasFrameAlctor_next_frame(&frame_alctor);
+	int* c = das_alloc(alctor, sizeof(int) * 64, alignof(int));
+	das_assert(c == a, "test failed: the arena from two frames ago should be reused from the start");
+	for (int i = 0; i < 64; i += 1) {
+		das_assert(b[i] == -i, "test failed: the previous frame's allocation has been overwritten");
+	}
+
+	//
+	// a single big frame keeps it's memory for a few frames
+	// and then the memory that has not been used since is decommitted
+	das_alloc(alctor, page_size * 64, 16);
+	DasLinearAlctor* big_arena = &frame_alctor.arenas[frame_alctor.arena_idx];
+	uintptr_t big_commited_size = big_arena->commited_size;
+	DasFrameAlctor_next_frame(&frame_alctor);
+	DasFrameAlctor_next_frame(&frame_alctor);
+	das_assert(big_arena->commited_size == big_commited_size, "test failed: the frame arena should not decommit straight after the big frame");
+	for (uint32_t i = 0; i < das_frame_alctor_decommit_frames_count * 4; i += 1) {
+		DasFrameAlctor_next_frame(&frame_alctor);
+		das_alloc(alctor, page_size * 2, 16);
+	}
+	das_assert(big_arena->commited_size <= page_size * 2, "test failed: the frame arena should have decommitted the unused memory");
+
+	//
+	// frames that use the same amount of memory keep it committed
+	uintptr_t commited_size = big_arena->commited_size;
+	for (uint32_t i = 0; i < das_frame_alctor_decommit_frames_count * 4; i += 1) {
+		DasFrameAlctor_next_frame(&frame_alctor);
+		das_alloc(alctor, page_size * 2, 16);
+	}
+	das_assert(big_arena->commited_size == commited_size, "test failed: the frame arena should keep the memory that is used every frame");
+
+	error = DasFrameAlctor_deinit(&frame_alctor);
+	das_assert(error == 0, "failed to deinitialize the frame allocator: 0x%x", error);
+}
+
+void ring_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	DasRingAlctor ring_alctor;
+	error = DasRingAlctor_init(&ring_alctor, 64 * 1024, DasAlctor_system);
+	das_assert(error == 0, "failed to initialize the ring allocator: 0x%x", error);
+	DasAlctor alctor = DasRingAlctor_as_das(&ring_alctor);
+	uintptr_t ring_size = ring_alctor.size;
+	void* ring_end = das_ptr_add(ring_alctor.address_space, ring_size);
+
+	//
+	// allocate and deallocate in order for many laps of the ring, with a few in flight at once
+	uintptr_t msg_size = 1000;
+	void* msgs[8];
+	uint32_t msgs_count = 0;
+	uint32_t first_idx = 0;
+	DasBool has_wrapped = das_false;
+	void* prev_ptr = NULL;
+	for (uint32_t i = 0; i < (ring_size / msg_size) * 4; i += 1) {
+		if (msgs_count == 8) {
+			uint8_t* msg = msgs[first_idx % 8];
+			das_assert(msg[0] == (uint8_t)first_idx && msg[msg_size - 1] == (uint8_t)first_idx, "test failed: ring allocation has been overwritten");
+			das_dealloc(alctor, msg, msg_size, 1);
+			first_idx += 1;
+			msgs_count -= 1;
+		}
+
+		uint8_t* msg = das_alloc(alctor, msg_size, 1);
+		das_assert((void*)msg >= ring_alctor.address_space && (void*)msg < ring_end, "test failed: the ring should not be full");
+		das_assert((uintptr_t)msg % 16 == 0, "test failed: ring allocations should be aligned to 16 bytes");
+		if (prev_ptr && (void*)msg < prev_ptr) has_wrapped = das_true;
+		prev_ptr = msg;
+		memset(msg, (uint8_t)i, msg_size);
+		msgs[i % 8] = msg;
+		msgs_count += 1;
+	}
+	das_assert(has_wrapped, "test failed: the ring allocations should have wrapped around");
+	while (msgs_count) {
+		das_dealloc(alctor, msgs[first_idx % 8], msg_size, 1);
+		first_idx += 1;
+		msgs_count -= 1;
+	}
+	das_assert(ring_alctor.head_pos == ring_alctor.tail_pos, "test failed: the ring should be empty");
+
+	//
+	// an allocation that is deallocated out of order holds the tail until the ones before it are deallocated
+	void* a = das_alloc(alctor, 64, 64);
+	das_assert((uintptr_t)a % 64 == 0, "test failed: ring allocation is not aligned");
+	void* b = das_alloc(alctor, 64, 1);
+	void* c = das_alloc(alctor, 64, 1);
+	das_dealloc(alctor, b, 64, 1);
+	uint64_t tail_pos = ring_alctor.tail_pos;
+	das_dealloc(alctor, c, 64, 1);
+	das_assert(ring_alctor.tail_pos == tail_pos, "test failed: the tail should be held by the first allocation");
+
+	//
+	// the allocation at the head can grow in place
+	void* d = das_alloc(alctor, 64, 1);
+	void* new_d = das_realloc(alctor, d, 64, 4096, 1);
+	das_assert(new_d == d, "test failed: the allocation at the head of the ring should grow in place");
+
+	//
+	// when the ring is full, allocations come from the fallback allocator
+	void* big = das_alloc(alctor, ring_size, 1);
+	das_assert(big < ring_alctor.address_space || big >= ring_end, "test failed: an allocation bigger than the ring should use the fallback");
+	big = das_realloc(alctor, big, ring_size, ring_size * 2, 1);
+	das_dealloc(alctor, big, ring_size * 2, 1);
+
+	das_dealloc(alctor, a, 64, 64);
+	das_dealloc(alctor, new_d, 4096, 1);
+	das_assert(ring_alctor.head_pos == ring_alctor.tail_pos, "test failed: the ring should be empty");
+
+	error = DasRingAlctor_deinit(&ring_alctor);
+	das_assert(error == 0, "failed to deinitialize the ring allocator: 0x%x", error);
+}
+
+static DasStatsAlctor stats_test_alctor;
+
+TEST_THREAD_FN(stats_test_thread) {
+	DasAlctor alctor = DasStatsAlctor_as_das(&stats_test_alctor);
+	for (uintptr_t i = 0; i < 1000; i += 1) {
+		void* ptr = das_alloc(alctor, 64, 8);
+		das_dealloc(alctor, ptr, 64, 8);
+	}
+	TEST_THREAD_FN_RETURN;
+}
+
+#define STATS_TEST_CROSS_THREAD_ALLOCS_COUNT 1000
+static void* stats_test_cross_thread_ptrs[STATS_TEST_CROSS_THREAD_ALLOCS_COUNT];
+
+TEST_THREAD_FN(stats_test_cross_thread_dealloc) {
+	DasAlctor alctor = DasStatsAlctor_as_das(&stats_test_alctor);
+	for (uintptr_t i = 0; i < STATS_TEST_CROSS_THREAD_ALLOCS_COUNT; i += 1) {
+		das_dealloc(alctor, stats_test_cross_thread_ptrs[i], 1024, 8);
+	}
+	TEST_THREAD_FN_RETURN;
+}
+
+void stats_tests() {
+	DasStatsAlctor_init(&stats_test_alctor, DasAlctor_system);
+	DasAlctor alctor = DasStatsAlctor_as_das(&stats_test_alctor);
+
+	void* a = das_alloc(alctor, 100, 8);
+	void* b = das_alloc(alctor, 3000, 8);
+	a = das_realloc(alctor, a, 100, 200, 8);
+	das_dealloc(alctor, b, 3000, 8);
+
+	DasAllocStats stats;
+	DasStatsAlctor_get(&stats_test_alctor, &stats);
+	das_assert(stats.alloc_count == 2, "test failed: expected 2 allocs but got %zu", stats.alloc_count);
+	das_assert(stats.realloc_count == 1, "test failed: expected 1 realloc but got %zu", stats.realloc_count);
+	das_assert(stats.dealloc_count == 1, "test failed: expected 1 dealloc but got %zu", stats.dealloc_count);
+	das_assert(stats.alloced_bytes == 3100, "test failed: expected 3100 alloced bytes but got %zu", stats.alloced_bytes);
+	das_assert(stats.live_bytes == 200, "test failed: expected 200 live bytes but got %zu", stats.live_bytes);
+	das_assert(stats.peak_live_bytes == 3200, "test failed: expected 3200 peak live bytes but got %zu", stats.peak_live_bytes);
+	das_assert(stats.size_histogram[6] == 1 && stats.size_histogram[7] == 1 && stats.size_histogram[11] == 1,
+		"test failed: the size histogram has not been bucketed by the power of two");
+	das_dealloc(alctor, a, 200, 8);
+
+	//
+	// a growing stack should show up as reallocs that move the memory.
+	DasStk(int) stk = NULL;
+	DasStk_init_with_alctor(&stk, 0, alctor);
+	for (int i = 0; i < 10000; i += 1) {
+		DasStk_push(&stk, &i);
+	}
+	DasStk_deinit(&stk);
+	DasStatsAlctor_get(&stats_test_alctor, &stats);
+	das_assert(stats.realloc_count > 1, "test failed: the stack should have been reallocated");
+	das_assert(stats.realloc_moved_count <= stats.realloc_count, "test failed: moved more reallocs than there were");
+	das_assert(stats.live_bytes == 0, "test failed: expected no live bytes but got %zu", stats.live_bytes);
+
+	//
+	// the counters of every thread are merged together.
+	DasStatsAlctor_init(&stats_test_alctor, DasAlctor_system);
+	TestThread threads[TEST_THREADS_COUNT];
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		threads[i] = test_thread_spawn(stats_test_thread, NULL);
+	}
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		test_thread_join(threads[i]);
+	}
+	DasStatsAlctor_get(&stats_test_alctor, &stats);
+	das_assert(stats.alloc_count == TEST_THREADS_COUNT * 1000, "test failed: the thread counters were not merged, got %zu", stats.alloc_count);
+	das_assert(stats.dealloc_count == TEST_THREADS_COUNT * 1000, "test failed: the thread counters were not merged, got %zu", stats.dealloc_count);
+	das_assert(stats.live_bytes == 0, "test failed: expected no live bytes but got %zu", stats.live_bytes);
+	das_assert(stats.peak_live_bytes >= 64 && stats.peak_live_bytes <= 64 * TEST_THREADS_COUNT, "test failed: unexpected peak live bytes %zu", stats.peak_live_bytes);
+
+	//
+	// memory that is deallocated on a different thread than it was allocated on, does not raise the peak.
+	DasStatsAlctor_init(&stats_test_alctor, DasAlctor_system);
+	alctor = DasStatsAlctor_as_das(&stats_test_alctor);
+	for (uint32_t round = 0; round < 5; round += 1) {
+		for (uintptr_t i = 0; i < STATS_TEST_CROSS_THREAD_ALLOCS_COUNT; i += 1) {
+			stats_test_cross_thread_ptrs[i] = das_alloc(alctor, 1024, 8);
+		}
+		TestThread thread = test_thread_spawn(stats_test_cross_thread_dealloc, NULL);
+		test_thread_join(thread);
+	}
+	DasStatsAlctor_get(&stats_test_alctor, &stats);
+	das_assert(stats.live_bytes == 0, "test failed: expected no live bytes but got %zu", stats.live_bytes);
+	das_assert(stats.peak_live_bytes == STATS_TEST_CROSS_THREAD_ALLOCS_COUNT * 1024, "test failed: expected a peak of %zu live bytes but got %zu",
+		(uintptr_t)STATS_TEST_CROSS_THREAD_ALLOCS_COUNT * 1024, stats.peak_live_bytes);
+
+	//
+	// every slot is on it's own cache lines, so threads using different slots do not share any.
+	for (uint32_t i = 0; i < DasStatsAlctor_slots_count; i += 1) {
+		das_assert((uintptr_t)&stats_test_alctor.slots[i] % das_cache_line_size == 0, "test failed: the statistics slot %u is not aligned to a cache line", i);
+	}
+	das_assert(sizeof(_DasStatsAlctorSlot) % das_cache_line_size == 0, "test failed: the statistics slots should be a multiple of the cache line size");
+
+	//
+	// the extended operations are passed on to the inner allocator and recorded,
+	// so wrapping an allocator does not change how it is used.
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+	DasLinearAlctor la_alctor;
+	error = DasLinearAlctor_init(&la_alctor, page_size * 16, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor inner = DasLinearAlctor_as_das(&la_alctor);
+	DasStatsAlctor_init(&stats_test_alctor, inner);
+	alctor = DasStatsAlctor_as_das(&stats_test_alctor);
+	void* ptr = das_alloc(alctor, 64, 1);
+	das_assert(das_owns(alctor, ptr), "test failed: the statistics allocator should pass on DasAllocExtOp_owns");
+	das_assert(das_try_expand(alctor, ptr, 64, 128, 1), "test failed: the statistics allocator should pass on DasAllocExtOp_try_expand");
+	DasStatsAlctor_get(&stats_test_alctor, &stats);
+	das_assert(stats.realloc_count == 1 && stats.live_bytes == 128, "test failed: try expand should be recorded as a realloc");
+
+	DasFallbackAlctor fallback_alctor;
+	DasFallbackAlctor_init(&fallback_alctor, alctor, DasAlctor_system);
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+}
+
+DasTraceAlctor trace_test_alctor;
+
+TEST_THREAD_FN(trace_test_thread) {
+	DasAlctor alctor = DasTraceAlctor_as_das(&trace_test_alctor);
+	for (uint32_t i = 0; i < DasTraceAlctor_slot_events_cap * 4; i += 1) {
+		void* ptr = das_alloc(alctor, 24, 8);
+		das_dealloc(alctor, ptr, 24, 8);
+	}
+	TEST_THREAD_FN_RETURN;
+}
+
+void trace_tests() {
+	char* path = "das_test_trace.bin";
+	DasTraceAlctor trace_alctor;
+	DasError error = DasTraceAlctor_init(&trace_alctor, DasAlctor_system, path);
+	das_assert(error == 0, "failed to initialize the trace allocator: 0x%x", error);
+	DasAlctor alctor = DasTraceAlctor_as_das(&trace_alctor);
+
+	//
+	// do enough allocations to make the buffer get written to the file a few times.
+	uint32_t rounds_count = DasTraceAlctor_slot_events_cap;
+	for (uint32_t i = 0; i < rounds_count; i += 1) {
+		void* ptr = das_alloc(alctor, 24, 8);
+		ptr = das_realloc(alctor, ptr, 24, 48, 8);
+		das_dealloc(alctor, ptr, 48, 8);
+	}
+	error = DasTraceAlctor_deinit(&trace_alctor);
+	das_assert(error == 0, "failed to deinitialize the trace allocator: 0x%x", error);
+
+	//
+	// read the trace back and check every event is there in order.
+	DasFileHandle file_handle;
+	error = das_file_open(path, DasFileFlags_read, &file_handle);
+	das_assert(error == 0, "error opening file at %s : 0x%x", path, error);
+	uint64_t file_size;
+	error = das_file_size(file_handle, &file_size);
+	das_assert(error == 0, "failed to get the size of the trace file: 0x%x", error);
+	das_assert(file_size == sizeof(DasTraceHeader) + rounds_count * 3 * sizeof(DasTraceEvent), "test failed: the trace file is the wrong size %zu", (uintptr_t)file_size);
+
+	DasTraceHeader header;
+	uintptr_t bytes_read;
+	error = das_file_read_exact(file_handle, &header, sizeof(header), &bytes_read);
+	das_assert(error == 0, "failed to read the trace header: 0x%x", error);
+	das_assert(memcmp(header.magic, DasTraceHeader_magic, sizeof(header.magic)) == 0, "test failed: the trace header magic is wrong");
+	das_assert(header.version == DasTraceHeader_version && header.event_size == sizeof(DasTraceEvent), "test failed: the trace header is wrong");
+
+	uint64_t prev_timestamp_ns = 0;
+	for (uint32_t i = 0; i < rounds_count; i += 1) {
+		DasTraceEvent events[3];
+		error = das_file_read_exact(file_handle, events, sizeof(events), &bytes_read);
+		das_assert(error == 0, "failed to read the trace events: 0x%x", error);
+		das_assert(events[0].op == DasTraceOp_alloc && events[0].size == 24 && events[0].align_log2 == 3, "test failed: the alloc trace event is wrong");
+		das_assert(events[1].op == DasTraceOp_realloc && events[1].ptr == events[0].new_ptr && events[1].old_size == 24 && events[1].size == 48,
+			"test failed: the realloc trace event is wrong");
+		das_assert(events[2].op == DasTraceOp_dealloc && events[2].ptr == events[1].new_ptr && events[2].old_size == 48, "test failed: the dealloc trace event is wrong");
+		das_assert(events[0].timestamp_ns >= prev_timestamp_ns, "test failed: the trace timestamps should never go backwards");
+		prev_timestamp_ns = events[2].timestamp_ns;
+	}
+
+	das_file_close(file_handle);
+
+	//
+	// many threads sharing the slots, every event should still end up in the file.
+	error = DasTraceAlctor_init(&trace_test_alctor, DasAlctor_system, path);
+	das_assert(error == 0, "failed to initialize the trace allocator: 0x%x", error);
+	TestThread threads[TEST_THREADS_COUNT];
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		threads[i] = test_thread_spawn(trace_test_thread, NULL);
+	}
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		test_thread_join(threads[i]);
+	}
+	error = DasTraceAlctor_deinit(&trace_test_alctor);
+	das_assert(error == 0, "failed to deinitialize the trace allocator: 0x%x", error);
+
+	error = das_file_open(path, DasFileFlags_read, &file_handle);
+	das_assert(error == 0, "error opening file at %s : 0x%x", path, error);
+	error = das_file_size(file_handle, &file_size);
+	das_assert(error == 0, "failed to get the size of the trace file: 0x%x", error);
+	das_assert(file_size == sizeof(DasTraceHeader) + TEST_THREADS_COUNT * DasTraceAlctor_slot_events_cap * 8 * sizeof(DasTraceEvent),
+		"test failed: the threaded trace file is the wrong size %zu", (uintptr_t)file_size);
+	das_file_close(file_handle);
+
+	//
+	// the extended operations are passed on to the inner allocator and written as the DasAllocFn calls they replace.
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+	DasLinearAlctor la_alctor;
+	error = DasLinearAlctor_init(&la_alctor, page_size * 16, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor inner = DasLinearAlctor_as_das(&la_alctor);
+	error = DasTraceAlctor_init(&trace_alctor, inner, path);
+	das_assert(error == 0, "failed to initialize the trace allocator: 0x%x", error);
+	alctor = DasTraceAlctor_as_das(&trace_alctor);
+	void* ptr = das_alloc(alctor, 64, 1);
+	das_assert(das_owns(alctor, ptr), "test failed: the trace allocator should pass on DasAllocExtOp_owns");
+	das_assert(das_try_expand(alctor, ptr, 64, 128, 1), "test failed: the trace allocator should pass on DasAllocExtOp_try_expand");
+	error = DasTraceAlctor_deinit(&trace_alctor);
+	das_assert(error == 0, "failed to deinitialize the trace allocator: 0x%x", error);
+
+	error = das_file_open(path, DasFileFlags_read, &file_handle);
+	das_assert(error == 0, "error opening file at %s : 0x%x", path, error);
+	error = das_file_read_exact(file_handle, &header, sizeof(header), &bytes_read);
+	das_assert(error == 0, "failed to read the trace header: 0x%x", error);
+	DasTraceEvent events[2];
+	error = das_file_read_exact(file_handle, events, sizeof(events), &bytes_read);
+	das_assert(error == 0, "failed to read the trace events: 0x%x", error);
+	das_assert(events[1].op == DasTraceOp_realloc && events[1].ptr == events[0].new_ptr && events[1].new_ptr == events[0].new_ptr && events[1].size == 128,
+		"test failed: try expand should be written as a realloc that does not move");
+	das_file_close(file_handle);
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+	remove(path);
+}
+
+#ifndef _WIN32
+static sigjmp_buf guard_test_fault_jmp;
+static volatile sig_atomic_t guard_test_faults_count;
+
+static void guard_test_fault_handler(int signal) {
+	(void)signal;
+	guard_test_faults_count += 1;
+	siglongjmp(guard_test_fault_jmp, 1);
+}
+#endif
+
+void guard_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	//
+	// like virt_mem_tests, increment this macro to manually test the fault reports.
+#define RUN_FAIL_TEST 0
+
+	//
+	// sample every allocation
+	DasGuardAlctor guard_alctor;
+	error = DasGuardAlctor_init(&guard_alctor, DasAlctor_system, 8, 1);
+	das_assert(error == 0, "failed to initialize the guard allocator: 0x%x", error);
+	DasAlctor alctor = DasGuardAlctor_as_das(&guard_alctor);
+
+	uintptr_t sizes[5] = { 1, 13, 16, 100, 4000 };
+	void* ptrs[5];
+	for (uintptr_t i = 0; i < 5; i += 1) {
+		uintptr_t size = sizes[i];
+		void* ptr = das_alloc(alctor, size, 1);
+		das_assert(ptr >= guard_alctor.address_space && ptr < das_ptr_add(guard_alctor.address_space, guard_alctor.reserved_size), "test failed: allocation of %zu bytes was not guarded", size);
+		das_assert((uintptr_t)ptr % das_guard_alctor_min_align == 0, "test failed: guarded allocation is not aligned");
+
+		void* page_end = das_ptr_round_up_align(das_ptr_add(ptr, 1), page_size);
+		das_assert(das_ptr_diff(page_end, ptr) == das_round_up_nearest_multiple_u(size, das_guard_alctor_min_align), "test failed: guarded allocation is not against the guard page");
+		memset(ptr, 0xac, size);
+		ptrs[i] = ptr;
+	}
+
+#if RUN_FAIL_TEST == 1
+	printf("RUN_FAIL_TEST %u: we should get a heap buffer overflow report here\n", RUN_FAIL_TEST);
+	((char*)ptrs[1])[16] = 1;
+#endif
+
+	//
+	// a realloc of a guarded allocation moves it to another slot, keeping the data
+	void* ptr = das_realloc(alctor, ptrs[3], 100, 200, 1);
+	das_assert(ptr != ptrs[3], "test failed: guarded realloc should move to a new slot");
+	for (uintptr_t i = 0; i < 100; i += 1) {
+		das_assert(((uint8_t*)ptr)[i] == 0xac, "test failed: guarded realloc lost the data");
+	}
+
+#if RUN_FAIL_TEST == 2
+	printf("RUN_FAIL_TEST %u: we should get a use after free report here\n", RUN_FAIL_TEST);
+	((char*)ptrs[3])[0] = 1;
+#endif
+	ptrs[3] = ptr;
+
+	//
+	// larger than a page and over aligned allocations go to the inner allocator
+	void* big_ptr = das_alloc(alctor, page_size * 2, 1);
+	das_assert(big_ptr < guard_alctor.address_space || big_ptr >= das_ptr_add(guard_alctor.address_space, guard_alctor.reserved_size), "test failed: allocation larger than a page should not be guarded");
+	big_ptr = das_realloc(alctor, big_ptr, page_size * 2, page_size * 4, 1);
+	das_dealloc(alctor, big_ptr, page_size * 4, 1);
+
+	void* aligned_ptr = das_alloc(alctor, 64, 64);
+	das_assert(aligned_ptr < guard_alctor.address_space || aligned_ptr >= das_ptr_add(guard_alctor.address_space, guard_alctor.reserved_size), "test failed: over aligned allocation should not be guarded");
+	das_dealloc(alctor, aligned_ptr, 64, 64);
+
+	//
+	// when all the slots are in use, the allocations go to the inner allocator
+	void* extra_ptrs[3];
+	for (uintptr_t i = 0; i < 3; i += 1) {
+		extra_ptrs[i] = das_alloc(alctor, 8, 1);
+	}
+	void* unguarded_ptr = das_alloc(alctor, 8, 1);
+	das_assert(unguarded_ptr < guard_alctor.address_space || unguarded_ptr >= das_ptr_add(guard_alctor.address_space, guard_alctor.reserved_size), "test failed: allocation should not be guarded when all the slots are in use");
+	das_dealloc(alctor, unguarded_ptr, 8, 1);
+	for (uintptr_t i = 0; i < 3; i += 1) {
+		das_dealloc(alctor, extra_ptrs[i], 8, 1);
+	}
+
+	for (uintptr_t i = 0; i < 5; i += 1) {
+		uintptr_t size = i == 3 ? 200 : sizes[i];
+		das_dealloc(alctor, ptrs[i], size, 1);
+	}
+	das_assert(guard_alctor.free_slot_head_id != 0, "test failed: guarded slots were not freed");
+
+	error = DasGuardAlctor_deinit(&guard_alctor);
+	das_assert(error == 0, "failed to deinitialize the guard allocator: 0x%x", error);
+
+	//
+	// only roughly 1 in sample_rate allocations are guarded
+	uint32_t sample_rate = 64;
+	error = DasGuardAlctor_init(&guard_alctor, DasAlctor_system, 256, sample_rate);
+	das_assert(error == 0, "failed to initialize the guard allocator: 0x%x", error);
+	alctor = DasGuardAlctor_as_das(&guard_alctor);
+
+	uint32_t allocs_count = 8192;
+	uint32_t guarded_count = 0;
+	for (uint32_t i = 0; i < allocs_count; i += 1) {
+		void* ptr = das_alloc(alctor, 32, 8);
+		if (ptr >= guard_alctor.address_space && ptr < das_ptr_add(guard_alctor.address_space, guard_alctor.reserved_size)) {
+			guarded_count += 1;
+		}
+		das_dealloc(alctor, ptr, 32, 8);
+	}
+	uint32_t expected_count = allocs_count / sample_rate;
+	das_assert(guarded_count >= expected_count / 2 && guarded_count <= expected_count * 2, "test failed: expected roughly %u guarded allocations but got %u", expected_count, guarded_count);
+
+	error = DasGuardAlctor_deinit(&guard_alctor);
+	das_assert(error == 0, "failed to deinitialize the guard allocator: 0x%x", error);
+
+	//
+	// owns checks the slots and the inner allocator, the other extended operations are passed on
+	// to the inner allocator for the allocations that are not guarded.
+	DasLinearAlctor la_alctor;
+	error = DasLinearAlctor_init(&la_alctor, page_size * 16, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor inner = DasLinearAlctor_as_das(&la_alctor);
+	error = DasGuardAlctor_init(&guard_alctor, inner, 8, 1);
+	das_assert(error == 0, "failed to initialize the guard allocator: 0x%x", error);
+	alctor = DasGuardAlctor_as_das(&guard_alctor);
+	void* guarded_ptr = das_alloc(alctor, 64, 8);
+	void* inner_ptr = das_alloc(alctor, page_size * 2, 8);
+	das_assert(das_owns(alctor, guarded_ptr) && das_owns(alctor, inner_ptr), "test failed: the guard allocator should own the slots and the inner allocations");
+	das_assert(!das_try_expand(alctor, guarded_ptr, 64, 128, 8), "test failed: a guarded allocation should not expand in place");
+	das_assert(das_try_expand(alctor, inner_ptr, page_size * 2, page_size * 3, 8), "test failed: the guard allocator should pass on DasAllocExtOp_try_expand");
+	das_dealloc(alctor, guarded_ptr, 64, 8);
+	error = DasGuardAlctor_deinit(&guard_alctor);
+	das_assert(error == 0, "failed to deinitialize the guard allocator: 0x%x", error);
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+#ifndef _WIN32
+	//
+	// faults outside of the guard allocators are passed on to the handler that was installed before,
+	// without uninstalling ours. the handler before is put back when the last guard allocator is deinitialized.
+	struct sigaction test_action = {0};
+	struct sigaction prev_action;
+	test_action.sa_handler = guard_test_fault_handler;
+	sigemptyset(&test_action.sa_mask);
+	sigaction(SIGSEGV, &test_action, &prev_action);
+
+	error = DasGuardAlctor_init(&guard_alctor, DasAlctor_system, 8, 1);
+	das_assert(error == 0, "failed to initialize the guard allocator: 0x%x", error);
+
+	void* reserved_page;
+	error = das_virt_mem_reserve(NULL, reserve_align, &reserved_page);
+	das_assert(error == 0, "failed to reserve virtual memory: 0x%x", error);
+	for (uint32_t i = 0; i < 2; i += 1) {
+		if (sigsetjmp(guard_test_fault_jmp, 1) == 0) {
+			*(volatile uint8_t*)reserved_page = 0xac;
+		}
+		struct sigaction action;
+		sigaction(SIGSEGV, NULL, &action);
+		das_assert(action.sa_sigaction == _das_guard_signal_handler, "test failed: a fault outside of the guard allocator should not uninstall the fault handler");
+	}
+	das_assert(guard_test_faults_count == 2, "test failed: faults outside of the guard allocator should be passed on to the previous handler");
+
+	error = das_virt_mem_release(reserved_page, reserve_align);
+	das_assert(error == 0, "failed to release virtual memory: 0x%x", error);
+	error = DasGuardAlctor_deinit(&guard_alctor);
+	das_assert(error == 0, "failed to deinitialize the guard allocator: 0x%x", error);
+
+	struct sigaction action;
+	sigaction(SIGSEGV, NULL, &action);
+	das_assert(action.sa_handler == guard_test_fault_handler, "test failed: deinitializing the last guard allocator should put back the previous handler");
+	sigaction(SIGSEGV, &prev_action, NULL);
+#endif
+
+#undef RUN_FAIL_TEST
+}
+
+void block_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	DasBlockAlctor block_alctor;
+	error = DasBlockAlctor_init(&block_alctor, 40, 16, 300, 64);
+	das_assert(error == 0, "failed to initialize the block allocator: 0x%x", error);
+	das_assert(block_alctor.block_size == 48, "test failed: the block size should be rounded up to the alignment");
+	DasAlctor alctor = DasBlockAlctor_as_das(&block_alctor);
+
+	//
+	// new blocks are tightly packed and zeroed
+	void* ptrs[2048];
+	for (uintptr_t i = 0; i < 128; i += 1) {
+		uint8_t* ptr = das_alloc(alctor, 40, 16);
+		das_assert(ptr && (uintptr_t)ptr % 16 == 0, "test failed: block allocation is not aligned");
+		das_assert(i == 0 || (void*)ptr == das_ptr_add(ptrs[i - 1], 48), "test failed: new blocks should be tightly packed");
+		for (uintptr_t j = 0; j < 48; j += 1) {
+			das_assert(ptr[j] == 0, "test failed: new blocks should be zeroed");
+		}
+		memset(ptr, 0xac, 48);
+		ptrs[i] = ptr;
+	}
+
+	//
+	// the last freed block is the next one to be allocated
+	das_dealloc(alctor, ptrs[5], 40, 16);
+	das_dealloc(alctor, ptrs[9], 40, 16);
+	void* ptr = das_alloc(alctor, 40, 16);
+	das_assert(ptr == ptrs[9], "test failed: block allocation should reuse the last freed block");
+	ptr = das_alloc(alctor, 40, 16);
+	das_assert(ptr == ptrs[5], "test failed: block allocation should reuse the freed blocks");
+	ptr = das_alloc(alctor, 64, 16);
+	das_assert(ptr == NULL, "test failed: block allocation larger than the block should fail");
+	ptr = das_alloc(alctor, 8, 64);
+	das_assert(ptr == NULL, "test failed: block allocation with a larger alignment should fail");
+	ptr = das_realloc(alctor, ptrs[0], 40, 48, 16);
+	das_assert(ptr == ptrs[0], "test failed: block reallocation within the block should not move");
+	das_assert(das_usable_size(alctor, ptrs[0], 1, 16) == 48, "test failed: block usable size should be the block size");
+	das_dealloc_batch(alctor, ptrs, 40, 16, 128);
+
+	//
+	// batches come from the free list first and then from the new blocks
+	das_assert(das_alloc_batch(alctor, 40, 16, ptrs, 256), "test failed: block batch allocation failed");
+	for (uintptr_t i = 0; i < 256; i += 1) {
+		for (uintptr_t j = 0; j < i; j += 1) {
+			das_assert(ptrs[i] != ptrs[j], "test failed: block batch allocation gave the same block twice");
+		}
+	}
+
+	//
+	// allocations fail when the reserved blocks have been exhausted
+	uintptr_t blocks_cap = block_alctor.reserved_size / block_alctor.block_size;
+	das_assert(blocks_cap < 2048, "reserve alignment is too big for this test");
+	das_dealloc_batch(alctor, ptrs, 40, 16, 256);
+	das_assert(!das_alloc_batch(alctor, 40, 16, ptrs, blocks_cap + 1), "test failed: block batch allocation past the reserved size should fail");
+	uintptr_t allocs_count = 0;
+	while (1) {
+		ptr = das_alloc(alctor, 40, 16);
+		if (!ptr) break;
+		allocs_count += 1;
+	}
+	das_assert(allocs_count == blocks_cap, "test failed: expected %zu blocks but got %zu", blocks_cap, allocs_count);
+
+	das_alloc_reset(alctor);
+	das_assert(block_alctor.pos == 0 && block_alctor.commited_size == 0, "test failed: block allocator reset should decommit the blocks");
+
+	error = DasBlockAlctor_deinit(&block_alctor);
+	das_assert(error == 0, "failed to deinitialize the block allocator: 0x%x", error);
+
+	//
+	// blocks aligned to more than the reserve alignment are still aligned.
+	uintptr_t big_align = reserve_align * 4;
+	error = DasBlockAlctor_init(&block_alctor, big_align, big_align, 8, 1);
+	das_assert(error == 0, "failed to initialize the block allocator: 0x%x", error);
+	alctor = DasBlockAlctor_as_das(&block_alctor);
+	for (uint32_t i = 0; i < 8; i += 1) {
+		uint8_t* ptr = das_alloc(alctor, big_align, big_align);
+		das_assert(ptr && (uintptr_t)ptr % big_align == 0, "test failed: block is not aligned to %zu", big_align);
+		memset(ptr, 0xac, big_align);
+	}
+	error = DasBlockAlctor_deinit(&block_alctor);
+	das_assert(error == 0, "failed to deinitialize the block allocator: 0x%x", error);
+}
+
+static DasLinearAlctor linear_concurrent_test_alctor;
+#define LINEAR_CONCURRENT_TEST_ALLOCS_COUNT 2048
+
+TEST_THREAD_FN(linear_concurrent_test_thread) {
+	uint8_t id = (uint8_t)(uintptr_t)arg;
+	DasAlctor alctor = DasLinearAlctor_concurrent_as_das(&linear_concurrent_test_alctor);
+
+	static uint8_t* ptrs[TEST_THREADS_COUNT][LINEAR_CONCURRENT_TEST_ALLOCS_COUNT];
+	for (uintptr_t i = 0; i < LINEAR_CONCURRENT_TEST_ALLOCS_COUNT; i += 1) {
+		uintptr_t size = ((i * 37 + id) % 512) + 1;
+		uint8_t* ptr = das_alloc(alctor, size, 8);
+		das_assert(ptr && (uintptr_t)ptr % 8 == 0, "test failed: concurrent linear allocation failed or is not aligned");
+		memset(ptr, id, size);
+		ptrs[id - 1][i] = ptr;
+	}
+
+	for (uintptr_t i = 0; i < LINEAR_CONCURRENT_TEST_ALLOCS_COUNT; i += 1) {
+		uintptr_t size = ((i * 37 + id) % 512) + 1;
+		for (uintptr_t j = 0; j < size; j += 1) {
+			das_assert(ptrs[id - 1][i][j] == id, "test failed: concurrent linear allocations overlap between threads");
+		}
+	}
+
+	TEST_THREAD_FN_RETURN;
+}
+
+void linear_concurrent_test() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	//
+	// commit a single page at a time so the threads are fighting to commit memory too.
+	error = DasLinearAlctor_init(&linear_concurrent_test_alctor, 64 * 1024 * 1024, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+
+	TestThread threads[TEST_THREADS_COUNT];
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		threads[i] = test_thread_spawn(linear_concurrent_test_thread, (void*)(i + 1));
+	}
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		test_thread_join(threads[i]);
+	}
+
+	das_assert(linear_concurrent_test_alctor.pos <= linear_concurrent_test_alctor.commited_size, "test failed: concurrent linear allocator position is past the commited memory");
+
+	//
+	// the last allocation can still be extended in place
+	DasAlctor alctor = DasLinearAlctor_concurrent_as_das(&linear_concurrent_test_alctor);
+	void* ptr = das_alloc(alctor, 16, 16);
+	void* new_ptr = das_realloc(alctor, ptr, 16, page_size * 4, 16);
+	das_assert(ptr == new_ptr, "test failed: concurrent linear realloc should extend the last allocation in place");
+
+	error = DasLinearAlctor_deinit(&linear_concurrent_test_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+}
+
+void linear_shrink_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	DasLinearAlctor linear_alctor;
+	error = DasLinearAlctor_init(&linear_alctor, page_size * 256, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasAlctor alctor = DasLinearAlctor_as_das(&linear_alctor);
+
+	//
+	// shrinking only decommits the whole pages past the position and the keep size.
+	uint8_t* ptr = das_alloc(alctor, page_size * 16, 16);
+	memset(ptr, 0xac, page_size * 16);
+	DasLinearAlctor_restore(&linear_alctor, page_size * 4 + 1);
+	error = DasLinearAlctor_shrink(&linear_alctor, page_size * 2);
+	das_assert(error == 0, "failed to shrink the linear allocator: 0x%x", error);
+	das_assert(linear_alctor.commited_size == page_size * 5, "test failed: shrink should keep the pages up to the position");
+	error = DasLinearAlctor_shrink(&linear_alctor, page_size * 8);
+	das_assert(error == 0, "failed to shrink the linear allocator: 0x%x", error);
+	das_assert(linear_alctor.commited_size == page_size * 5, "test failed: shrink should never commit more memory");
+	das_assert(ptr[page_size * 4] == 0xac, "test failed: shrink should not touch the memory below the position");
+
+	//
+	// the memory past the shrink is zeroed when it is committed again.
+	ptr = das_alloc(alctor, page_size * 8, 1);
+	for (uintptr_t i = page_size; i < page_size * 8; i += 1) {
+		das_assert(ptr[i] == 0, "test failed: memory committed again after a shrink should be zeroed");
+	}
+
+	//
+	// without a retention policy, reset decommits everything.
+	das_alloc_reset(alctor);
+	das_assert(linear_alctor.commited_size == 0 && linear_alctor.pos == 0, "test failed: reset should decommit everything");
+
+	//
+	// with a retention policy, a steady peak stays committed across resets.
+	// the peak is remembered even if the position was restored before the reset.
+	DasLinearAlctor_retention_set(&linear_alctor, 1);
+	for (uint32_t i = 0; i < 16; i += 1) {
+		das_alloc(alctor, page_size * 32, 1);
+		DasLinearAlctor_restore(&linear_alctor, 0);
+		das_alloc_reset(alctor);
+	}
+	das_assert(linear_alctor.commited_size == page_size * 32, "test failed: reset should retain the steady peak usage");
+
+	//
+	// after the usage drops, the retained memory decays away.
+	uintptr_t prev_commited_size = linear_alctor.commited_size;
+	for (uint32_t i = 0; i < 4; i += 1) {
+		das_alloc(alctor, page_size, 1);
+		das_alloc_reset(alctor);
+		das_assert(linear_alctor.commited_size < prev_commited_size, "test failed: retained memory should decay when the usage drops");
+		prev_commited_size = linear_alctor.commited_size;
+	}
+
+	DasLinearAlctor_retention_set(&linear_alctor, 0);
+	das_alloc_reset(alctor);
+	das_assert(linear_alctor.commited_size == 0, "test failed: reset should decommit everything after retention is disabled");
+
+	error = DasLinearAlctor_deinit(&linear_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+}
+
+TEST_THREAD_FN(commit_ahead_test_thread) {
+	uint8_t id = (uint8_t)(uintptr_t)arg;
+	DasAlctor alctor = DasLinearAlctor_concurrent_as_das(&linear_concurrent_test_alctor);
+	for (uintptr_t i = 0; i < LINEAR_CONCURRENT_TEST_ALLOCS_COUNT; i += 1) {
+		uint8_t* ptr = das_alloc(alctor, 256, 8);
+		das_assert(ptr, "test failed: concurrent linear allocation with commit ahead failed");
+		memset(ptr, id, 256);
+	}
+
+	TEST_THREAD_FN_RETURN;
+}
+
+void commit_ahead_test_block_worker(void* data, uintptr_t arg) {
+	(void)arg;
+	das_atomic_store_u((uintptr_t*)data, 1);
+	while (das_atomic_load_u((uintptr_t*)data) == 1) {
+		das_cpu_relax();
+	}
+}
+
+void commit_ahead_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	DasLinearAlctor linear_alctor;
+	error = DasLinearAlctor_init(&linear_alctor, page_size * 64, page_size * 4);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasLinearAlctor_commit_ahead_set(&linear_alctor, DasCommitAhead_prefault);
+	DasAlctor alctor = DasLinearAlctor_as_das(&linear_alctor);
+
+	//
+	// getting within half a chunk of the commited memory, starts committing the next chunk on the background worker.
+	uint8_t* ptr = das_alloc(alctor, page_size, 1);
+	das_assert(linear_alctor.commit_ahead_state == 0, "test failed: the next chunk should not be committed ahead yet");
+	ptr = das_alloc(alctor, page_size * 2, 1);
+	das_assert(das_atomic_load_u(&linear_alctor.commit_ahead_state) != 0, "test failed: the next chunk should be committed ahead");
+	while (das_atomic_load_u(&linear_alctor.commit_ahead_state) != 2) {
+		das_cpu_relax();
+	}
+	das_assert(linear_alctor.commited_size == page_size * 4, "test failed: the chunk committed ahead should not be used until it is needed");
+
+	//
+	// the next chunk is taken from the background worker and the memory is still zeroed.
+	ptr = das_alloc(alctor, page_size * 4, 1);
+	das_assert(ptr && linear_alctor.commited_size == page_size * 8, "test failed: the chunk committed ahead should be used");
+	for (uintptr_t i = 0; i < page_size * 4; i += 1) {
+		das_assert(ptr[i] == 0, "test failed: memory committed ahead should be zeroed");
+	}
+
+	//
+	// the allocator can be used up to the reserved size while the background worker is committing ahead.
+	while (1) {
+		ptr = das_alloc(alctor, page_size / 2, 1);
+		if (!ptr) break;
+	}
+	das_assert(linear_alctor.commited_size == linear_alctor.reserved_size, "test failed: all the memory should be committed");
+
+	//
+	// reset waits for the background worker, so the locked pages can be decommitted.
+	DasLinearAlctor_commit_ahead_set(&linear_alctor, DasCommitAhead_prefault_and_lock);
+	das_alloc_reset(alctor);
+	for (uint32_t i = 0; i < 4; i += 1) {
+		ptr = das_alloc(alctor, page_size * 3, 1);
+		das_assert(ptr, "test failed: linear allocation with locked commit ahead failed");
+		memset(ptr, 0xac, page_size * 3);
+	}
+	das_alloc_reset(alctor);
+	das_assert(linear_alctor.commited_size == 0 && linear_alctor.commit_ahead_state == 0, "test failed: reset should decommit the memory committed ahead");
+
+	//
+	// when the background worker is busy with another job, the allocating thread cancels the queued job
+	// and commits the next chunk itself, instead of waiting behind it.
+	DasLinearAlctor_commit_ahead_set(&linear_alctor, DasCommitAhead_prefault);
+	uintptr_t block_worker = 0;
+	das_assert(_das_worker_post(commit_ahead_test_block_worker, &block_worker, 0), "test failed: could not post a job to the background worker");
+	while (das_atomic_load_u(&block_worker) != 1) {
+		das_cpu_relax();
+	}
+	ptr = das_alloc(alctor, page_size * 3, 1);
+	das_assert(ptr && das_atomic_load_u(&linear_alctor.commit_ahead_state) == 1, "test failed: the next chunk should be queued to be committed ahead");
+	ptr = das_alloc(alctor, page_size * 2, 1);
+	das_assert(ptr && linear_alctor.commited_size == page_size * 8, "test failed: the next chunk should be committed by the allocating thread");
+	das_assert(das_atomic_load_u(&block_worker) == 1, "test failed: the background worker should still be busy");
+	memset(ptr, 0xac, page_size * 2);
+	das_atomic_store_u(&block_worker, 2);
+
+	error = DasLinearAlctor_deinit(&linear_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+	//
+	// many threads allocating while the background worker commits ahead.
+	error = DasLinearAlctor_init(&linear_concurrent_test_alctor, 64 * 1024 * 1024, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	DasLinearAlctor_commit_ahead_set(&linear_concurrent_test_alctor, DasCommitAhead_prefault);
+
+	TestThread threads[TEST_THREADS_COUNT];
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		threads[i] = test_thread_spawn(commit_ahead_test_thread, (void*)(i + 1));
+	}
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		test_thread_join(threads[i]);
+	}
+	das_assert(linear_concurrent_test_alctor.pos == TEST_THREADS_COUNT * LINEAR_CONCURRENT_TEST_ALLOCS_COUNT * 256, "test failed: concurrent linear allocations with commit ahead are missing");
+
+	error = DasLinearAlctor_deinit(&linear_concurrent_test_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+	//
+	// the pool commits the next chunk of elements ahead too.
+	DasPool(EntityId, Entity) pool;
+	error = DasPool_init(EntityId, &pool, 10000, 64);
+	das_assert(error == 0, "failed to initialize the pool: 0x%x", error);
+	DasPool_commit_ahead_set(EntityId, &pool, DasCommitAhead_prefault_and_lock);
+	for (uint32_t i = 0; i < 10000; i += 1) {
+		EntityId id;
+		Entity* e = DasPool_alloc(EntityId, &pool, &id);
+		das_assert(e, "test failed: pool allocation with commit ahead failed");
+		memset(e, 0xac, sizeof(Entity));
+	}
+	error = DasPool_reset(EntityId, &pool);
+	das_assert(error == 0, "failed to reset the pool: 0x%x", error);
+	error = DasPool_deinit(EntityId, &pool);
+	das_assert(error == 0, "failed to deinitialize the pool: 0x%x", error);
+}
+
+static DasNumaArenas numa_test_arenas;
+
+TEST_THREAD_FN(numa_test_thread) {
+	uint8_t id = (uint8_t)(uintptr_t)arg;
+	DasLinearAlctor* arena = DasNumaArenas_get(&numa_test_arenas);
+	das_assert(arena >= numa_test_arenas.arenas && arena < &numa_test_arenas.arenas[numa_test_arenas.arenas_count], "test failed: the NUMA arena is out of bounds");
+
+	DasAlctor alctor = DasNumaArenas_as_das(&numa_test_arenas);
+	for (uintptr_t i = 0; i < 256; i += 1) {
+		uint8_t* ptr = das_alloc(alctor, 64, 8);
+		das_assert(ptr, "test failed: NUMA arena allocation failed");
+		memset(ptr, id, 64);
+	}
+
+	TEST_THREAD_FN_RETURN;
+}
+
+void numa_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	uint32_t nodes_count = das_numa_nodes_count();
+	das_assert(nodes_count >= 1, "test failed: there should always be at least one NUMA node");
+	das_assert(das_numa_node() < nodes_count, "test failed: the NUMA node of the thread is out of bounds");
+
+	//
+	// reserving on a node that does not exist falls back to letting the OS choose.
+	uint32_t numa_nodes[] = { das_numa_node_any, 0, nodes_count - 1, nodes_count };
+	for (uint32_t i = 0; i < 4; i += 1) {
+		void* addr;
+		error = das_virt_mem_reserve_on_numa_node(NULL, reserve_align * 4, DasVirtMemFlags_none, numa_nodes[i], &addr);
+		das_assert(error == 0, "failed to reserve memory on NUMA node %u: 0x%x", numa_nodes[i], error);
+		error = das_virt_mem_commit(addr, page_size, DasVirtMemProtection_read_write);
+		das_assert(error == 0, "failed to commit memory on NUMA node %u: 0x%x", numa_nodes[i], error);
+		memset(addr, 0xac, page_size);
+		error = das_virt_mem_release(addr, reserve_align * 4);
+		das_assert(error == 0, "failed to release memory on NUMA node %u: 0x%x", numa_nodes[i], error);
+	}
+
+	DasPool(EntityId, Entity) pool;
+	error = DasPool_init_on_numa_node(EntityId, &pool, 1000, 16, DasVirtMemFlags_none, das_numa_node());
+	das_assert(error == 0, "failed to initialize the pool on a NUMA node: 0x%x", error);
+	for (uint32_t i = 0; i < 100; i += 1) {
+		EntityId id;
+		Entity* e = DasPool_alloc(EntityId, &pool, &id);
+		das_assert(e, "test failed: NUMA node pool allocation should not fail");
+	}
+	error = DasPool_deinit(EntityId, &pool);
+	das_assert(error == 0, "failed to deinitialize the pool: 0x%x", error);
+
+	//
+	// every thread allocates out of the arena for the node it is running on.
+	error = DasNumaArenas_init(&numa_test_arenas, 16 * 1024 * 1024, page_size, DasVirtMemFlags_none);
+	das_assert(error == 0, "failed to initialize the NUMA arenas: 0x%x", error);
+	das_assert(numa_test_arenas.arenas_count == das_min_u(nodes_count, das_numa_nodes_max), "test failed: there should be an arena for each NUMA node");
+
+	TestThread threads[TEST_THREADS_COUNT];
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		threads[i] = test_thread_spawn(numa_test_thread, (void*)(i + 1));
+	}
+	for (uintptr_t i = 0; i < TEST_THREADS_COUNT; i += 1) {
+		test_thread_join(threads[i]);
+	}
+
+	uintptr_t allocated_size = 0;
+	for (uint32_t i = 0; i < numa_test_arenas.arenas_count; i += 1) {
+		allocated_size += numa_test_arenas.arenas[i].pos;
+	}
+	das_assert(allocated_size == TEST_THREADS_COUNT * 256 * 64, "test failed: the NUMA arenas allocated %zu bytes", allocated_size);
+
+	error = DasNumaArenas_deinit(&numa_test_arenas);
+	das_assert(error == 0, "failed to deinitialize the NUMA arenas: 0x%x", error);
+}
+
+#ifdef __linux__
+//
+// returns das_true if all of the pages from @param(addr) to @param(addr) + @param(size) have no access in /proc/self/maps.
+static DasBool virt_mem_is_no_access(void* addr, uintptr_t size) {
+	FILE* f = fopen("/proc/self/maps", "r");
+	das_assert(f, "failed to open /proc/self/maps");
+
+	uintptr_t pos = (uintptr_t)addr;
+	uintptr_t end = pos + size;
+	char line[512];
+	while (pos < end && fgets(line, sizeof(line), f)) {
+		uintptr_t start, stop;
+		char perms[8];
+		if (sscanf(line, "%zx-%zx %7s", &start, &stop, perms) != 3) continue;
+		if (pos < start || pos >= stop) continue;
+		if (perms[0] != '-' || perms[1] != '-' || perms[2] != '-') break;
+		pos = stop;
+	}
+	fclose(f);
+	return pos >= end;
+}
+#endif
+
+void virt_mem_cache_tests() {
+	uintptr_t reserve_align;
+	uintptr_t page_size;
+	DasError error = das_virt_mem_page_size(&page_size, &reserve_align);
+	das_assert(error == 0, "failed to get the page size: 0x%x", error);
+
+	//
+	// the cache is off by default, so a released range is given back to the OS.
+	void* addr;
+	error = das_virt_mem_reserve(NULL, reserve_align, &addr);
+	das_assert(error == 0, "failed to reserve memory: 0x%x", error);
+	error = das_virt_mem_release(addr, reserve_align);
+	das_assert(error == 0, "failed to release memory: 0x%x", error);
+	das_assert(das_virt_mem_cache_size() == 0, "test failed: the reservation cache should be off by default");
+
+	error = das_virt_mem_cache_set_budget(1024 * 1024 * 1024);
+	das_assert(error == 0, "failed to set the reservation cache budget: 0x%x", error);
+
+	//
+	// a released range is handed out again for the same size, decommitted and zeroed.
+	uintptr_t size = reserve_align * 3;
+	error = das_virt_mem_reserve(NULL, size, &addr);
+	das_assert(error == 0, "failed to reserve memory: 0x%x", error);
+	error = das_virt_mem_commit(addr, page_size * 2, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "failed to commit memory: 0x%x", error);
+	memset(addr, 0xac, page_size * 2);
+	error = das_virt_mem_release(addr, size);
+	das_assert(error == 0, "failed to release memory: 0x%x", error);
+
+	void* cached_addr;
+	error = das_virt_mem_reserve(NULL, size, &cached_addr);
+	das_assert(error == 0, "failed to reserve memory: 0x%x", error);
+#ifdef __linux__
+	das_assert(cached_addr == addr, "test failed: the released range should have come from the reservation cache");
+#endif
+	das_assert(das_virt_mem_cache_size() == 0, "test failed: the reservation cache should be empty once the range is taken");
+#ifdef __linux__
+	das_assert(virt_mem_is_no_access(cached_addr, size), "test failed: a range from the reservation cache should have no access");
+#endif
+	error = das_virt_mem_commit(cached_addr, page_size * 2, DasVirtMemProtection_read_write);
+	das_assert(error == 0, "failed to commit memory: 0x%x", error);
+	for (uintptr_t i = 0; i < page_size * 2; i += 1) {
+		das_assert(((uint8_t*)cached_addr)[i] == 0, "test failed: memory from the reservation cache should be zeroed");
+	}
+	error = das_virt_mem_release(cached_addr, size);
+	das_assert(error == 0, "failed to release memory: 0x%x", error);
+#ifdef __linux__
+	das_assert(das_virt_mem_cache_size() == size, "test failed: the released range should be in the reservation cache");
+#endif
+
+	//
+	// ranges reserved with flags are never cached and a different size does not take from the cache.
+	error = das_virt_mem_reserve_with_flags(NULL, size, DasVirtMemFlags_transparent_huge_pages, &addr);
+	das_assert(error == 0, "failed to reserve memory with flags: 0x%x", error);
+	das_assert(addr != cached_addr, "test failed: reservations with flags should not come from the reservation cache");
+	error = das_virt_mem_release(addr, size);
+	das_assert(error == 0, "failed to release memory: 0x%x", error);
+
+	error = das_virt_mem_reserve(NULL, reserve_align, &addr);
+	das_assert(error == 0, "failed to reserve memory: 0x%x", error);
+	das_assert(addr != cached_addr, "test failed: the reservation cache should only hand out ranges of the same size");
+	error = das_virt_mem_release(addr, reserve_align);
+	das_assert(error == 0, "failed to release memory: 0x%x", error);
+#ifdef __linux__
+	das_assert(das_virt_mem_cache_size() == size + reserve_align, "test failed: only the ranges without flags should be in the reservation cache");
+#endif
+
+	//
+	// having lots of reservations with flags alive at once does not stop the cache from taking in other ranges.
+	void* flags_addrs[200];
+	for (uint32_t i = 0; i < 200; i += 1) {
+		error = das_virt_mem_reserve_with_flags(NULL, reserve_align, DasVirtMemFlags_transparent_huge_pages, &flags_addrs[i]);
+		das_assert(error == 0, "failed to reserve memory with flags: 0x%x", error);
+	}
+	for (uint32_t i = 0; i < 200; i += 1) {
+		error = das_virt_mem_release(flags_addrs[i], reserve_align);
+		das_assert(error == 0, "failed to release memory: 0x%x", error);
+	}
+	error = das_virt_mem_reserve(NULL, reserve_align * 2, &addr);
+	das_assert(error == 0, "failed to reserve memory: 0x%x", error);
+	error = das_virt_mem_release(addr, reserve_align * 2);
+	das_assert(error == 0, "failed to release memory: 0x%x", error);
+#ifdef __linux__
+	das_assert(das_virt_mem_cache_size() == size + reserve_align * 3, "test failed: the reservation cache should still work after many reservations with flags");
+#endif
+
+	//
+	// allocators that are created and destroyed over and over reuse the same address space.
+	DasLinearAlctor la_alctor;
+	error = DasLinearAlctor_init(&la_alctor, reserve_align * 16, page_size);
+	das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+	void* address_space = la_alctor.address_space;
+	for (uint32_t i = 0; i < 8; i += 1) {
+		DasAlctor alctor = DasLinearAlctor_as_das(&la_alctor);
+		uint8_t* ptr = das_alloc(alctor, page_size, 1);
+		das_assert(ptr[0] == 0, "test failed: linear allocator memory from the reservation cache should be zeroed");
+		memset(ptr, 0xac, page_size);
+		error = DasLinearAlctor_deinit(&la_alctor);
+		das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+		error = DasLinearAlctor_init(&la_alctor, reserve_align * 16, page_size);
+		das_assert(error == 0, "failed to initialize the linear allocator: 0x%x", error);
+#ifdef __linux__
+		das_assert(la_alctor.address_space == address_space, "test failed: the linear allocator should reuse the cached address space");
+#endif
+	}
+	error = DasLinearAlctor_deinit(&la_alctor);
+	das_assert(error == 0, "failed to deinitialize the linear allocator: 0x%x", error);
+
+	//
+	// turning the cache off gives the cached ranges back to the OS.
+#ifdef __linux__
+	das_assert(das_virt_mem_cache_size() != 0, "test failed: the linear allocator's address space should be in the reservation cache");
+#endif
+	error = das_virt_mem_cache_set_budget(0);
+	das_assert(error == 0, "failed to set the reservation cache budget: 0x%x", error);
+	das_assert(das_virt_mem_cache_size() == 0, "test failed: the reservation cache should be empty when it is turned off");
+}
+
 int main(int argc, char** argv) {
 	alloc_test();
+	tcache_test();
+	system_large_alloc_test();
+	try_expand_test();
+	usable_size_test();
+	batch_alloc_test();
+	zeroed_alloc_test();
+	combinator_alloc_tests();
+	deferred_free_tests();
 	stk_test();
 	deque_test();
 	virt_mem_tests();
 	pool_tests();
+	huge_page_tests();
+	slab_tests();
+	tlsf_tests();
+	buddy_tests();
+	block_tests();
+	linear_concurrent_test();
+	linear_shrink_tests();
+	commit_ahead_tests();
+	numa_tests();
+	virt_mem_cache_tests();
+	scratch_tests();
+	frame_tests();
+	ring_tests();
+	stats_tests();
+	trace_tests();
+	guard_tests();
 
 	printf("all tests were successful\n");
 	return 0;
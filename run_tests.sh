@@ -5,7 +5,7 @@ if test -f "das_test"; then
 fi
 
 echo "running das_test on gcc..."
-gcc -Wpedantic -Werror -g -o das_test das_test.c
+gcc -Wpedantic -Werror -g -o das_test das_test.c -pthread
 
 if test -f "das_test"; then
 	./das_test
@@ -14,7 +14,7 @@ fi
 if test -f "das_test"; then
 	rm das_test
 	echo "running das_test on clang..."
-	clang -Wpedantic -Werror -g -o das_test das_test.c
+	clang -Wpedantic -Werror -g -o das_test das_test.c -pthread
 fi
 
 if test -f "das_test"; then